@@ -47,7 +47,7 @@ else :
 config = pdict(
 	disk_date_precision = 0.010          # in seconds, precisions of dates on disk, must account for date granularity and date discrepancy between executing hosts and disk servers
 ,	heartbeat           = 10             # in seconds, minimum interval between 2 heartbeat checks (and before first one) for the same job (no heartbeat if None)
-,	heartbeat_tick      =  0.1           # in seconds, minimum internval between 2 heartbeat checks (globally)                             (no heartbeat if None)
+,	heartbeat_tick      =  0.1           # in seconds, minimum interval between 2 rounds of heartbeat checks (globally)                    (no heartbeat if None)
 ,	link_support        = 'Full'         # symlinks are supported. Other values are 'None' (no symlink support) or 'File' (symlink to file only support)
 #,	local_admin_dir     = 'LMAKE_LOCAL'  # directory in which to store data that are private to the server (not accessed by remote executing hosts) (default is within LMAKE dir)
 ,	max_dep_depth       = 1000           # used to detect infinite recursions and loops
@@ -63,6 +63,7 @@ config = pdict(
 #,	rules_module        = 'rules'        # module to import to define rules  . By default, rules are directly defined in Lmakefile.py
 #,	sources_module      = 'sources'      # module to import to define sources. By default, 'lmake.auto_sources' which lists files in Manifest or searches git (recursively) if lmake.sources is not set
 ,	sub_prio_boost      = 1              # increment to add to rules defined in sub-repository (multiplied by directory depth of sub-repository) to boost local rules
+#,	watch_sources       = False          # if true, sources are watched with inotify so as to avoid probing them if untouched when server is kept alive between commands
 ,	console = pdict(                     # tailor output lines
 		date_precision = None            # number of second decimals in the timestamp field
 	,	host_length    = None            # length of the host field (lines will be misaligned if a host is longer)
@@ -85,6 +86,8 @@ config = pdict(
 			cpu = _cpu                   # total number of cpus available for the process, and hence for all jobs launched locally
 		,	mem = str(_mem>>20)+'M'      # total available memory in MBytes
 		,	tmp = 0                      # total available temporary disk space in MBytes
+		#,	n_workers = 0                # number of pre-forked job_exec workers that run jobs without paying process start-up, 0 means no worker
+		#,	backfill  = False            # if True, lower pressure jobs are launched only if they are expected to end before a higher pressure job that does not fit can start
 		)
 	)
 ,	caches = pdict(                      # PER_CACHE : provide an explanation for each cache method
@@ -94,6 +97,13 @@ config = pdict(
 	#	,	dir    = '/cache_dir'        # the directory in which cached results are stored
 	#	,	size   = 10<<30              # the overall size of this cache
 	#	,	group  = _group              # the group used to write to the cache. If user does not belong to this group, read-only access is still possible
+	#	,	compress = 'zlib'            # optional, 'zlib' or 'zstd' (if available) to store data compressed, default is 'none'
+	#	,	blob_key = 'xxh128'          # optional, 'xxh128' to name shared contents after a 128 bits digest rather than after the 64 bits crc, default is 'crc'
+	#	)
+	#,	shared = pdict(                  # when rule specifies cache = 'shared' , this cache is selected
+	#		tag    = 'daemon'            # cache dir is accessed through lcache_server, which must run on a host reachable from this one
+	#	,	repo   = root_dir            # same as for dir caches
+	#	,	dir    = '/cache_dir'        # the dir served by lcache_server, used to find the server, alternately provide service='host:port'
 	#	)
 	)
 ,	colors = pdict(
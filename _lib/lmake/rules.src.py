@@ -90,12 +90,13 @@ class Rule(_RuleBase) :
 #	prio             = 0                                     # in case of ambiguity, rules are selected with highest prio first
 	python           = (python,)                             # python used for callable cmd
 	shell            = (shell ,)                             # shell  used for str      cmd (_sh is usually /bin/sh which may test for dir existence before chdir, which defeats auto_mkdir)
+#	shm_report       = False                                 # if set, accesses are reported to job_exec through a shared memory ring rather than a message per access
 	start_delay      = 3                                     # delay before sending a start message if job is not done by then, 3 is a reasonable compromise
 	max_stderr_len   = 100                                   # maximum number of stderr lines shown in output (full content is accessible with lshow -e), 100 is a reasonable compromise
 #	timeout          = None                                  # timeout allocated to job execution (in s), must be None or an int
 #	tmp              = '/tmp'                                # path under which the temporary directory (automatically generated) is seen in the job
 #	use_script       = False                                 # use a script to run job rather than calling interpreter with -c
-	if has_ld_audit : autodep = 'ld_audit'                   # may be set anywhere in the inheritance hierarchy if autodep uses an alternate method : none, ptrace, ld_audit, ld_preload
+	if has_ld_audit : autodep = 'ld_audit'                   # may be set anywhere in the inheritance hierarchy if autodep uses an alternate method : none, ptrace, seccomp_notif, ld_audit, ld_preload
 	else            : autodep = 'ld_preload'                 # .
 	resources = {                                            # used in conjunction with backend to inform it of the necessary resources to execute the job, same syntax as deps
 		'cpu' : 1                                            # number of cpu's to allocate to job
@@ -67,6 +67,7 @@ StdAttrs = {
 ,	'python'            : ( tuple , False )
 ,	'resources'         : ( dict  , True  )
 ,	'shell'             : ( tuple , False )
+,	'shm_report'        : ( bool  , True  )
 ,	'start_delay'       : ( float , True  )
 ,	'side_targets'      : ( dict  , True  )
 ,	'timeout'           : ( float , True  )
@@ -440,6 +441,7 @@ class Handle :
 		self._handle_val('auto_mkdir'                       )
 		self._handle_val('env'        ,rep_key='environ_cmd')
 		self._handle_val('ignore_stat'                      )
+		self._handle_val('shm_report'                       )
 		self._handle_val('chroot'                           )
 		self._handle_val('interpreter',rep_key=interpreter  )
 		self._handle_val('tmp'                              )
@@ -307,6 +307,7 @@ PyMODINIT_FUNC
 	mod->set_attr( "has_ld_preload"          ,                True                                 ) ;
 	mod->set_attr( "has_ld_preload_jemalloc" ,                True                                 ) ;
 	mod->set_attr( "has_ptrace"              ,                True                                 ) ;
+	mod->set_attr( "has_seccomp_notif"       , *Ptr<Bool>(bool(HAS_SECCOMP_NOTIF))                 ) ;
 	mod->set_attr( "no_crc"                  , *Ptr<Int>(+Crc::Unknown)                            ) ;
 	mod->set_attr( "crc_a_link"              , *Ptr<Int>(+Crc::Lnk    )                            ) ;
 	mod->set_attr( "crc_a_reg"               , *Ptr<Int>(+Crc::Reg    )                            ) ;
@@ -14,6 +14,7 @@ using namespace Disk ;
 		/**/                 os <<','<< ade.service                          ;
 		if (ade.auto_mkdir ) os <<",auto_mkdir"                              ;
 		if (ade.ignore_stat) os <<",ignore_stat"                             ;
+		if (ade.shm_report ) os <<",shm_report"                              ;
 		if (ade.disabled   ) os <<",disabled"                                ;
 	}
 	return os <<')' ;
@@ -41,6 +42,7 @@ AutodepEnv::AutodepEnv( ::string const& env ) {
 			case 'f' : lnk_support   = LnkSupport::File ; break ;
 			case 'a' : lnk_support   = LnkSupport::Full ; break ;
 			case 'r' : reliable_dirs = true             ; break ;
+			case 's' : shm_report    = true             ; break ;
 			default  : goto Fail ;
 		}
 	//source dirs
@@ -74,6 +76,7 @@ AutodepEnv::operator ::string() const {
 	if (ignore_stat  ) res += 'i' ;
 	if (auto_mkdir   ) res += 'm' ;
 	if (reliable_dirs) res += 'r' ;
+	if (shm_report   ) res += 's' ;
 	switch (lnk_support) {
 		case LnkSupport::None : res += 'n' ; break ;
 		case LnkSupport::File : res += 'f' ; break ;
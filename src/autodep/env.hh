@@ -25,11 +25,13 @@ struct AutodepEnv : Disk::RealPathEnv {
 		::serdes(s,disabled                        ) ;
 		::serdes(s,ignore_stat                     ) ;
 		::serdes(s,service                         ) ;
+		::serdes(s,shm_report                      ) ;
 	}
 	// data
 	bool     active      = true  ;
 	bool     auto_mkdir  = false ; // if true <=> auto mkdir in case of chdir
 	bool     disabled    = false ; // if true <=> no automatic report
 	bool     ignore_stat = false ; // if true <=> stat-like syscalls do not trigger dependencies
+	bool     shm_report  = false ; // if true <=> asynchronous reports go through a shared memory ring rather than through service
 	::string service     ;
 } ;
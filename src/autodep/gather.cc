@@ -7,6 +7,7 @@
 #include "thread.hh"
 
 #include "ptrace.hh"
+#include "seccomp_notif.hh"
 
 #include "gather.hh"
 
@@ -83,6 +84,7 @@ void Gather::_new_access( Fd fd , PD pd , ::string&& file , AccessDigest ad , DI
 	info->update( pd , ad , di , _parallel_id ) ;
 	//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 	if ( is_new || *info!=old_info ) Trace("_new_access", fd , STR(is_new) , pd , ad , di , _parallel_id , comment , old_info , "->" , *info , it->first ) ; // only trace if something changes
+	if ( written_cb && ad.write==Yes ) written_cb(it->first) ;                                                                                              // give a chance to compute crc early
 }
 
 void Gather::new_deps( PD pd , ::vmap_s<DepDigest>&& deps , ::string const& stdin ) {
@@ -211,9 +213,9 @@ void Gather::_send_to_server ( Fd fd , Jerr&& jerr ) {
 		JobMngtRpcReq jmrr ;
 		if (jerr.proc==JobExecProc::ChkDeps) jmrr = { JobMngtProc::ChkDeps , seq_id , job , fd , cur_deps_cb() } ;
 		else                                 jmrr = {                        seq_id , job , fd , ::move(jerr)  } ;
-		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-		OMsgBuf().send( ClientSockFd(service_mngt) , jmrr ) ;
-		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+		_send_to_server( JobMuxRpcReq(::move(jmrr)) ) ;
+		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 	} catch (...) {
 		trace("no_server") ;
 		JobExecRpcReply sync_reply ;
@@ -224,20 +226,27 @@ void Gather::_send_to_server ( Fd fd , Jerr&& jerr ) {
 	}
 }
 
+void Gather::_send_to_server(JobMuxRpcReq const& jmrr) {
+	if (+server_fd) OMsgBuf().send( server_fd                           , jmrr ) ;
+	else            OMsgBuf().send( ClientSockFd(service,3/*n_trials*/) , jmrr ) ; // server asked us not to keep a connection
+}
+
 void Gather::_spawn_child( Child& child , ::vector_s const& args , Fd cstdin , Fd cstdout , Fd cstderr ) {
 	Trace trace("_spawn_child",args,cstdin,cstdout,cstderr) ;
 	//
 	::map_ss add_env { {"LMAKE_AUTODEP_ENV",autodep_env} } ;               // required even with method==None or ptrace to allow support (ldepend, lmake module, ...) to work
-	if (method==AutodepMethod::Ptrace) {                                   // PER_AUTODEP_METHOD : handle case
+	if ( method==AutodepMethod::Ptrace || method==AutodepMethod::SeccompNotif ) { // PER_AUTODEP_METHOD : handle case
 		// we split the responsability into 2 processes :
 		// - parent watches for data (stdin, stdout, stderr & incoming connections to report deps)
-		// - child launches target process using ptrace and watches it using direct wait (without signalfd) then report deps using normal socket report
+		// - child launches target process using ptrace (resp. seccomp user notifications) and watches it using direct wait (resp. listener fd) then report deps using normal socket report
 		bool in_parent = child.spawn( as_session , {} , cstdin , cstdout , cstderr ) ;
 		if (in_parent) {
-			start_time = New ;                                             // record job start time as late as possible
+			start_time = New ;                                                    // record job start time as late as possible
 		} else {
+			bool  ptrace = method==AutodepMethod::Ptrace ;
 			Child grand_child ;
-			AutodepPtrace::s_autodep_env = new AutodepEnv{autodep_env} ;
+			if (ptrace) AutodepPtrace::s_autodep_env = new AutodepEnv{autodep_env} ;
+			else        AutodepSeccompNotif::s_init(autodep_env)                   ;
 			try {
 				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 				grand_child.spawn(
@@ -246,19 +255,20 @@ void Gather::_spawn_child( Child& child , ::vector_s const& args , Fd cstdin , F
 				,	env , &add_env
 				,	chroot
 				,	cwd
-				,	AutodepPtrace::s_prepare_child
+				,	ptrace ? AutodepPtrace::s_prepare_child : AutodepSeccompNotif::s_prepare_child
 				) ;
 				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 			} catch(::string const& e) {
 				exit(Rc::System,e) ;
 			}
 			trace("grand_child_pid",grand_child.pid) ;
-			AutodepPtrace autodep_ptrace { grand_child.pid }        ;
-			int           wstatus        = autodep_ptrace.process() ;
-			grand_child.waited() ;                                         // grand_child has already been waited
+			int wstatus ;
+			if (ptrace) wstatus = AutodepPtrace      (grand_child.pid).process() ;
+			else        wstatus = AutodepSeccompNotif(grand_child.pid).process() ;
+			grand_child.waited() ;                                                // grand_child has already been waited
 			if      (WIFEXITED  (wstatus)) ::_exit(WEXITSTATUS(wstatus)) ;
 			else if (WIFSIGNALED(wstatus)) ::_exit(+Rc::System         ) ;
-			fail_prod("ptraced child did not exit and was not signaled : wstatus : ",wstatus) ;
+			fail_prod("watched child did not exit and was not signaled : wstatus : ",wstatus) ;
 		}
 	} else {
 		if (method>=AutodepMethod::Ld) {                                                                                                                  // PER_AUTODEP_METHOD : handle case
@@ -306,6 +316,7 @@ Status Gather::exec_child( ::vector_s const& args , Fd cstdin , Fd cstdout , Fd
 	Pdate                                 event_date         ;
 	size_t                                live_out_pos       = 0           ;
 	::umap<Fd,pair<IMsgBuf,vector<Jerr>>> slaves             ;                             // Jerr's are waiting for confirmation
+	::umap<Fd,ShmRing>                    rings              ;                             // shared memory rings through which slaves send asynchronous reports
 	//
 	auto set_status = [&]( Status status_ , ::string const& msg_={} )->void {
 		if ( status==Status::New || status==Status::Ok ) status = status_ ;                // else there is already another reason
@@ -320,6 +331,47 @@ Status Gather::exec_child( ::vector_s const& args , Fd cstdin , Fd cstdout , Fd
 			if (+server_master_fd) epoll.cnt-- ;                                           // idem for connections from server
 		}
 	} ;
+	// handle reports that need no reply, which may come from socket or from ring
+	auto new_async = [&]( Fd fd , ::vector<Jerr>& deferred , Jerr&& jerr )->void {
+		if ( jerr.proc>=Proc::HasFiles && jerr.solve ) _solve(fd,jerr) ;
+		switch (jerr.proc) {
+			case Proc::Confirm : {                                                                                     // only confirm accesses of the reporting thread as threads of a process report concurrently
+				size_t i = 0 ;
+				for( Jerr& j : deferred )
+					if (j.id==jerr.id) { j.digest.write = jerr.digest.write ; _new_accesses(fd,::move(j)) ; }
+					else               { if (&deferred[i]!=&j) deferred[i] = ::move(j) ; i++ ;                 }
+				deferred.resize(i) ;
+			} break ;
+			case Proc::Access :
+				// for read accesses, trying is enough to trigger a dep, so confirm is useless
+				if ( jerr.digest.write==Maybe ) deferred.push_back(::move(jerr)) ;                                     // defer until confirm resolution
+				else                            _new_accesses(fd,::move(jerr))   ;
+			break ;
+			case Proc::Tmp   : seen_tmp = true ;                                               break           ;
+			case Proc::Guard : _new_guards(fd,::move(jerr)) ;                                  break           ;
+			case Proc::Panic : set_status(Status::Err,jerr.txt) ; kill_step = KillStep::Kill ; [[fallthrough]] ;
+			case Proc::Trace : trace(jerr.txt) ;                                               break           ;
+		DF}
+	} ;
+	// reports in rings were sent before any message received afterwards, so rings must be drained before any message is handled
+	auto drain_rings = [&]()->void {
+		for( auto it=rings.begin() ; it!=rings.end() ; ) {
+			Fd              fd       = it->first                ;
+			ShmRing&        ring     = it->second               ;
+			::vector<Jerr>& deferred = slaves.at(fd).second     ;
+			Jerr            jerr     ;
+			try {
+				while (ring.pop(jerr)) new_async(fd,deferred,::move(jerr)) ;
+				ring.wait() ;                                                                                          // ask for a doorbell, then ...
+				while (ring.pop(jerr)) new_async(fd,deferred,::move(jerr)) ;                                          // ... catch reports pushed before job could see we wait
+				it++ ;
+			} catch (::string const& e) {
+				trace("bad_ring",fd,e) ;
+				set_status(Status::Err,e) ; kill_step = KillStep::Kill ;
+				it = rings.erase(it) ;
+			}
+		}
+	} ;
 	//
 	if (+timeout) {
 		event_date = Pdate(New) + timeout ;
@@ -360,6 +412,7 @@ Status Gather::exec_child( ::vector_s const& args , Fd cstdin , Fd cstdout , Fd
 		if (!events) {
 			if (+delayed_check_deps) {      // process delayed check deps after all other events
 				trace("delayed_chk_deps") ;
+				drain_rings() ;
 				for( auto& [fd,jerr] : delayed_check_deps ) _send_to_server(fd,::move(jerr)) ;
 				delayed_check_deps.clear() ;
 				continue ;
@@ -403,9 +456,9 @@ Status Gather::exec_child( ::vector_s const& args , Fd cstdin , Fd cstdout , Fd
 									pos++ ;
 									size_t len = old_sz + pos - live_out_pos ;
 									trace("live_out",live_out_pos,len) ;
-									//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-									OMsgBuf().send( ClientSockFd(service_mngt) , JobMngtRpcReq( JobMngtProc::LiveOut , seq_id , job , stdout.substr(live_out_pos,len) ) ) ;
-									//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+									//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+									_send_to_server( JobMuxRpcReq(JobMngtRpcReq( JobMngtProc::LiveOut , seq_id , job , stdout.substr(live_out_pos,len) )) ) ;
+									//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 									live_out_pos = old_sz+pos ;
 								}
 							}
@@ -473,33 +526,30 @@ Status Gather::exec_child( ::vector_s const& args , Fd cstdin , Fd cstdout , Fd
 					catch (...) { trace("no_jerr",jerr) ; jerr.proc = Proc::None ;         }                                      // fd was closed, ensure no partially received jerr
 					Proc proc  = jerr.proc ;                                                                                      // capture essential info so as to be able to move jerr
 					bool sync_ = jerr.sync ;                                                                                      // .
-					if ( proc!=Proc::Access                 ) trace(kind,fd,epoll.cnt,proc) ;                                     // there may be too many Access'es, only trace within _new_accesses
-					if ( proc>=Proc::HasFiles && jerr.solve ) _solve(fd,jerr)               ;
+					if ( proc!=Proc::Access ) trace(kind,fd,epoll.cnt,proc) ;                                                     // there may be too many Access'es, only trace within _new_accesses
+					drain_rings() ;
 					switch (proc) {
-						case Proc::Confirm :
-							for( Jerr& j : slave_entry.second ) { j.digest.write = jerr.digest.write ; _new_accesses(fd,::move(j)) ; }
-							slave_entry.second.clear() ;
-						break ;
 						case Proc::None :
 							epoll.close(fd) ;
 							trace("close",kind,fd) ;
 							for( Jerr& j : slave_entry.second ) _new_accesses(fd,::move(j)) ;                                     // process deferred entries although with uncertain outcome
+							rings .erase(fd) ;
 							slaves.erase(it) ;
 						break ;
-						case Proc::Access   :
-							// for read accesses, trying is enough to trigger a dep, so confirm is useless
-							if ( jerr.digest.write==Maybe ) slave_entry.second.push_back(::move(jerr)) ;                          // defer until confirm resolution
-							else                            _new_accesses(fd,::move(jerr))             ;
-						break ;
-						case Proc::Tmp        : seen_tmp = true ;                                               break           ;
-						case Proc::Guard      : _new_guards(fd,::move(jerr)) ;                                  break           ;
+						case Proc::Ring : {
+							SWEAR(sync_) ;
+							ShmRing ring { jerr.txt } ;
+							trace("ring",fd,jerr.txt,STR(+ring)) ;
+							if (+ring) { ring.wait() ; rings[fd] = ::move(ring) ; sync( fd , JobExecRpcReply(proc,Yes) ) ; }      // ring is empty as job waits for our reply
+							else       {                                          sync( fd , JobExecRpcReply(proc,No ) ) ; }
+						} goto NoReply ;
+						case Proc::Doorbell   :                                                                                   break        ; // rings have just been drained
 						case Proc::DepVerbose :
 						case Proc::Decode     :
-						case Proc::Encode     : _send_to_server(fd,::move(jerr)) ;                              goto NoReply    ;
-						case Proc::ChkDeps    : delayed_check_deps[fd] = ::move(jerr) ;                         goto NoReply    ; // if sync, reply is delayed as well
-						case Proc::Panic      : set_status(Status::Err,jerr.txt) ; kill_step = KillStep::Kill ; [[fallthrough]] ;
-						case Proc::Trace      : trace(jerr.txt) ;                                               break           ;
-					DF}
+						case Proc::Encode     : if (jerr.solve) _solve(fd,jerr) ; _send_to_server(fd,::move(jerr)) ;             goto NoReply ;
+						case Proc::ChkDeps    : delayed_check_deps[fd] = ::move(jerr) ;                                           goto NoReply ; // if sync, reply is delayed as well
+						default               : new_async(fd,slave_entry.second,::move(jerr)) ;
+					}
 					if (sync_) sync( fd , JobExecRpcReply(proc) ) ;
 				NoReply : ;
 				} break ;
@@ -510,6 +560,7 @@ Return :
 	child.waited() ;
 	trace("done",status) ;
 	SWEAR(status!=Status::New) ;
+	drain_rings() ;
 	reorder(true/*at_end*/) ;                                                                                                     // ensure server sees a coherent view
 	return status ;
 }
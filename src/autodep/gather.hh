@@ -16,6 +16,7 @@
 #include "trace.hh"
 
 #include "env.hh"
+#include "shm_ring.hh"
 
 // When several sockets are opened to send depend & target data, we are not sure of the order between these reports because of system buffers.
 // We could have decided to synchronize each report, which may be expensive in performance.
@@ -93,6 +94,7 @@ private :
 	}
 	void _kill          ( KillStep , Child const& ) ;
 	void _send_to_server( Fd fd , Jerr&& jerr     ) ;
+	void _send_to_server( JobMuxRpcReq const&     ) ;
 public : //!                                                                                                           crc_file_info parallel
 	void new_target( PD pd , ::string const& t , ::string const& c="s_target" ) { _new_access(pd,::copy(t),{.write=Yes},{}          ,false  ,c) ; }
 	void new_unlnk ( PD pd , ::string const& t , ::string const& c="s_unlnk"  ) { _new_access(pd,::copy(t),{.write=Yes},{}          ,false  ,c) ; } // new_unlnk is used for internal wash
@@ -132,12 +134,14 @@ public :
 	pid_t                             pid              = -1                  ; // pid to kill
 	bool                              seen_tmp         = false               ;
 	SeqId                             seq_id           = 0                   ;
+	Fd                                server_fd        ;                       // connection to server on which mngt requests are sent, if none, connect to service for each request
 	ServerSockFd                      server_master_fd ;
-	::string                          service_mngt     ;
+	::string                          service          ;                       // server service to connect to if no server_fd
 	Time::Pdate                       start_time       ;
 	::string                          stdout           ;                       // contains child stdout if child_stdout==Pipe
 	::string                          stderr           ;                       // contains child stderr if child_stderr==Pipe
 	Time::Delay                       timeout          ;
+	::function<void(::string const&)> written_cb       ;                       // called each time a file is written
 	int                               wstatus          = 0                   ;
 private :
 	::umap<Fd,::string> _codec_files   ;
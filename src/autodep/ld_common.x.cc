@@ -57,8 +57,21 @@ extern "C" {
 	extern int  statx      ( int dirfd , const char* pth , int flgs , uint msk , struct statx* buf            ) noexcept ;
 }
 
-static              Mutex<MutexLvl::Autodep2> _g_mutex ;         // ensure exclusivity between threads
-static thread_local bool                      _t_loop  = false ; // prevent recursion within a thread
+static              SharedMutex<MutexLvl::Autodep2> _g_mutex ;         // protect cwd : shared for regular calls, exclusive for calls that may change it
+static thread_local bool                            _t_loop  = false ; // prevent recursion within a thread
+
+// exclusive lock on _g_mutex that may be held across fork
+// in child, lock cannot be released as glibc identifies the writer by its tid, which changes across fork, but as child has a single thread, lock can simply be reset
+struct ExclusiveLock {
+	ExclusiveLock (decltype(_g_mutex)& m) : _pid{::getpid()} { m.lock(_lvl) ; }
+	~ExclusiveLock(                     ) {
+		if (::getpid()==_pid) {                         _g_mutex.unlock(_lvl) ;                                 }
+		else                  { t_mutex_lvl = _lvl ; new(&_g_mutex) ::remove_reference_t<decltype(_g_mutex)> ; }
+	}
+	// data
+	pid_t    _pid ;
+	MutexLvl _lvl = MutexLvl::None/*garbage*/ ;
+} ;
 
 // User program may have global variables whose cxtor/dxtor do accesses.
 // In that case, they may come before our own Audit is constructed if declared global (in the case of LD_PRELOAD).
@@ -260,21 +273,23 @@ struct Mkstemp : WSolve {
 	#define EXE(  mode ) bool((mode )&S_IXUSR            )
 
 	// cwd is implicitly accessed by mostly all syscalls, so we have to ensure mutual exclusion as cwd could change between actual access and path resolution in audit
-	// hence we should use a shared lock when reading and an exclusive lock when chdir
-	// however, we have to ensure exclusivity for lnk cache, so we end up to exclusive access anyway, so simpler to lock exclusively here
+	// hence we use a shared lock when reading and an exclusive lock when chdir : chdir waits for in-flight calls resolved against the old cwd
+	// Record internal state (report connection, access cache, ...) has its own short lived lock, so regular calls from several threads proceed concurrently
 	// no malloc must be performed before cond is checked to allow jemalloc accesses to be filtered, hence auditer() (which allocates a Record) is done after
 	// use short macros as lines are very long in defining audited calls to libc
 	// protect against recusive calls
 	// args must be in () e.g. HEADER1(unlink,path,(path))
 	#define ORIG(syscall) \
 		static auto orig = reinterpret_cast<decltype(::syscall)*>(get_orig(#syscall)) ;
-	#define HEADER(syscall,cond,args) \
+	#define HEADER_LOCK(syscall,cond,args,L) \
 		ORIG(syscall) ;                                 \
 		if ( _t_loop || !started() ) return orig args ; \
 		Save sav{_t_loop,true} ;                        \
 		if (cond) return orig args ;                    \
-		Lock lock{_g_mutex}
+		L lock{_g_mutex}
+	#define HEADER(syscall,cond,args) HEADER_LOCK( syscall , cond , args , SharedLock )
 	// do a first check to see if it is obvious that nothing needs to be done
+	#define HEADERX(syscall,            args) HEADER_LOCK( syscall , false , args , ExclusiveLock ) /* for calls that may change cwd or that fork */
 	#define HEADER0(syscall,            args) HEADER( syscall , false                                                    , args )
 	#define HEADER1(syscall,path,       args) HEADER( syscall , Record::s_is_simple(path )                               , args )
 	#define HEADER2(syscall,path1,path2,args) HEADER( syscall , Record::s_is_simple(path1) && Record::s_is_simple(path2) , args )
@@ -296,8 +311,8 @@ struct Mkstemp : WSolve {
 	// chdir
 	// chdir must be tracked as we must tell Record of the new cwd
 	// /!\ chdir manipulates cwd, which mandates an exclusive lock
-	int chdir (CC* p ) NE { HEADER0(chdir ,(p )) ; NO_SERVER(chdir ) ; Chdir r{p     ,"chdir" } ; return r(orig(F(r))) ; }
-	int fchdir(int fd) NE { HEADER0(fchdir,(fd)) ; NO_SERVER(fchdir) ; Chdir r{Fd(fd),"fchdir"} ; return r(orig(A(r))) ; }
+	int chdir (CC* p ) NE { HEADERX(chdir ,(p )) ; NO_SERVER(chdir ) ; Chdir r{p     ,"chdir" } ; return r(orig(F(r))) ; }
+	int fchdir(int fd) NE { HEADERX(fchdir,(fd)) ; NO_SERVER(fchdir) ; Chdir r{Fd(fd),"fchdir"} ; return r(orig(A(r))) ; }
 
 	// chmod
 	// although file is not modified, resulting file after chmod depends on its previous content, much like a copy
@@ -388,14 +403,15 @@ struct Mkstemp : WSolve {
 	// /!\ lock is not strictly necessary, but we must beware of interaction between lock & fork : locks are duplicated
 	//     if another thread has the lock while we fork => child will dead lock as it has the lock but not the thread
 	//     a simple way to stay coherent is to take the lock before fork and to release it after both in parent & child
+	//     lock is exclusive, so no other thread is in audited code and Record internal lock is free as well
 	// vfork is mapped to fork as vfork prevents most actions before following exec and we need a clean semantic to instrument exec
-	pid_t fork       () NE { HEADER0(fork       ,()) ; NO_SERVER(fork       ) ; return orig()   ; }
-	pid_t __fork     () NE { HEADER0(__fork     ,()) ; NO_SERVER(__fork     ) ; return orig()   ; }
-	pid_t __libc_fork() NE { HEADER0(__libc_fork,()) ; NO_SERVER(__libc_fork) ; return orig()   ; }
+	pid_t fork       () NE { HEADERX(fork       ,()) ; NO_SERVER(fork       ) ; return orig()   ; }
+	pid_t __fork     () NE { HEADERX(__fork     ,()) ; NO_SERVER(__fork     ) ; return orig()   ; }
+	pid_t __libc_fork() NE { HEADERX(__libc_fork,()) ; NO_SERVER(__libc_fork) ; return orig()   ; }
 	pid_t vfork      () NE {                                                    return fork  () ; }
 	pid_t __vfork    () NE {                                                    return __fork() ; }
 	//
-	int system(CC* cmd) { HEADER0(system,(cmd)) ; return orig(cmd) ; } // cf fork for explanation as this syscall does fork
+	int system(CC* cmd) { HEADERX(system,(cmd)) ; return orig(cmd) ; } // cf fork for explanation as this syscall does fork
 
 	#ifndef IN_SERVER
 		// getcwd
@@ -573,10 +589,11 @@ struct Mkstemp : WSolve {
 		}
 		SyscallDescr::Tab const& tab   = SyscallDescr::s_tab(false/*for_ptrace*/) ;
 		SyscallDescr      const& descr = tab[n]                                   ;
-		HEADER(
+		HEADER_LOCK(                                                             // syscall may be chdir or fork, which require exclusivity, generic syscall is rare anyway
 			syscall
 		,	( !descr || (descr.filter&&Record::s_is_simple(reinterpret_cast<const char*>(args[descr.filter-1]))) )
 		,	(n,args[0],args[1],args[2],args[3],args[4],args[5])
+		,	ExclusiveLock
 		) ;
 		void* descr_ctx = nullptr ;
 		Ctx audit_ctx ;                                                          // save user errno when required
@@ -597,7 +614,9 @@ struct Mkstemp : WSolve {
 	#undef HEADER2
 	#undef HEADER1
 	#undef HEADER0
+	#undef HEADERX
 	#undef HEADER
+	#undef HEADER_LOCK
 
 	#undef ORIG
 
@@ -18,13 +18,15 @@ AutodepLock::AutodepLock(::vmap_s<DepDigest>* deps) : lock{_s_mutex} {
 	SWEAR( !Record::s_deps && !Record::s_deps_err ) ;
 	SWEAR( !*Record::s_access_cache               ) ;
 	Record::s_deps     = deps ;
-	Record::s_deps_err = &err ;
-	t_active           = true ;
+	Record::s_deps_err = &err      ;
+	Record::s_accessed = &accessed ;
+	t_active           = true      ;
 }
 
 AutodepLock::~AutodepLock() {
 	Record::s_deps     = nullptr ;
 	Record::s_deps_err = nullptr ;
+	Record::s_accessed = nullptr ;
 	t_active           = false   ;
 	Record::s_access_cache->clear() ;
 	if (auditer().seen_chdir) swear_prod(::fchdir(Record::s_root_fd())==0) ; // restore cwd in case it has been modified during user Python code execution
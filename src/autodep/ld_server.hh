@@ -21,6 +21,7 @@ public :
 	//
 	~AutodepLock() ;
 	// data
-	Lock<Mutex<MutexLvl::Autodep1>> lock ;
-	::string                        err  ;
+	Lock<Mutex<MutexLvl::Autodep1>> lock     ;
+	::string                        err      ;
+	bool                            accessed = false ; // true if any file access has been reported, whether recorded in deps or not
 } ;
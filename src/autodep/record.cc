@@ -25,9 +25,13 @@ static constexpr Accesses UserStatAccesses = StrictUserAccesses ? ~Accesses() :
 bool                                                   Record::s_static_report = false   ;
 ::vmap_s<DepDigest>                                  * Record::s_deps          = nullptr ;
 ::string                                             * Record::s_deps_err      = nullptr ;
+bool                                                 * Record::s_accessed      = nullptr ;
 ::umap_s<pair<Accesses/*accessed*/,Accesses/*seen*/>>* Record::s_access_cache  = nullptr ; // map file to read accesses
 AutodepEnv*                                            Record::_s_autodep_env  = nullptr ; // declare as pointer to avoid late initialization
 Fd                                                     Record::_s_root_fd      ;
+ShmRing*                                               Record::_s_ring         = nullptr ;
+pid_t                                                  Record::_s_ring_pid     = 0       ;
+Mutex<MutexLvl::Record>                                Record::_s_mutex        ;
 
 bool Record::s_is_simple(const char* file) {
 	if (!file        ) return true  ;                                     // no file is simple (not documented, but used in practice)
@@ -72,6 +76,7 @@ bool Record::s_is_simple(const char* file) {
 void Record::_static_report(JobExecRpcReq&& jerr) const {
 	switch (jerr.proc) {
 		case Proc::Access  :
+			if ( s_accessed && +jerr.files ) *s_accessed = true ;
 			if      (jerr.digest.write!=No) for( auto& [f,dd] : jerr.files ) append_to_string(*s_deps_err,"unexpected write/unlink to " ,f,'\n') ; // can have only deps from within server
 			else if (!s_deps              ) for( auto& [f,dd] : jerr.files ) append_to_string(*s_deps_err,"unexpected access of "       ,f,'\n') ; // can have no deps when no way to record them
 			else {
@@ -87,9 +92,34 @@ void Record::_static_report(JobExecRpcReq&& jerr) const {
 	}
 }
 
+void Record::_ring_report(JobExecRpcReq const& jerr) const {
+	pid_t pid = ::getpid() ;                                                               // ring is single producer, so we must not share it with children, even vfork'ed ones
+	if (!_s_ring_pid) {
+		_s_ring_pid = pid ;
+		if (_s_autodep_env->service.back()!=':') {                                         // no ring when reporting to a file
+			_s_ring = new ShmRing{New} ;
+			bool ok = +*_s_ring ;
+			if (ok) {
+				OMsgBuf().send( report_fd() , JobExecRpcReq(Proc::Ring,true/*sync*/,_s_ring->file()) ) ;
+				ok = _get_reply().ok==Yes ;                                                // job_exec may not be able to map ring
+			}
+			if (ok) { _s_ring->announced() ;                   }
+			else    { delete _s_ring       ; _s_ring = nullptr ; }
+		}
+	}
+	if ( pid==_s_ring_pid && _s_ring && _s_ring->push(OMsgBuf::s_send(jerr)) ) {
+		if (_s_ring->chk_waiting()) OMsgBuf().send( report_fd() , JobExecRpcReq(Proc::Doorbell) ) ;
+	} else {
+		OMsgBuf().send(report_fd(),jerr) ;                                                 // job_exec drains rings before handling socket messages, so order is preserved
+	}
+}
+
 void Record::_report_access( JobExecRpcReq&& jerr ) const {
 	SWEAR( jerr.proc==Proc::Access , jerr.proc ) ;
 	if (s_autodep_env().disabled) return ;                                                 // dont update cache as report is not actually done
+	if (jerr.digest.write==Maybe) jerr.id = _s_thread_id() ;                               // a Confirm from the same thread will follow
+	if ( written && jerr.digest.write!=No ) for( auto const& [f,_] : jerr.files ) written->push_back(f) ;
+	Lock lock { _s_mutex } ;                                                               // cache check and report must be atomic w.r.t. other threads
 	if (!jerr.sync) {
 		bool miss = false ;
 		for( auto const& [f,dd] : jerr.files ) {
@@ -110,13 +140,14 @@ void Record::_report_access( JobExecRpcReq&& jerr ) const {
 		}
 		if (!miss) return ;                                                                // modifying accesses cannot be cached as we do not know what other processes may have done in between
 	}
-	_report(::move(jerr)) ;
+	_send(::move(jerr)) ;
 }
 
 JobExecRpcReply Record::direct(JobExecRpcReq&& jerr) {
 	if (s_autodep_env().active) {
 		bool sync = jerr.sync ;   // save before moving jerr
-		_report(::move(jerr)) ;
+		Lock lock { _s_mutex } ;  // reply must be read by the thread that sent the request
+		_send(::move(jerr)) ;
 		if (sync) return _get_reply() ;
 		else      return {}           ;
 	} else {
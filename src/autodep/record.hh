@@ -26,8 +26,11 @@ struct Record {
 	static Fd s_root_fd() {
 		SWEAR(_s_autodep_env) ;
 		if (!_s_root_fd) {
-			_s_root_fd = Disk::open_read(_s_autodep_env->root_dir) ; _s_root_fd.no_std() ;                                  // avoid poluting standard descriptors
-			SWEAR(+_s_root_fd) ;
+			Lock lock { _s_mutex } ;
+			if (!_s_root_fd) {                                                                                              // another thread may have opened it while we were waiting
+				_s_root_fd = Disk::open_read(_s_autodep_env->root_dir) ; _s_root_fd.no_std() ;                              // avoid poluting standard descriptors
+				SWEAR(+_s_root_fd) ;
+			}
 		}
 		return _s_root_fd ;
 	}
@@ -54,10 +57,16 @@ public :
 	static bool                                                   s_static_report  ;                                        // if true <=> report deps to s_deps instead of through report_fd() socket
 	static ::vmap_s<DepDigest>                                  * s_deps           ;
 	static ::string                                             * s_deps_err       ;
+	static bool                                                 * s_accessed       ;                                        // set to true upon any access report when s_static_report
 	static ::umap_s<pair<Accesses/*accessed*/,Accesses/*seen*/>>* s_access_cache   ;                                        // map file to read accesses
 private :
 	static AutodepEnv* _s_autodep_env ;
 	static Fd          _s_root_fd     ;                                                                                     // a file descriptor to repo root dir
+	static ShmRing*    _s_ring        ;                                                                                     // if shm_report, ring through which asynchronous reports are sent
+	static pid_t       _s_ring_pid    ;                                                                                     // process owning _s_ring, others (e.g. after fork) report through socket
+	// audited calls run concurrently (only chdir is exclusive), hence the report connection, the access cache, etc. must be protected
+	// _s_mutex is only held while reporting, not while the audited call proceeds
+	static Mutex<MutexLvl::Record> _s_mutex ;
 	// cxtors & casts
 public :
 	Record(                                      ) = default ;
@@ -66,7 +75,7 @@ public :
 		if (enable!=Maybe) s_set_enable(enable==Yes) ;
 	}
 	// services
-	Fd report_fd() const {
+	Fd report_fd() const {                                                                                                  // _s_mutex must be locked
 		if (!_report_fd) {
 			// establish connection with server
 			::string const& service = _s_autodep_env->service ;
@@ -78,21 +87,33 @@ public :
 		return _report_fd ;
 	}
 	void hide(int fd) const {
+		Lock lock { _s_mutex } ;
 		if (_s_root_fd.fd==fd) _s_root_fd.detach() ;
 		if (_report_fd.fd==fd) _report_fd.detach() ;
 	}
 	void hide( uint min , uint max ) const {
+		Lock lock { _s_mutex } ;
 		if ( _s_root_fd.fd>=0 &&  uint(_s_root_fd.fd)>=min && uint(_s_root_fd.fd)<=max ) _s_root_fd.detach() ;
 		if ( _report_fd.fd>=0 &&  uint(_report_fd.fd)>=min && uint(_report_fd.fd)<=max ) _report_fd.detach() ;
 	}
 private :
-	void _static_report(JobExecRpcReq&& jerr) const ;
-	void _report       (JobExecRpcReq&& jerr) const {
-		if (s_autodep_env().disabled) return ;
-		if (s_static_report         ) _static_report(::move(jerr))     ;
-		else                          OMsgBuf().send(report_fd(),jerr) ;
+	static uint64_t _s_thread_id() {                                                                                        // unique among live threads, at no cost
+		static thread_local char s_anchor ;
+		return reinterpret_cast<uint64_t>(&s_anchor) ;
 	}
-	JobExecRpcReply _get_reply() const {
+	void _static_report(JobExecRpcReq&& jerr     ) const ;
+	void _ring_report  (JobExecRpcReq const& jerr) const ;
+	void _send         (JobExecRpcReq&& jerr     ) const {                                                                  // _s_mutex must be locked
+		if      (s_autodep_env().disabled                 ) return ;
+		if      (s_static_report                          ) _static_report(::move(jerr))     ;
+		else if (!jerr.sync && s_autodep_env().shm_report ) _ring_report  (jerr)             ; // synchronous requests need a reply and go through socket
+		else                                                OMsgBuf().send(report_fd(),jerr) ;
+	}
+	void _report(JobExecRpcReq&& jerr) const {
+		Lock lock { _s_mutex } ;
+		_send(::move(jerr)) ;
+	}
+	JobExecRpcReply _get_reply() const {                                                                                    // _s_mutex must be locked
 		if (s_static_report) return {}                                              ;
 		else                 return IMsgBuf().receive<JobExecRpcReply>(report_fd()) ;
 	}
@@ -129,14 +150,19 @@ private :
 		_report_access({ Proc::Access , ::move(files) , {.write=Maybe} , ::move(c) }) ;
 	}
 	void _report_tmp( bool sync=false , ::string&& c={} ) const {
+		Lock lock { _s_mutex } ;
 		if      (!_tmp_cache) _tmp_cache = true ;
 		else if (!sync     ) return ;
-		_report({Proc::Tmp,sync,::move(c)}) ;
+		_send({Proc::Tmp,sync,::move(c)}) ;
 	}
 	void _report_confirm( FileLoc fl , bool ok ) const {
-		if (fl==FileLoc::Repo) _report({ Proc::Confirm , ok }) ;
+		if (fl!=FileLoc::Repo) return ;
+		JobExecRpcReq jerr { Proc::Confirm , ok } ;
+		jerr.id = _s_thread_id() ;                                                                                      // only confirm accesses reported by this thread
+		_report(::move(jerr)) ;
 	}
 	void _report_guard( ::string&& f , ::string&& c={} ) const {
+		if (written) written->push_back(f) ;
 		_report({ Proc::Guard , {::move(f)} , ::move(c) }) ;
 	}
 public :
@@ -341,7 +367,8 @@ public :
 	}
 	//
 	// data
-	bool seen_chdir = false ;
+	bool        seen_chdir = false   ;
+	::vector_s* written    = nullptr ; // if not null, files reported as written or guarded are also recorded there, in order, so that syscall results can be deduced from disk
 private :
 	Disk::RealPath      _real_path ;
 	mutable AutoCloseFd _report_fd ;
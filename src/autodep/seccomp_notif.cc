@@ -0,0 +1,298 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#include <poll.h>
+#include <stddef.h>      // offsetof
+#include <syscall.h>     // for SYS_* macros
+#include <sys/ioctl.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+
+#include "disk.hh"
+
+#include "record.hh"
+#include "syscall_tab.hh"
+
+#include "seccomp_notif.hh"
+
+#if HAS_SECCOMP_NOTIF    // must be after utils.hh include
+	#include <linux/audit.h>
+	#include <linux/filter.h>
+	#include <linux/seccomp.h>
+#endif
+
+AutodepEnv* AutodepSeccompNotif::s_autodep_env = nullptr ;
+
+static AutoCloseFd _g_channel_rx ; // channel through which child passes listener fd to us
+static AutoCloseFd _g_channel_tx ; // .
+
+#if HAS_SECCOMP_NOTIF
+
+#if defined(__x86_64__)
+	static constexpr uint32_t AuditArch = AUDIT_ARCH_X86_64  ;
+#elif defined(__aarch64__)
+	static constexpr uint32_t AuditArch = AUDIT_ARCH_AARCH64 ;
+#elif defined(__i386__)
+	static constexpr uint32_t AuditArch = AUDIT_ARCH_I386    ;
+#else
+	#error "seccomp user notification autodep not implemented for this architecture" // if situation arises, please provide the adequate AUDIT_ARCH_* value
+#endif
+
+struct SeccompPidInfo {
+	// static data
+	static ::umap<pid_t,SeccompPidInfo> s_tab ;                 // entries are never moved, so record.written stays valid
+	// cxtors & casts
+	SeccompPidInfo(pid_t pid) : record{New,pid} { record.written = &written ; }
+	// data
+	Record     record   ;
+	::vector_s written  ;                                       // files reported as written or guarded by syscall idx
+	size_t     idx      = 0       ;                             // syscall whose exit proc is pending
+	void*      ctx      = nullptr ;                             // if not null, exit proc of syscall idx is pending
+	bool       exchange = false   ;                             // if idx is a rename, whether it was an exchange
+} ;
+::umap<pid_t,SeccompPidInfo> SeccompPidInfo::s_tab ;
+
+// notification being handled, child memory is only trusted if it is still valid once read
+static int      _g_listener = -1 ;
+static uint64_t _g_notif_id = 0  ;
+static bool/*ok*/ _notif_valid() {
+	return ::ioctl( _g_listener , SECCOMP_IOCTL_NOTIF_ID_VALID , &_g_notif_id )==0 ;
+}
+
+// syscall results are not reported to us, so when exit proc is run, result is deduced from disk :
+// - chdir : exit proc reads actual cwd in /proc, which is correct whether syscall succeeded or not
+// - others : exit proc only confirms writes, which is deduced from the existence of written files after the syscall
+// written files are only known when in repo, which is the only case where a confirmation is reported
+static int _probe_res( SeccompPidInfo const& info ) {
+	auto exists = [](::string const& f)->bool { return Disk::FileInfo(Record::s_root_fd(),f,true/*no_follow*/).tag()!=FileTag::None ; } ;
+	auto res    = [](bool ok             )->int  { return ok ? 0 : -1                                                             ; } ;
+	::vector_s const& w = info.written ;
+	if (!w) return 0 ;                                                                                                     // nothing to confirm
+	switch (info.idx) {
+		#ifdef SYS_creat
+			case SYS_creat             :
+		#endif
+		#ifdef SYS_open
+			case SYS_open              :
+		#endif
+		#ifdef SYS_openat2
+			case SYS_openat2           :
+		#endif
+		case SYS_openat            :
+		case SYS_name_to_handle_at :
+		#ifdef SYS_chmod
+			case SYS_chmod             :
+		#endif
+		case SYS_fchmodat          :
+		#ifdef SYS_link
+			case SYS_link              :
+		#endif
+		case SYS_linkat            :
+		#ifdef SYS_symlink
+			case SYS_symlink           :
+		#endif
+		case SYS_symlinkat         : return res( exists(w.back())) ;                                                        // a single file is written
+		#ifdef SYS_unlink
+			case SYS_unlink            :
+		#endif
+		case SYS_unlinkat          : return res(!exists(w.back())) ;                                                        // .
+		#ifdef SYS_rename
+			case SYS_rename            :
+		#endif
+		#ifdef SYS_renameat
+			case SYS_renameat          :
+		#endif
+		case SYS_renameat2         : {                                                                                     // src and dst are guarded last, when in repo
+			auto const&     rn  = *static_cast<Record::Rename*>(info.ctx)              ;
+			size_t          i   = w.size()                                            ;
+			::string const* dst = rn.dst.file_loc==FileLoc::Repo ? &w[--i] : nullptr ;
+			::string const* src = rn.src.file_loc==FileLoc::Repo ? &w[--i] : nullptr ;
+			if ( src && dst && *src==*dst ) return 0 ;                                                                     // nop
+			return res( (!src||exists(*src)==info.exchange) && (!dst||exists(*dst)) ) ;
+		}
+		default : return 0 ;                                                                                                                   // chdir/fchdir
+	}
+}
+
+void AutodepSeccompNotif::s_init(AutodepEnv const& ade) {
+	s_autodep_env = new AutodepEnv{ade} ;
+	int fds[2] ;
+	swear_prod( ::socketpair( AF_UNIX , SOCK_SEQPACKET|SOCK_CLOEXEC , 0 , fds )==0 , "cannot create channel to receive seccomp listener" ) ;
+	_g_channel_rx = Fd(fds[0],true/*no_std*/) ;
+	_g_channel_tx = Fd(fds[1],true/*no_std*/) ;
+}
+
+void AutodepSeccompNotif::s_prepare_child() {
+	AutodepEnv const& ade = Record::s_autodep_env(*s_autodep_env) ;
+	SWEAR( !ade.tmp_view , ade.tmp_view ) ;                                                                  // cannot support directory mapping as we cannot alter syscall args
+	_g_channel_rx.close() ;
+	// prepare filter : notify watched syscalls, allow others
+	bool                            ignore_stat = ade.ignore_stat && ade.lnk_support!=LnkSupport::Full ;     // if full link support, we need to analyze uphill dirs
+	static SyscallDescr::Tab const& tab         = SyscallDescr::s_tab(true/*for_ptrace*/)              ;     // same constraints as ptrace : no tmp mapping
+	::vector<uint32_t>              syscalls    = { SYS_exit , SYS_exit_group }                         ;     // to run pending exit procs and forget about thread
+	for( long syscall=0 ; syscall<SyscallDescr::NSyscalls ; syscall++ ) {
+		SyscallDescr const& entry = tab[syscall] ;
+		if ( !entry                            ) continue ;                                                  // entry is not allocated
+		if ( !entry.data_access && ignore_stat ) continue ;                                                  // non stat-like access are always needed
+		syscalls.push_back(syscall) ;
+	}
+	SWEAR( syscalls.size()<256 , syscalls.size() ) ;                                                         // BPF jump offsets are 8 bits
+	::vector<sock_filter> prog ;
+	prog.push_back(BPF_STMT( BPF_LD |BPF_W  |BPF_ABS , offsetof(seccomp_data,arch)          )) ;
+	prog.push_back(BPF_JUMP( BPF_JMP|BPF_JEQ|BPF_K   , AuditArch , 1/*next*/ , 0/*allow*/    )) ;            // foreign syscalls are not watched (as with ptrace)
+	prog.push_back(BPF_STMT( BPF_RET|BPF_K           , SECCOMP_RET_ALLOW                    )) ;
+	prog.push_back(BPF_STMT( BPF_LD |BPF_W  |BPF_ABS , offsetof(seccomp_data,nr  )          )) ;
+	for( size_t i=0 ; i<syscalls.size() ; i++ )
+		prog.push_back(BPF_JUMP( BPF_JMP|BPF_JEQ|BPF_K , syscalls[i] , uint8_t(syscalls.size()-i)/*notify*/ , 0/*next*/ )) ;
+	prog.push_back(BPF_STMT( BPF_RET|BPF_K           , SECCOMP_RET_ALLOW                    )) ;
+	prog.push_back(BPF_STMT( BPF_RET|BPF_K           , SECCOMP_RET_USER_NOTIF               )) ;
+	struct sock_fprog fprog { .len=static_cast<unsigned short>(prog.size()) , .filter=prog.data() } ;
+	// load filter
+	if (::prctl(PR_SET_NO_NEW_PRIVS,1,0,0,0)!=0) throw "cannot set no_new_privs to load seccomp filter"s ;
+	int listener = ::syscall( SYS_seccomp , SECCOMP_SET_MODE_FILTER , SECCOMP_FILTER_FLAG_NEW_LISTENER , &fprog ) ;
+	if (listener<0) throw "cannot load seccomp filter with user notification : "s+strerror(errno) ;
+	// pass listener to parent, as long as it is in flight, notifications are kept pending
+	char           dummy = 0                                  ;
+	struct iovec   iov   { .iov_base=&dummy , .iov_len=1 }   ;
+	char           ctl[CMSG_SPACE(sizeof(int))] {}            ;
+	struct msghdr  msg   {}                                   ;
+	msg.msg_iov        = &iov        ;
+	msg.msg_iovlen     = 1           ;
+	msg.msg_control    = ctl         ;
+	msg.msg_controllen = sizeof(ctl) ;
+	struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg) ;
+	cmsg->cmsg_level = SOL_SOCKET            ;
+	cmsg->cmsg_type  = SCM_RIGHTS            ;
+	cmsg->cmsg_len   = CMSG_LEN(sizeof(int)) ;
+	::memcpy( CMSG_DATA(cmsg) , &listener , sizeof(int) ) ;
+	if (::sendmsg(_g_channel_tx,&msg,0)!=1) throw "cannot pass seccomp listener to parent"s ;
+	::close(listener) ;
+	_g_channel_tx.close() ;
+}
+
+void AutodepSeccompNotif::_init(pid_t cp) {
+	Record::s_autodep_env(*s_autodep_env) ;
+	child_pid = cp ;
+	_g_channel_tx.close() ;                                                                                  // so that we see end of file if child fails before passing listener
+	//
+	char           dummy = 0                                ;
+	struct iovec   iov   { .iov_base=&dummy , .iov_len=1 } ;
+	char           ctl[CMSG_SPACE(sizeof(int))] {}          ;
+	struct msghdr  msg   {}                                 ;
+	msg.msg_iov        = &iov        ;
+	msg.msg_iovlen     = 1           ;
+	msg.msg_control    = ctl         ;
+	msg.msg_controllen = sizeof(ctl) ;
+	if (::recvmsg(_g_channel_rx,&msg,MSG_CMSG_CLOEXEC)==1)
+		if ( struct cmsghdr* cmsg=CMSG_FIRSTHDR(&msg) ; cmsg && cmsg->cmsg_type==SCM_RIGHTS ) {
+			int listener ; ::memcpy( &listener , CMSG_DATA(cmsg) , sizeof(int) ) ;
+			_listener = listener ;
+		}
+	_g_channel_rx.close() ;
+	_g_listener            = _listener    ;
+	SyscallDescr::s_vm_chk = _notif_valid ;                                                                      // we are not the tracer of child, access its memory accordingly
+	_pidfd = int(::syscall( SYS_pidfd_open , child_pid , 0 )) ;                                                 // if not available, we stop when no process uses the filter any more
+}
+
+void AutodepSeccompNotif::_handle( ::string& req_buf , ::string& resp_buf ) {
+	static SyscallDescr::Tab const& tab = SyscallDescr::s_tab(true/*for_ptrace*/) ;
+	seccomp_notif     * req  = reinterpret_cast<seccomp_notif     *>(req_buf .data()) ;
+	seccomp_notif_resp* resp = reinterpret_cast<seccomp_notif_resp*>(resp_buf.data()) ;
+	::memset( req_buf .data() , 0 , req_buf .size() ) ;
+	::memset( resp_buf.data() , 0 , resp_buf.size() ) ;
+	if (::ioctl(_listener,SECCOMP_IOCTL_NOTIF_RECV,req)!=0) return ;                                         // e.g. notifying thread was killed in between
+	resp->id    = req->id                           ;
+	resp->flags = SECCOMP_USER_NOTIF_FLAG_CONTINUE ;                                                         // by default, let syscall proceed
+	_g_notif_id = req->id                           ;
+	//
+	pid_t           pid  = req->pid                                           ;
+	long            nr   = req->data.nr                                       ;
+	auto            it   = SeccompPidInfo::s_tab.try_emplace(pid,pid).first ;
+	SeccompPidInfo& info = it->second                                         ;
+	if (info.ctx) {                                                                                          // previous syscall of this thread is done, but its result is not known
+		tab[info.idx].exit( info.ctx , info.record , pid , _probe_res(info) ) ;
+		info.ctx = nullptr ;
+	}
+	if ( nr==SYS_exit || nr==SYS_exit_group ) {
+		SeccompPidInfo::s_tab.erase(it) ;                                                                    // free resources, pid may be reused
+	} else if ( nr>=0 && nr<SyscallDescr::NSyscalls && +tab[nr] ) {
+		SyscallDescr const& descr = tab[nr] ;
+		uint64_t            args[6] ; for( int i=0 ; i<6 ; i++ ) args[i] = req->data.args[i] ;
+		info.written.clear() ;
+		descr.entry( info.ctx , info.record , pid , args , descr.comment ) ;
+		if (!descr.exit) {
+			SWEAR(!info.ctx,nr) ;                                                                            // no need for a context if we are not called at exit
+		} else if (
+		#ifdef SYS_readlink
+			nr==SYS_readlink ||
+		#endif
+			nr==SYS_readlinkat
+		) {                                                                                                  // readlink may access backdoor, which must be emulated before syscall proceeds
+			int64_t res = descr.exit( info.ctx , info.record , pid , -1/*res*/ ) ;
+			info.ctx = nullptr ;
+			if (res>=0) { resp->flags = 0 ; resp->val = res ; }                                              // access to backdoor was emulated, result has been written in child memory
+		} else {
+			info.idx      = nr    ;
+			info.exchange = false ;
+			#if defined(SYS_renameat2) && defined(RENAME_EXCHANGE)
+				if (nr==SYS_renameat2) info.exchange = args[4]&RENAME_EXCHANGE ;
+			#endif
+		}
+	}
+	::ioctl(_listener,SECCOMP_IOCTL_NOTIF_SEND,resp) ;                                                       // ignore errors : notifying thread may have been killed in between
+}
+
+int/*wstatus*/ AutodepSeccompNotif::process() {
+	struct seccomp_notif_sizes sizes ;
+	if ( +_listener && ::syscall(SYS_seccomp,SECCOMP_GET_NOTIF_SIZES,0,&sizes)!=0 ) fail_prod("cannot get seccomp notification sizes") ;
+	::string req_buf  ( ::max(size_t(sizes.seccomp_notif     ),sizeof(seccomp_notif     )) , 0 ) ;           // kernel may have larger structs than we know of
+	::string resp_buf ( ::max(size_t(sizes.seccomp_notif_resp),sizeof(seccomp_notif_resp)) , 0 ) ;           // .
+	// serve until no process uses filter any more, as background processes may survive child
+	// however, filter is only released when a process is reaped, so child must be waited for as soon as it terminates
+	int  wstatus    = 0     ;
+	bool child_done = false ;
+	auto wait_child = [&](int flags)->void {
+		pid_t pid = ::waitpid(child_pid,&wstatus,flags) ;
+		if (pid==0) return ;                                                                                 // child is still alive
+		SWEAR( pid==child_pid , pid , child_pid ) ;
+		child_done = true ;
+		_pidfd.close() ;
+	} ;
+	while (+_listener) {
+		struct pollfd fds[2] = { {.fd=_listener,.events=POLLIN,.revents=0} , {.fd=child_done?-1:int(_pidfd),.events=POLLIN,.revents=0} } ; // negative fds are ignored
+		int           tmo    = child_done||+_pidfd ? -1 : 100/*ms*/                                                                    ; // if no pidfd, poll child termination
+		if (::poll(fds,2,tmo)<0) {
+			if (errno==EINTR) continue ;
+			fail_prod("cannot poll seccomp listener : ",strerror(errno)) ;
+		}
+		if      (fds[0].revents&POLLIN           ) _handle(req_buf,resp_buf) ;                               // handle notifications first as child may wait for us
+		else if (fds[0].revents&(POLLHUP|POLLERR)) break ;                                                   // no process uses filter any more
+		if ( !child_done && (fds[1].revents||!_pidfd) ) wait_child(WNOHANG) ;                                // reap child as soon as it is dead
+	}
+	if (!child_done) wait_child(0) ;
+	// run exit procs of threads that disappeared without notifying their exit (e.g. killed or non-calling threads of exit_group)
+	static SyscallDescr::Tab const& tab = SyscallDescr::s_tab(true/*for_ptrace*/) ;
+	for( auto& [pid,info] : SeccompPidInfo::s_tab ) {
+		if (!info.ctx) continue ;
+		bool is_chdir = false ;
+		#ifdef SYS_chdir
+			is_chdir |= info.idx==SYS_chdir ;
+		#endif
+		is_chdir |= info.idx==SYS_fchdir ;
+		tab[info.idx].exit( info.ctx , info.record , pid , is_chdir?-1:_probe_res(info) ) ;                  // cwd of a dead thread is meaningless
+	}
+	SeccompPidInfo::s_tab.clear() ;
+	return wstatus ;
+}
+
+#else
+
+void           AutodepSeccompNotif::s_init         (AutodepEnv const&) { fail_prod("seccomp user notification is not supported on this system") ; }
+void           AutodepSeccompNotif::s_prepare_child(                 ) { fail_prod("seccomp user notification is not supported on this system") ; }
+void           AutodepSeccompNotif::_init          (pid_t            ) { fail_prod("seccomp user notification is not supported on this system") ; }
+void           AutodepSeccompNotif::_handle        (::string&,::string&) {                                                                            }
+int/*wstatus*/ AutodepSeccompNotif::process        (                 ) { fail_prod("seccomp user notification is not supported on this system") ; }
+
+#endif
@@ -0,0 +1,36 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include "gather.hh"
+#include "record.hh"
+
+// Watch a child through seccomp user notifications (SECCOMP_RET_USER_NOTIF) :
+// - child loads a filter that notifies watched syscalls to a listener fd and passes this fd to us before exec'ing
+// - for each notification, we read paths in child memory, report accesses and let the syscall proceed (SECCOMP_USER_NOTIF_FLAG_CONTINUE)
+// As opposed to ptrace, only the notifying thread waits for us and we are not involved in syscall exit.
+// Hence, exit processing (confirmation of writes, chdir) is deferred until the same thread is notified again (its previous syscall is then done) or exits.
+struct AutodepSeccompNotif {
+	// statics
+	static void s_init         (AutodepEnv const&) ; // must be called before child is spawned
+	static void s_prepare_child(                 ) ; // must be called from child
+	// static data
+	static AutodepEnv* s_autodep_env ;               // declare as pointer to avoid static late initialization
+	// cxtors & casts
+	AutodepSeccompNotif(        ) = default ;
+	AutodepSeccompNotif(pid_t cp) { _init(cp) ; }
+private :
+	void _init(pid_t child_pid) ;
+	// services
+	void _handle(::string& req_buf , ::string& resp_buf) ;
+public :
+	int/*wstatus*/ process() ;
+	// data
+	pid_t       child_pid = 0 ;
+private :
+	AutoCloseFd _listener ;                          // fd on which notifications are received
+	AutoCloseFd _pidfd    ;                          // fd to watch child termination
+} ;
@@ -0,0 +1,105 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include <sys/mman.h>
+
+#include "fd.hh"
+#include "msg.hh"
+
+// A byte ring in shared memory used by a job process (the single producer) to report accesses to job_exec (the single consumer) without a syscall per report.
+// Records are messages formatted by OMsgBuf::s_send (length followed by serialized data).
+// The ring lies in a memfd that job_exec maps by opening /proc/<pid>/fd/<fd> while the producer waits for the reply to its (synchronous) announcement.
+// Doorbell protocol, so that job_exec does not need to poll :
+// - producer pushes a record, then if consumer declared it waits, it resets waiting and rings the doorbell (a message on the regular socket)
+// - consumer drains the ring, declares it waits, then drains again to catch records pushed before producer could see it waits
+struct ShmRing {
+	using Len = MsgBuf::Len ;
+	static constexpr size_t Sz    = 1<<20 ;                                                   // data size, must be a power of 2
+	static constexpr size_t HdrSz = 64    ;                                                   // header is kept on its own cache line
+	struct Hdr {
+		::atomic<size_t> head    = 0     ;                                                    // consumer position, only written by consumer
+		::atomic<size_t> tail    = 0     ;                                                    // producer position, only written by producer
+		::atomic<bool  > waiting = false ;                                                    // if true <=> consumer waits for doorbell
+	} ;
+	static_assert( sizeof(Hdr)<=HdrSz && !(Sz&(Sz-1)) ) ;
+	// cxtors & casts
+	ShmRing() = default ;
+	ShmRing(NewType) {                                                                        // create as producer
+		_fd = ::memfd_create( "lmake_report" , MFD_CLOEXEC ) ; if (!_fd) return ;
+		_fd.no_std() ;                                                                        // avoid poluting standard descriptors
+		if (::ftruncate(_fd,HdrSz+Sz)!=0) { _fd.close() ; return ; }
+		_map() ;
+		if (_hdr) new(_hdr) Hdr ;
+	}
+	ShmRing(::string const& file) {                                                           // map as consumer
+		_fd = ::open( file.c_str() , O_RDWR|O_CLOEXEC ) ; if (!_fd) return ;                  // consumer writes head
+		_map() ;
+		_fd.close() ;                                                                         // mapping is enough
+	}
+	ShmRing(ShmRing&& r) { *this = ::move(r) ; }
+	~ShmRing() { _unmap() ; }
+	ShmRing& operator=(ShmRing&& r) {
+		_unmap() ;
+		_fd  = ::move(r._fd) ;
+		_hdr = r._hdr        ; r._hdr = nullptr ;
+		return *this ;
+	}
+	bool operator+() const { return _hdr     ; }
+	bool operator!() const { return !+*this  ; }
+	// accesses
+	::string file() const { return to_string("/proc/",::getpid(),"/fd/",_fd.fd) ; }         // valid until producer calls announced()
+	// services
+	void announced() { _fd.close() ; }                                                        // consumer has mapped ring, fd is no more necessary
+	void detach   () { _hdr = nullptr ; _fd.detach() ; }                                      // forget ring without unmapping, e.g. after fork where another process owns it
+	// producer side
+	bool/*ok*/ push(::string const& msg) {                                                    // msg is formatted by OMsgBuf::s_send
+		size_t t = _hdr->tail.load(::memory_order_relaxed) ;
+		if ( msg.size() > Sz-(t-_hdr->head.load()) ) return false ;                           // ring is full, caller must fall back to socket
+		_copy_in( t , msg.data() , msg.size() ) ;
+		_hdr->tail.store(t+msg.size()) ;                                                      // seq_cst is necessary to order wrt. waiting
+		return true ;
+	}
+	bool/*ring_doorbell*/ chk_waiting() { return _hdr->waiting.exchange(false) ; }
+	// consumer side
+	template<class T> bool/*popped*/ pop(T& x) {
+		size_t h = _hdr->head.load(::memory_order_relaxed) ;
+		size_t t = _hdr->tail.load()                       ;
+		if (h==t) return false ;
+		Len len ;                     _copy_out( h             , reinterpret_cast<char*>(&len) , sizeof(Len) ) ;
+		if ( t-h<sizeof(Len) || len>t-h-sizeof(Len) ) throw "corrupted report ring"s ;        // producer is not trusted more than through a socket
+		::string buf ( len , '\0' ) ; _copy_out( h+sizeof(Len) , buf.data()                    , len         ) ;
+		_hdr->head.store( h+sizeof(Len)+len , ::memory_order_release ) ;
+		x = deserialize<T>(IStringStream(::move(buf))) ;
+		return true ;
+	}
+	void wait() { _hdr->waiting = true ; }                                                    // caller must drain ring after this call
+private :
+	void _map() {
+		void* p = ::mmap( nullptr , HdrSz+Sz , PROT_READ|PROT_WRITE , MAP_SHARED , _fd , 0 ) ;
+		if (p!=MAP_FAILED) _hdr = static_cast<Hdr*>(p) ;
+	}
+	void _unmap() {
+		if (_hdr) ::munmap( _hdr , HdrSz+Sz ) ;
+		_hdr = nullptr ;
+	}
+	char* _data() const { return reinterpret_cast<char*>(_hdr)+HdrSz ; }
+	void _copy_in( size_t pos , const char* src , size_t sz ) {
+		size_t p   = pos&(Sz-1)        ;
+		size_t sz1 = ::min( sz , Sz-p ) ;
+		::memcpy( _data()+p , src     , sz1    ) ;
+		::memcpy( _data()   , src+sz1 , sz-sz1 ) ;
+	}
+	void _copy_out( size_t pos , char* dst , size_t sz ) const {
+		size_t p   = pos&(Sz-1)        ;
+		size_t sz1 = ::min( sz , Sz-p ) ;
+		::memcpy( dst     , _data()+p , sz1    ) ;
+		::memcpy( dst+sz1 , _data()   , sz-sz1 ) ;
+	}
+	// data
+	AutoCloseFd _fd  ;
+	Hdr*        _hdr = nullptr ;
+} ;
@@ -4,6 +4,7 @@
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
 #include <syscall.h> // for SYS_* macros
+#include <sys/uio.h> // process_vm_readv, process_vm_writev
 
 #include "ptrace.hh"
 #include "record.hh"
@@ -36,10 +37,33 @@
 	return {buf,sz} ;
 }
 
+// when pid is ptrace'd, its memory is accessed word by word with PTRACE_PEEKDATA/PTRACE_POKEDATA
+// when it is watched through seccomp user notifications, we are not its tracer and its memory is accessed in bulk with process_vm_readv/process_vm_writev
+// in the latter case, pid is not stopped by us, so SyscallDescr::s_vm_chk is called to ensure it is still the notifying thread before data is trusted
+
 // return null terminated string pointed by src in process pid's space
 [[maybe_unused]] static ::string _get_str( pid_t pid , uint64_t src ) {
 	if (!pid) return {reinterpret_cast<const char*>(src)} ;
 	::string res ;
+	if (SyscallDescr::s_vm_chk) {
+		static constexpr size_t MinPageSz = 4096 ;                                         // reads must not cross page boundaries as next page may not be mapped
+		for(;;) {
+			size_t pos   = res.size()                ;
+			size_t chunk = MinPageSz - src%MinPageSz ;
+			res.resize(pos+chunk) ;
+			struct iovec local  { .iov_base=res.data()+pos               , .iov_len=chunk } ;
+			struct iovec remote { .iov_base=reinterpret_cast<void*>(src) , .iov_len=chunk } ;
+			ssize_t      cnt    = ::process_vm_readv( pid , &local , 1 , &remote , 1 , 0/*flags*/ ) ;
+			if (cnt<=0) throw 0 ;
+			size_t len = ::strnlen( res.data()+pos , cnt ) ;
+			res.resize(pos+len) ;
+			if (len<size_t(cnt)) {
+				if (!SyscallDescr::s_vm_chk()) throw 0 ;                                   // child may have gone and pid been reused while we were reading
+				return res ;
+			}
+			src += cnt ;
+		}
+	}
 	errno = 0 ;
 	for(;;) {
 		uint64_t offset = src%sizeof(long)                                               ;
@@ -55,6 +79,13 @@
 // copy src to process pid's space @ dst
 [[maybe_unused]] static void _poke( pid_t pid , uint64_t dst , const char* src , size_t sz ) {
 	SWEAR(pid) ;
+	if (SyscallDescr::s_vm_chk) {
+		if (!SyscallDescr::s_vm_chk()) throw 0 ;                                    // dont write into another process if child has gone and pid been reused
+		struct iovec local  { .iov_base=const_cast<char*>(src)       , .iov_len=sz } ;
+		struct iovec remote { .iov_base=reinterpret_cast<void*>(dst) , .iov_len=sz } ;
+		if ( ::process_vm_writev( pid , &local , 1 , &remote , 1 , 0/*flags*/ ) != ssize_t(sz) ) throw 0 ;
+		return ;
+	}
 	errno = 0 ;
 	for( size_t chunk ; sz ; src+=chunk , dst+=chunk , sz-=chunk) {                 // invariant : copy src[i:sz] to dst
 		uint64_t offset = dst%sizeof(long) ;
@@ -70,9 +101,16 @@
 	}
 }
 
-// copy src to process pid's space @ dst
+// copy src in process pid's space to dst
 [[maybe_unused]] static void _peek( pid_t pid , char* dst , uint64_t src , size_t sz ) {
 	SWEAR(pid) ;
+	if (SyscallDescr::s_vm_chk) {
+		struct iovec local  { .iov_base=dst                          , .iov_len=sz } ;
+		struct iovec remote { .iov_base=reinterpret_cast<void*>(src) , .iov_len=sz } ;
+		if ( ::process_vm_readv( pid , &local , 1 , &remote , 1 , 0/*flags*/ ) != ssize_t(sz) ) throw 0 ;
+		if (!SyscallDescr::s_vm_chk()                                                         ) throw 0 ; // child may have gone and pid been reused while we were reading
+		return ;
+	}
 	errno = 0 ;
 	for( size_t chunk ; sz ; src+=chunk , dst+=chunk , sz-=chunk) { // invariant : copy src[i:sz] to dst
 		uint64_t offset = src%sizeof(long) ;
@@ -312,6 +350,8 @@ template<bool At,int FlagArg> [[maybe_unused]] static void _entry_stat( void* &
 }
 
 // XXX : find a way to put one entry per line instead of 3 lines(would be much more readable)
+bool/*ok*/ (*SyscallDescr::s_vm_chk)() = nullptr ;
+
 SyscallDescr::Tab const& SyscallDescr::s_tab(bool for_ptrace) {        // this must *not* do any mem allocation (or syscall impl in ld.cc breaks), so it cannot be a umap
 	static Tab                         s_tab    = {}    ;
 	static ::atomic<bool>              s_inited = false ;              // set to true once s_tab is initialized
@@ -12,6 +12,8 @@ struct SyscallDescr {
 	using Tab = ::array<SyscallDescr,NSyscalls> ;         // must be an array and not an umap so as to avoid calls to malloc before it is known to be safe
 	// static data
 	static Tab const& s_tab(bool for_ptrace) ;            // ptrace does not support tmp mapping, which simplifies table a bit
+	static bool/*ok*/ (*s_vm_chk)() ;                     // if not null, child memory is accessed with process_vm_readv/writev as we are not its tracer ...
+	//                                                    // ... and this is called after reading and before writing to ensure child is still the one we think of
 	// accesses
 	constexpr bool operator+() const { return prio    ; } // prio=0 means entry is not allocated
 	constexpr bool operator!() const { return !+*this ; }
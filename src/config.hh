@@ -27,6 +27,7 @@ using RuleTgtsIdx = uint32_t    ;
 using PsfxIdx     = RuleTgtsIdx ;
 using FileNameIdx = uint16_t    ; // 64k for a file name is already ridiculously long
 using CodecIdx    = uint32_t    ; // used to store code <-> value associations in lencode/ldecode
+using InvIdx      = uint32_t    ; // used to index reverse links from nodes to jobs referring to them
 
 // ids
 using SmallId = uint32_t ; // used to identify running jobs, could be uint16_t if we are sure that there cannot be more than 64k jobs running at once
@@ -144,9 +144,9 @@ namespace Disk {
 
 	::string read_content(::string const& file) {
 		::ifstream is{file} ;
-		if (!is                  ) throw to_string("file not found : ",file) ;
-		if (::istream::sentry(is)) return to_string(is.rdbuf())              ; // /!\ rdbuf() fails on an empty file
-		else                       return {}                                 ;
+		if (!is                                   ) throw to_string("file not found : ",file) ;
+		if (::istream::sentry(is,true/*noskipws*/)) return to_string(is.rdbuf())              ; // /!\ rdbuf() fails on an empty file, sentry must not skip leading spaces
+		else                                        return {}                                 ;
 	}
 
 	void write_lines( ::string const& file , ::vector_s const& lines ) {
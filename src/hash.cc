@@ -3,6 +3,8 @@
 // This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
+#include <thread>
+
 #include "fd.hh"
 #include "hash.hh"
 
@@ -19,55 +21,70 @@ namespace Hash {
 		else                              return os << "Crc("<<special<<')'                                    ;
 	}
 
-	Crc::Crc( ::string const& filename , Algo algo ) {
+	// large reads amortize syscalls on big files, mmap is avoided as a file truncated while being hashed (e.g. by a running job) would generate a SIGBUS
+	// buffer is allocated once per thread so that hashing a lot of small files does not cost an allocation each
+	static constexpr size_t BufSz = 1<<17 ;
+	static thread_local ::unique_ptr<char[]> _t_buf ;
+
+	// return No if fd is a dir, Maybe if it is empty, Yes if it has data
+	static Bool3 _update_from_fd( Xxh& ctx , Fd fd , ::string const& filename ) {
+		if (!_t_buf) _t_buf = ::unique_ptr<char[]>{new char[BufSz]} ;
+		Bool3 res = Maybe ;
+		::posix_fadvise( fd , 0 , 0 , POSIX_FADV_SEQUENTIAL ) ;                            // best effort, ignore errors
+		for(;;) {
+			ssize_t cnt = ::read( fd , _t_buf.get() , BufSz ) ;
+			if      (cnt> 0) { res = Yes ; ctx.update(_t_buf.get(),cnt) ; }
+			else if (cnt==0) break ;
+			else switch (errno) {
+				case EAGAIN :
+				case EINTR  : continue  ;
+				case EISDIR : return No ;
+				default     : throw to_string("I/O error while reading file ",filename) ;
+			}
+		}
+		return res ;
+	}
+
+	Crc::Crc(::string const& filename) {
 		// use low level operations to ensure no time-of-check-to time-of-use hasards
 		*this = None ;
 		if ( AutoCloseFd fd = ::open(filename.c_str(),O_RDONLY|O_NOFOLLOW|O_CLOEXEC) ; +fd ) {
-			switch (algo) {
-				case Algo::Md5 : {
-					Md5  ctx       { FileTag::Reg } ;
-					bool has_data  = false          ;
-					char buf[4096] ;
-					for(;;) {
-						ssize_t cnt = ::read( fd , buf , sizeof(buf) ) ;
-						if      (cnt> 0) { has_data = true ; ctx.update(buf,cnt) ; }
-						else if (cnt==0) break ;
-						else switch (errno) {
-							case EAGAIN :
-							case EINTR  : continue ;
-							case EISDIR : return   ;
-							default     : throw to_string("I/O error while reading file ",filename) ;
-						}
-					}
-					if (has_data) *this = ::move(ctx).digest() ;
-					else          *this = Empty                ;
-				} break ;
-				case Algo::Xxh : {
-					Xxh  ctx       { FileTag::Reg } ;
-					bool has_data  = false          ;
-					char buf[4096] ;
-					for(;;) {
-						ssize_t cnt = ::read( fd , buf , sizeof(buf) ) ;
-						if      (cnt> 0) { has_data = true ; ctx.update(buf,cnt) ; }
-						else if (cnt==0) break ;
-						else switch (errno) {
-							case EAGAIN :
-							case EINTR  : continue ;
-							default     : throw to_string("I/O error while reading file ",filename) ;
-						}
-					}
-					if (has_data) *this = ctx.digest() ;
-					else          *this = Empty        ;
-				} break ;
+			Xxh ctx { FileTag::Reg } ;
+			switch (_update_from_fd(ctx,fd,filename)) {
+				case No    :                        break ;
+				case Maybe : *this = Empty        ; break ;
+				case Yes   : *this = ctx.digest() ; break ;
 			DF}
 		} else if ( ::string lnk_target = read_lnk(filename) ; +lnk_target ) {
-			switch (algo) { //!                            vvvvvvvvvvvvvvvvvvvvvv           vvvvvvvvvvvvvvvvvvvv
-				case Algo::Md5 : { Md5 ctx{FileTag::Lnk} ; ctx.update(lnk_target) ; *this = ::move(ctx).digest() ; } break ;
-				case Algo::Xxh : { Xxh ctx{FileTag::Lnk} ; ctx.update(lnk_target) ; *this =        ctx .digest() ; } break ;
-			DF} //!                                        ^^^^^^^^^^^^^^^^^^^^^^           ^^^^^^^^^^^^^^^^^^^^
+			Xxh ctx { FileTag::Lnk } ;
+			ctx.update(lnk_target) ;
+			*this = ctx.digest() ;
 		}
 	}
 
+	::vector<Crc> Crc::s_batch( ::vector_s const& files , ::vector<FileSig>* sigs , size_t n_threads ) {
+		::vector<Crc> res ( files.size() ) ;
+		if (sigs) sigs->resize(files.size()) ;
+		if (!n_threads             ) n_threads = ::min( size_t(::thread::hardware_concurrency()) , size_t(8) ) ;
+		if ( n_threads>files.size()) n_threads = files.size()                                                 ;
+		if (!n_threads             ) n_threads = 1                                                            ;
+		//
+		::atomic<size_t> next = 0 ;
+		auto func = [&]()->void {
+			for( size_t i ; (i=next++)<files.size() ;) {
+				FileSig sig ;
+				try                     { res[i] = Crc(sig/*out*/,files[i]) ; }
+				catch (::string const&) {                                     } // crc is left Unknown
+				if (sigs) (*sigs)[i] = sig ;
+			}
+		} ;
+		{	::vector<::jthread> threads ; threads.reserve(n_threads-1) ;
+			for( size_t t=1 ; t<n_threads ; t++ ) threads.emplace_back(func) ;
+			func() ;                                                            // current thread participates, others are joined when threads is destroyed
+		}
+		return res ;
+	}
+
 	Crc::operator ::string() const {
 		::string res ; res.reserve(sizeof(_val)*2) ;
 		for( size_t i=0 ; i<sizeof(_val) ; i++ ) {
@@ -99,153 +116,28 @@ namespace Hash {
 	}
 
 	//
-	// _Md5
-	// reimplement md5 as crypt lib crashes when freeing resources at exit
+	// Crc128
 	//
 
-	_Md5::_Md5() : _hash{0x67452301,0xefcdab89,0x98badcfe,0x10325476} , _cnt{0} {}
-
-	void _Md5::_update( const void* p , size_t sz ) {
-		FAIL() ;                                             // XXX : suppress md5 code altogether
-		const uint8_t* pi = static_cast<const uint8_t*>(p) ;
-		SWEAR(!_closed) ;
-		if (!sz) return ;                                    // memcpy is declared with non-null pointers and p may be nullptr if sz==0, otherwise fast path
-		// if first block is already partially filled, it must be handled specially
-		uint32_t offset = _cnt & (sizeof(_blk)-1) ;
-		_cnt += sz ;
-		if (offset) {
-			uint32_t avail = sizeof(_blk) - offset   ;
-			uint32_t cnt   = ::min(sz,size_t(avail)) ;
-			memcpy( _bblk()+offset , pi , cnt ) ;
-			if (sz<avail) return ;
-			//vvvvvvv
-			_update64() ;
-			//^^^^^^^
-			sz -= cnt ;
-			pi += cnt ;
-		}
-		// core loop : 2 versions whether we are lucky with properly aligned pi or not
-		// note that when used with a mapped file (the practical case where we have big data), pi *is* properly aligned
-		const uint8_t* sentinel     = pi + sz - sizeof(_blk) ;
-		bool           p_is_aligned = (reinterpret_cast<uintptr_t>(pi)&(sizeof(uint32_t)-1))==0 ;
-		//                                                                                            vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-		if (p_is_aligned) for(; pi<=sentinel ; pi+=sizeof(_blk) ) {                                   _update64(reinterpret_cast<const uint32_t*>(pi)) ; }
-		else              for(; pi<=sentinel ; pi+=sizeof(_blk) ) { memcpy(_bblk(),pi,sizeof(_blk)) ; _update64(                                     ) ; }
-		//                                                                                            ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-		// fill last partial block if necessary
-		sz = sentinel + sizeof(_blk) - pi ;
-		if (sz) memcpy( _bblk() , pi , sz ) ;
+	::ostream& operator<<( ::ostream& os , Crc128 const crc ) {
+		return os << "Crc128(" << ::string(crc) << ')' ;
 	}
 
-	Crc _Md5::digest() && {                                        // XXX : suppress md5 code altogether
-		if (!_closed) {                                            // this way, operator() can be called several times (but then no update possible)
-			if (+_salt) _update( _salt.c_str() , _salt.size() ) ;
-			uint32_t offset = _cnt & (sizeof(_blk)-1)   ;
-			uint8_t* bp     = _bblk() + offset          ;
-			uint32_t avail  = sizeof(_blk) - (offset+1) ;          // _blk is never full, so this is always >=0
-			SWEAR( _salt.size()<0x80 , _salt.size() ) ;
-			*bp++ = 0x80 + _salt.size() ;                          // if _salt is empty, it is plain md5, else it is guaranteed different than plain md5
-			if (avail<sizeof(uint64_t)) {
-				memset( bp , 0 , avail ) ;
-				//vvvvvvvvv
-				_update64() ;
-				//^^^^^^^^^
-				bp    = _bblk()      ;
-				avail = sizeof(_blk) ;
-			}
-			memset( bp , 0 , avail-sizeof(uint64_t) ) ;
-			reinterpret_cast<uint64_t&>(_blk[BlkSz-2]) = _cnt<<3 ; // append message length in bits
-			//vvvvvvvvv
-			_update64() ;
-			//^^^^^^^^^
-			_closed = true ;
+	Crc128::Crc128(::string const& filename) {
+		if ( AutoCloseFd fd = ::open(filename.c_str(),O_RDONLY|O_NOFOLLOW|O_CLOEXEC) ; +fd ) {
+			Xxh ctx { FileTag::Reg } ;
+			if (_update_from_fd(ctx,fd,filename)!=No) *this = ctx.digest128() ;
 		}
-		return { *reinterpret_cast<uint64_t const*>(_hash) , is_lnk } ;
 	}
 
-	static void _round1( uint32_t& a , uint32_t b , uint32_t c , uint32_t d , uint32_t m , int s ) { a = b + ::rotl( ((b&c)|((~b)&d)) + a + m , s ) ; }
-	static void _round2( uint32_t& a , uint32_t b , uint32_t c , uint32_t d , uint32_t m , int s ) { a = b + ::rotl( ((d&b)|((~d)&c)) + a + m , s ) ; }
-	static void _round3( uint32_t& a , uint32_t b , uint32_t c , uint32_t d , uint32_t m , int s ) { a = b + ::rotl( (b^c^d         ) + a + m , s ) ; }
-	static void _round4( uint32_t& a , uint32_t b , uint32_t c , uint32_t d , uint32_t m , int s ) { a = b + ::rotl( (c^(b|(~d))    ) + a + m , s ) ; }
-	//
-	void _Md5::_update64(const uint32_t _data[BlkSz]) {
-		uint32_t a = _hash[0] ;
-		uint32_t b = _hash[1] ;
-		uint32_t c = _hash[2] ;
-		uint32_t d = _hash[3] ;
-		//
-		_round1( a , b , c , d , _data[ 0] + 0xd76aa478 ,  7 ) ;
-		_round1( d , a , b , c , _data[ 1] + 0xe8c7b756 , 12 ) ;
-		_round1( c , d , a , b , _data[ 2] + 0x242070db , 17 ) ;
-		_round1( b , c , d , a , _data[ 3] + 0xc1bdceee , 22 ) ;
-		_round1( a , b , c , d , _data[ 4] + 0xf57c0faf ,  7 ) ;
-		_round1( d , a , b , c , _data[ 5] + 0x4787c62a , 12 ) ;
-		_round1( c , d , a , b , _data[ 6] + 0xa8304613 , 17 ) ;
-		_round1( b , c , d , a , _data[ 7] + 0xfd469501 , 22 ) ;
-		_round1( a , b , c , d , _data[ 8] + 0x698098d8 ,  7 ) ;
-		_round1( d , a , b , c , _data[ 9] + 0x8b44f7af , 12 ) ;
-		_round1( c , d , a , b , _data[10] + 0xffff5bb1 , 17 ) ;
-		_round1( b , c , d , a , _data[11] + 0x895cd7be , 22 ) ;
-		_round1( a , b , c , d , _data[12] + 0x6b901122 ,  7 ) ;
-		_round1( d , a , b , c , _data[13] + 0xfd987193 , 12 ) ;
-		_round1( c , d , a , b , _data[14] + 0xa679438e , 17 ) ;
-		_round1( b , c , d , a , _data[15] + 0x49b40821 , 22 ) ;
-		//
-		_round2( a , b , c , d , _data[ 1] + 0xf61e2562 ,  5 ) ;
-		_round2( d , a , b , c , _data[ 6] + 0xc040b340 ,  9 ) ;
-		_round2( c , d , a , b , _data[11] + 0x265e5a51 , 14 ) ;
-		_round2( b , c , d , a , _data[ 0] + 0xe9b6c7aa , 20 ) ;
-		_round2( a , b , c , d , _data[ 5] + 0xd62f105d ,  5 ) ;
-		_round2( d , a , b , c , _data[10] + 0x02441453 ,  9 ) ;
-		_round2( c , d , a , b , _data[15] + 0xd8a1e681 , 14 ) ;
-		_round2( b , c , d , a , _data[ 4] + 0xe7d3fbc8 , 20 ) ;
-		_round2( a , b , c , d , _data[ 9] + 0x21e1cde6 ,  5 ) ;
-		_round2( d , a , b , c , _data[14] + 0xc33707d6 ,  9 ) ;
-		_round2( c , d , a , b , _data[ 3] + 0xf4d50d87 , 14 ) ;
-		_round2( b , c , d , a , _data[ 8] + 0x455a14ed , 20 ) ;
-		_round2( a , b , c , d , _data[13] + 0xa9e3e905 ,  5 ) ;
-		_round2( d , a , b , c , _data[ 2] + 0xfcefa3f8 ,  9 ) ;
-		_round2( c , d , a , b , _data[ 7] + 0x676f02d9 , 14 ) ;
-		_round2( b , c , d , a , _data[12] + 0x8d2a4c8a , 20 ) ;
-		//
-		_round3( a , b , c , d , _data[ 5] + 0xfffa3942 ,  4 ) ;
-		_round3( d , a , b , c , _data[ 8] + 0x8771f681 , 11 ) ;
-		_round3( c , d , a , b , _data[11] + 0x6d9d6122 , 16 ) ;
-		_round3( b , c , d , a , _data[14] + 0xfde5380c , 23 ) ;
-		_round3( a , b , c , d , _data[ 1] + 0xa4beea44 ,  4 ) ;
-		_round3( d , a , b , c , _data[ 4] + 0x4bdecfa9 , 11 ) ;
-		_round3( c , d , a , b , _data[ 7] + 0xf6bb4b60 , 16 ) ;
-		_round3( b , c , d , a , _data[10] + 0xbebfbc70 , 23 ) ;
-		_round3( a , b , c , d , _data[13] + 0x289b7ec6 ,  4 ) ;
-		_round3( d , a , b , c , _data[ 0] + 0xeaa127fa , 11 ) ;
-		_round3( c , d , a , b , _data[ 3] + 0xd4ef3085 , 16 ) ;
-		_round3( b , c , d , a , _data[ 6] + 0x04881d05 , 23 ) ;
-		_round3( a , b , c , d , _data[ 9] + 0xd9d4d039 ,  4 ) ;
-		_round3( d , a , b , c , _data[12] + 0xe6db99e5 , 11 ) ;
-		_round3( c , d , a , b , _data[15] + 0x1fa27cf8 , 16 ) ;
-		_round3( b , c , d , a , _data[ 2] + 0xc4ac5665 , 23 ) ;
-		//
-		_round4( a , b , c , d , _data[ 0] + 0xf4292244 ,  6 ) ;
-		_round4( d , a , b , c , _data[ 7] + 0x432aff97 , 10 ) ;
-		_round4( c , d , a , b , _data[14] + 0xab9423a7 , 15 ) ;
-		_round4( b , c , d , a , _data[ 5] + 0xfc93a039 , 21 ) ;
-		_round4( a , b , c , d , _data[12] + 0x655b59c3 ,  6 ) ;
-		_round4( d , a , b , c , _data[ 3] + 0x8f0ccc92 , 10 ) ;
-		_round4( c , d , a , b , _data[10] + 0xffeff47d , 15 ) ;
-		_round4( b , c , d , a , _data[ 1] + 0x85845dd1 , 21 ) ;
-		_round4( a , b , c , d , _data[ 8] + 0x6fa87e4f ,  6 ) ;
-		_round4( d , a , b , c , _data[15] + 0xfe2ce6e0 , 10 ) ;
-		_round4( c , d , a , b , _data[ 6] + 0xa3014314 , 15 ) ;
-		_round4( b , c , d , a , _data[13] + 0x4e0811a1 , 21 ) ;
-		_round4( a , b , c , d , _data[ 4] + 0xf7537e82 ,  6 ) ;
-		_round4( d , a , b , c , _data[11] + 0xbd3af235 , 10 ) ;
-		_round4( c , d , a , b , _data[ 2] + 0x2ad7d2bb , 15 ) ;
-		_round4( b , c , d , a , _data[ 9] + 0xeb86d391 , 21 ) ;
-		//
-		_hash[0] += a ;
-		_hash[1] += b ;
-		_hash[2] += c ;
-		_hash[3] += d ;
+	Crc128::operator ::string() const {
+		::string res ; res.reserve(sizeof(hi)*4) ;
+		for( uint64_t v : {hi,lo} )
+			for( size_t i=0 ; i<sizeof(v) ; i++ ) {
+				uint8_t b = v>>(i*8) ;
+				for( uint8_t d : {b>>4,b&0xf} ) res.push_back( d<10 ? '0'+d : 'a'+d-10 ) ;
+			}
+		return res ;
 	}
 
 	//
@@ -271,7 +163,8 @@ namespace Hash {
 		DF}
 	}
 
-	void _Xxh::_update ( const void* p , size_t sz )       {          XXH3_64bits_update(&_state,p,sz) ;            }
-	Crc  _Xxh::digest  (                           ) const { return { XXH3_64bits_digest(&_state     ) , is_lnk } ; }
+	void   _Xxh::_update  ( const void* p , size_t sz )       { XXH3_64bits_update(&_state,p,sz) ; }
+	Crc    _Xxh::digest   (                           ) const {                                                  return { XXH3_64bits_digest(&_state) , is_lnk } ; }
+	Crc128 _Xxh::digest128(                           ) const { XXH128_hash_t h = XXH3_128bits_digest(&_state) ; return { h.high64 , h.low64                   } ; }
 
 }
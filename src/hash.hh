@@ -20,11 +20,6 @@
 
 // ENUM macro does not work inside namespace's
 
-ENUM(Algo
-,	Md5
-,	Xxh
-)
-
 ENUM_1( CrcSpecial
 ,	Valid = None   // >=Valid means value represent file content, >Val means that in addition, file exists
 ,	Unknown        // file is completely unknown
@@ -37,12 +32,10 @@ ENUM_1( CrcSpecial
 
 namespace Hash {
 
-	struct _Md5 ;
 	struct _Xxh ;
 
 	template<class H> struct _Cooked ;
 
-	using Md5 = _Cooked<_Md5> ;
 	using Xxh = _Cooked<_Xxh> ;
 
 	//
@@ -78,12 +71,16 @@ namespace Hash {
 				case FileTag::Empty : *this = Crc::Empty ; break ;
 			DF}
 		}
-		Crc(                             ::string const& filename , Algo a ) ;
-		Crc( Disk::FileSig&/*out*/ sig , ::string const& filename , Algo a ) {
+		Crc(                             ::string const& filename ) ;
+		Crc( Disk::FileSig&/*out*/ sig , ::string const& filename ) {
 			sig   = Disk::FileSig(filename) ;
-			*this = Crc(filename,a)         ;
+			*this = Crc(filename)           ;
 			if (Disk::FileSig(filename)!=sig) *this = Crc(sig.tag()) ; // file was moving, association date<=>crc is not reliable
 		}
+		// compute crcs of a lot of files at once, files are spread over n_threads threads (0 means automatic), each reusing its read buffer
+		// if sigs is provided, it is filled with the sig associated with each crc as with the constructor above
+		// crc is left Unknown for files that cannot be read
+		static ::vector<Crc> s_batch( ::vector_s const& files , ::vector<Disk::FileSig>*/*out*/ sigs=nullptr , size_t n_threads=0 ) ;
 	private :
 		constexpr Crc( CrcSpecial special ) : _val{+special} {}
 		//
@@ -112,10 +109,31 @@ namespace Hash {
 	} ;
 
 	//
-	// Md5
+	// Crc128
+	//
+
+	// 128 bits digest, used where collisions must be excluded even with a very large number of files (e.g. content addressed caches)
+	struct Crc128 {
+		friend ::ostream& operator<<( ::ostream& , Crc128 const ) ;
+		// cxtors & casts
+		Crc128(                          ) = default ;
+		Crc128( uint64_t h , uint64_t l  ) : hi{h} , lo{l} {}
+		Crc128( ::string const& filename ) ;                             // content of regular file, stays null if not a regular file
+		explicit operator ::string() const ;
+		// accesses
+		bool operator==(Crc128 const&) const = default ;
+		bool operator+ (             ) const { return hi||lo  ; }
+		bool operator! (             ) const { return !+*this ; }
+		// data
+		uint64_t hi = 0 ;
+		uint64_t lo = 0 ;
+	} ;
+
+	//
+	// Xxh
 	//
 
-	// class to compute Crc's (md5)
+	// class to compute Crc's (xxh3)
 	// Construct without arg.
 	// Call update with :
 	// - An arg
@@ -131,31 +149,6 @@ namespace Hash {
 	template<class K        > struct IsUnstableIterableHelper<::uset<K  >> { static constexpr bool value = true ; } ; // .
 	template<class T> concept IsUnstableIterable = IsUnstableIterableHelper<T>::value ;
 
-	struct _Md5 {
-		static constexpr size_t HashSz =  4 ;
-		static constexpr size_t BlkSz  = 16 ;
-		// cxtors & cast
-	protected :
-		_Md5(           ) ;
-		_Md5(FileTag tag) : is_lnk{tag==FileTag::Lnk} { if (tag!=FileTag::Reg) _salt = to_string(tag) ; }
-		// services
-		void _update( const void* p , size_t sz ) ;
-		Crc  digest (                           ) && ; // context is no more usable once digest has been asked
-	private :
-		void     _update64(const uint32_t _data[BlkSz]) ;
-		void     _update64(                           ) { _update64(_blk) ;                         }
-		uint8_t* _bblk    (                           ) { return reinterpret_cast<uint8_t*>(_blk) ; }
-		// data
-	public :
-		bool is_lnk = false ;
-	private :
-		alignas(uint64_t) uint32_t _hash[HashSz] ;     // alignment to allow direct appending of _cnt<<3 (message length in bits)
-		uint32_t                   _blk [BlkSz ] ;
-		uint64_t                   _cnt          ;
-		::string                   _salt         ;
-		bool                       _closed       = false ;
-	} ;
-
 	struct _Xxh {
 	private :
 		static void _s_init_lnk() { Lock lock{_s_inited_mutex} ; if (_s_lnk_inited) return ; XXH3_generateSecret(_s_lnk_secret,sizeof(_s_lnk_secret),"lnk",3) ; _s_lnk_inited = true ; }
@@ -174,8 +167,9 @@ namespace Hash {
 		_Xxh           (_Xxh const&) = delete ;
 		_Xxh& operator=(_Xxh const&) = delete ;
 		// services
-		void _update( const void* p , size_t sz ) ;
-		Crc  digest (                           ) const ;
+		void   _update  ( const void* p , size_t sz ) ;
+		Crc    digest   (                           ) const ;
+		Crc128 digest128(                           ) const ;  // same state provides both digests
 		// data
 	public :
 		bool is_lnk = false ;
@@ -190,7 +184,8 @@ namespace Hash {
 		_Cooked(FileTag t) : H{t} {}
 		template<class... As> _Cooked( As&&... args) { update(::forward<As>(args)...) ; }
 		// services
-		using H::digest ;
+		using H::digest    ;
+		using H::digest128 ;
 		//
 		template<_AutoCooked T> _Cooked& update( T const* p , size_t sz ) {
 			H::_update( p , sizeof(*p)*sz ) ;
@@ -18,6 +18,13 @@
 
 #include "autodep/gather.hh"
 
+// job_exec may be launched in 2 ways :
+// - to execute a single job, in which case it connects to server to get job description, runs it and connects to server to report end of job
+// - as a worker (cf. local backend n_workers), in which case it forks a process for each job in advance, reports its pid on stdout, and
+//   this process reads its job assignment on stdin, reusing a persistent connection to server
+//   this saves exec, init and connection costs that dominate for short jobs
+// in both cases, all requests to server (start, mngt & end) are sent on a single connection
+
 using namespace Disk ;
 using namespace Hash ;
 using namespace Re   ;
@@ -44,14 +51,13 @@ struct PatternDict {
 
 Gather         g_gather        ;
 JobRpcReply    g_start_info    ;
-::string       g_service_start ;
-::string       g_service_mngt  ;
-::string       g_service_end   ;
+::string       g_service       ;
 SeqId          g_seq_id        = 0/*garbage*/ ;
 JobIdx         g_job           = 0/*garbage*/ ;
 PatternDict    g_match_dct     ;
 NfsGuard       g_nfs_guard     ;
 ::vector_s     g_washed        ;
+Fd             g_server_fd     ; // connection to server on which all requests are sent, owned by worker if run by a worker
 
 ::map_ss prepare_env(JobRpcReq& end_report) {
 	::map_ss res ;
@@ -232,52 +238,125 @@ Digest analyze( bool at_end , bool killed=false ) {
 	return cmd_line ;
 }
 
-void crc_thread_func( size_t id , vmap_s<TargetDigest>* targets , ::vector<NodeIdx> const* crcs , ::string* msg , Mutex<MutexLvl::JobExec>* msg_mutex ) {
-	static ::atomic<NodeIdx> crc_idx = 0 ;
-	t_thread_key = '0'+id ;
-	Trace trace("crc",targets->size(),crcs->size()) ;
-	NodeIdx cnt = 0 ;                                           // cnt is for trace only
-	for( NodeIdx ci=0 ; (ci=crc_idx++)<crcs->size() ; cnt++ ) {
-		::pair_s<TargetDigest>& e      = (*targets)[(*crcs)[ci]] ;
-		Pdate                   before = New                     ;
-		e.second.crc = Crc( e.second.sig/*out*/ , e.first , g_start_info.hash_algo ) ;
-		trace("crc_date",ci,before,Pdate(New)-before,e.second.crc,e.second.sig,e.first) ;
-		if (!e.second.crc.valid()) {
-			Lock lock{*msg_mutex} ;
-			append_to_string(*msg,"cannot compute crc for ",e.first) ;
+// crcs of written targets are computed while job runs so that most of them are available when it ends
+// as we do not see files being closed, a file is hashed once its sig has not moved for EarlyCrcs::StableDelay
+// each crc is recorded along with the sig it corresponds to and is only used at end of job if file has not been modified since
+// a crc is only recorded if hashing ended at least date_prec after file date, else a further write could leave sig unchanged
+struct EarlyCrcs {
+	static constexpr Delay StableDelay { 0.1 } ;                     // a file is deemed closed if it has not moved for this long
+	struct Entry {
+		FileSig sig    ;                                             // sig as last seen
+		Crc     crc    ;                                             // crc corresponding to sig, if valid
+		bool    target = false ;                                     // only targets are hashed, matching is done once per file as it is costly
+		bool    queued = false ;
+	} ;
+	// services
+	void start() { _thread.emplace( 'E' , [&](::string&& f)->void { _process(::move(f)) ; } ) ; }
+	void stop () { _thread.reset() ;                                                            } // wait for on-going crc computation, if any
+	void push( ::string const& file , ::function<bool(::string const&)> const& is_target ) {
+		if (!_thread) return ;
+		{	Lock lock { _mutex } ;
+			if ( auto it=_entries.find(file) ; it!=_entries.end() ) { _queue(file,it->second) ; return ; } // fast path : file already seen
 		}
+		bool target = is_target(file) ;                              // match out of lock
+		Lock lock { _mutex } ;
+		auto [it,inserted] = _entries.try_emplace(file) ;
+		if (inserted) it->second.target = target ;
+		_queue(file,it->second) ;
 	}
-	trace("done",cnt) ;
-}
+	Crc get( FileSig&/*out*/ sig , ::string const& file ) const {    // return an invalid crc if no valid early crc is available
+		Lock lock { _mutex } ;
+		auto it = _entries.find(file) ;
+		if ( it==_entries.end() || !it->second.crc.valid() ) return {} ;
+		sig = FileSig(file) ;
+		if (sig!=it->second.sig                            ) return {} ;
+		return it->second.crc ;
+	}
+private :
+	void _queue( ::string const& file , Entry& e ) {                 // _mutex must be locked
+		if ( !e.target || e.queued ) return ;
+		e.queued = true ;
+		_thread->push_after(StableDelay,file) ;
+	}
+	void _process(::string&& file) {
+		FileSig sig { file } ;
+		{	Lock   lock { _mutex }       ;
+			Entry& e    = _entries[file] ;
+			if ( sig==e.sig && e.crc.valid() ) { e.queued = false ; return ; }                    // already done
+			if ( !sig || sig!=e.sig ) {                                                          // file is moving or absent, retry later unless absent (a further write will requeue it)
+				e.sig = sig ;
+				e.crc = {}  ;
+				if (+sig) _thread->push_after(StableDelay,file) ;
+				else      e.queued = false ;
+				return ;
+			}
+		}
+		Crc crc ;
+		try                     { crc = Crc( sig/*out*/ , file ) ; } // sig is updated in case file was moving while computing crc
+		catch (::string const&) {                                  } // crc will be computed at end of job and error reported then
+		Pdate    hashed { New  } ;
+		FileInfo fi     { file } ;
+		bool     recent = fi.sig()==sig && !fi.date.avail_at(hashed,g_start_info.date_prec) ;    // a write after hashing may not be seen, retry once date is old enough
+		Trace trace("early_crc",crc,sig,STR(recent),file) ;
+		Lock   lock { _mutex }       ;
+		Entry& e    = _entries[file] ;
+		e.sig = sig ;
+		if (recent) {
+			e.crc = {} ;
+			_thread->push_after( ::max(StableDelay,g_start_info.date_prec) , file ) ;
+		} else {
+			e.crc    = crc   ;
+			e.queued = false ;
+		}
+	}
+	// data
+	Mutex<MutexLvl::JobExec> mutable  _mutex   ;
+	::umap_s<Entry>                   _entries ;
+	::optional<QueueThread<::string>> _thread  ;                     // must be last so it is destroyed first
+} ;
+
+EarlyCrcs g_early_crcs ;
 
 ::string compute_crcs(Digest& digest) {
-	size_t                            n_threads = thread::hardware_concurrency() ;
-	if (n_threads<1                 ) n_threads = 1                              ;
-	if (n_threads>8                 ) n_threads = 8                              ;
-	if (n_threads>digest.crcs.size()) n_threads = digest.crcs.size()             ;
-	//
-	Trace trace("compute_crcs",digest.crcs.size(),n_threads) ;
-	::string msg       ;
-	Mutex<MutexLvl::JobExec> msg_mutex ;
-	{	::vector<jthread> crc_threads ; crc_threads.reserve(n_threads) ;
-		for( size_t i=0 ; i<n_threads ; i++ )
-			crc_threads.emplace_back( crc_thread_func , i , &digest.targets , &digest.crcs , &msg , &msg_mutex ) ; // just constructing and destructing the threads will execute & join them
+	Trace trace("compute_crcs",digest.crcs.size()) ;
+	::string          msg   ;
+	::vector<NodeIdx> todo  ;                                           // index in digest.targets of entries for which no early crc is available
+	::vector_s        files ;                                           // corresponding file names
+	for( NodeIdx ti : digest.crcs ) {
+		::pair_s<TargetDigest>& e = digest.targets[ti] ;
+		e.second.crc = g_early_crcs.get( e.second.sig/*out*/ , e.first ) ;
+		if (e.second.crc.valid()) {
+			trace("early_crc",e.second.crc,e.second.sig,e.first) ;
+		} else {
+			todo .push_back(ti     ) ;
+			files.push_back(e.first) ;
+		}
+	}
+	::vector<FileSig> sigs ;
+	::vector<Crc>     crcs = Crc::s_batch( files , &sigs ) ;
+	for( size_t i=0 ; i<todo.size() ; i++ ) {
+		TargetDigest& td = digest.targets[todo[i]].second ;
+		td.crc = crcs[i] ;
+		td.sig = sigs[i] ;
+		trace("crc",td.crc,td.sig,files[i]) ;
+		if (!td.crc.valid()) append_to_string(msg,"cannot compute crc for ",files[i]) ;
 	}
 	return msg ;
 }
 
-int main( int argc , char* argv[] ) {
-	Pdate        start_overhead = Pdate(New) ;
-	ServerSockFd server_fd      { New }      ;       // server socket must be listening before connecting to server and last to the very end to ensure we can handle heartbeats
-	//
-	swear_prod(argc==8,argc) ;                       // syntax is : job_exec server:port/*start*/ server:port/*mngt*/ server:port/*end*/ seq_id job_idx root_dir trace_file
-	g_service_start =                     argv[1]  ;
-	g_service_mngt  =                     argv[2]  ;
-	g_service_end   =                     argv[3]  ;
-	g_seq_id        = from_string<SeqId >(argv[4]) ;
-	g_job           = from_string<JobIdx>(argv[5]) ;
-	g_root_dir      = new ::string       (argv[6]) ; // passed early so we can chdir and trace early
-	g_trace_file    = new ::string       (argv[7]) ; // .
+static AutoCloseFd _g_own_server_fd ; // connection to server if not run by a worker
+
+// connect to server if not already done, which is the case if run by a worker
+static Fd _server_fd() {
+	if (!g_server_fd) {
+		_g_own_server_fd = ClientSockFd(g_service,NConnectionTrials) ;
+		g_server_fd      = _g_own_server_fd                          ;
+	}
+	return g_server_fd ;
+}
+
+static int _exec_job(Pdate start_overhead) {
+	ServerSockFd server_fd { New } ; // server socket must be listening before connecting to server and last to the very end to ensure we can handle heartbeats
 	//
 	JobRpcReq end_report { JobProc::End , g_seq_id , g_job , {.status=Status::EarlyErr,.end_date=start_overhead} } ; // prepare to return an error, so we can goto End anytime
 	//
@@ -285,32 +364,37 @@ int main( int argc , char* argv[] ) {
 		append_to_string(end_report.msg,"cannot chdir to root : ",*g_root_dir) ;
 		goto End ;
 	}
-	Trace::s_sz = 10<<20 ;        // this is more than enough
-	unlnk(*g_trace_file) ;        // ensure that if another job is running to the same trace, its trace is unlinked to avoid clash
-	app_init(No/*chk_version*/) ;
+	Trace::s_sz = 10<<20 ;          // this is more than enough
+	unlnk(*g_trace_file) ;          // ensure that if another job is running to the same trace, its trace is unlinked to avoid clash
+	if (+g_server_fd) Trace::s_new_trace_file(*g_trace_file) ;
+	else              app_init(No/*chk_version*/) ;
 	{
-		Trace trace("main",Pdate(New),::vector_view(argv,8)) ;
+		Trace trace("exec_job",Pdate(New),g_seq_id,g_job,STR(+g_server_fd)) ;
 		trace("pid",::getpid(),::getpgrp()) ;
 		trace("start_overhead",start_overhead) ;
 		//
-		bool         found_server = false ;
+		bool found_server = false ;
 		try {
-			ClientSockFd fd {g_service_start,NConnectionTrials} ;
+			Fd fd = _server_fd() ;
 			found_server = true ;
-			//             vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-			/**/           OMsgBuf().send                ( fd , JobRpcReq{JobProc::Start,g_seq_id,g_job,server_fd.port()} ) ;
-			g_start_info = IMsgBuf().receive<JobRpcReply>( fd                                                             ) ;
-			//             ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+			//             vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+			/**/           OMsgBuf().send                ( fd , JobMuxRpcReq(JobRpcReq{JobProc::Start,g_seq_id,g_job,server_fd.port()}) ) ;
+			g_start_info = IMsgBuf().receive<JobRpcReply>( fd                                                                           ) ;
+			//             ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 		} catch (::string const& e) {
-			trace("no_server",g_service_start,STR(found_server),e) ;
-			if (found_server) exit(Rc::Fail                                                          ) ; // this is typically a ^C
-			else              exit(Rc::Fail,"cannot communicate with server ",g_service_start," : ",e) ; // this may be a server config problem, better to report
+			trace("no_server",g_service,STR(found_server),e) ;
+			if (found_server) exit(Rc::Fail                                                    ) ; // this is typically a ^C
+			else              exit(Rc::Fail,"cannot communicate with server ",g_service," : ",e) ; // this may be a server config problem, better to report
 		}
 		trace("g_start_info",g_start_info) ;
 		switch (g_start_info.proc) {
 			case JobProc::None  : return 0 ;                                                             // server ask us to give up
 			case JobProc::Start : break    ;                                                             // normal case
 		DF}
+		if (!g_start_info.keep_conn) {                                                                   // server is short of fds, connect for each subsequent request
+			g_server_fd = {} ;
+			_g_own_server_fd.close() ;                                                                   // if run by a worker, connection is kept by worker
+		}
 		g_nfs_guard.reliable_dirs = g_start_info.autodep_env.reliable_dirs ;
 		//
 		for( auto const& [d ,digest] : g_start_info.deps           ) if (digest.dflags[Dflag::Static]) g_match_dct.add( false/*star*/ , d  , digest.dflags ) ;
@@ -335,11 +419,14 @@ int main( int argc , char* argv[] ) {
 		g_gather.network_delay    = g_start_info.network_delay ;
 		g_gather.seq_id           = g_seq_id                   ;
 		g_gather.server_master_fd = ::move(server_fd)          ;
-		g_gather.service_mngt     = g_service_mngt             ;
+		g_gather.server_fd        = g_server_fd                ;
+		g_gather.service          = g_service                  ;
 		g_gather.timeout          = g_start_info.timeout       ;
+		g_gather.written_cb       = [](::string const& f)->void { g_early_crcs.push( f , [](::string const& f_)->bool { return g_match_dct.at(f_).is_target==Yes ; } ) ; } ;
+		g_early_crcs.start() ;
 		//
 		trace("wash",g_start_info.pre_actions) ;
-		::pair_s<bool/*ok*/> wash_report = do_file_actions( g_washed , ::move(g_start_info.pre_actions) , g_nfs_guard , g_start_info.hash_algo ) ;
+		::pair_s<bool/*ok*/> wash_report = do_file_actions( g_washed , ::move(g_start_info.pre_actions) , g_nfs_guard ) ;
 		end_report.msg += wash_report.first ;
 		if (!wash_report.second) { end_report.digest.status = Status::LateLostErr ; goto End ; }
 		g_gather.new_deps( start_overhead , ::move(g_start_info.deps) , g_start_info.stdin ) ;
@@ -359,6 +446,7 @@ int main( int argc , char* argv[] ) {
 		//              vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 		Status status = g_gather.exec_child( cmd_line() , child_stdin , child_stdout , Child::Pipe ) ;
 		//              ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		g_early_crcs.stop() ;
 		struct rusage rsrcs ; getrusage(RUSAGE_CHILDREN,&rsrcs) ;
 		//
 		Digest digest = analyze(true/*at_end*/,status==Status::Killed) ;
@@ -396,14 +484,77 @@ int main( int argc , char* argv[] ) {
 End :
 	Trace trace("end",end_report.digest.status) ;
 	try {
-		ClientSockFd fd           { g_service_end , NConnectionTrials } ;
-		Pdate        end_overhead = New                                 ;
+		Fd    fd           = _server_fd() ;                                                             // reconnect if server asked us not to keep connection
+		Pdate end_overhead = New          ;
 		end_report.digest.stats.total = end_overhead - start_overhead ;                                  // measure overhead as late as possible
-		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-		OMsgBuf().send( fd , end_report ) ;
-		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+		OMsgBuf().send( fd , JobMuxRpcReq(::move(end_report)) ) ;
+		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 		trace("done",end_overhead) ;
 	} catch (::string const& e) { exit(Rc::Fail,"after job execution : ",e) ; }
 	//
 	return 0 ;
 }
+
+// a worker runs jobs one after the other, each in its own forked process (as fork is much cheaper than exec)
+// - job process is forked in advance and its pid is reported on stdout, so that backend can hand a job over without waiting for any reply
+// - job process then reads its assignment { seq_id , job_idx , trace_file } on stdin, its pid is what backend manages
+// - the connection to server is reused as long as jobs complete normally, else (typically if killed) a message may have been cut and we reconnect
+static int _worker() {
+	app_init(No/*chk_version*/) ;
+	Trace trace("worker",::getpid()) ;
+	AutoCloseFd server_fd ;
+	for(;;) {
+		if (!server_fd)
+			try                       { server_fd = ClientSockFd(g_service,NConnectionTrials) ; }
+			catch (::string const& e) { trace("no_server",e) ;                                     } // job will connect on its own
+		pid_t pid = ::fork() ;
+		if (pid==0) {                                                                               // in job process
+			::setsid() ;                                                                            // job is managed as a session, as if launched by backend, even before its assignment
+			::vector_s assignment ;
+			try                     { assignment = IMsgBuf().receive<::vector_s>(Fd::Stdin) ; }
+			catch (::string const&) { ::_exit(0) ;                                              } // backend has closed our stdin, we are not needed any more
+			Pdate start_overhead = New ;
+			SWEAR( assignment.size()==3 , assignment ) ;
+			::close(Fd::Stdin ) ;                                                                   // as if launched by backend
+			::close(Fd::Stdout) ;                                                                   // .
+			g_seq_id     = from_string<SeqId >(assignment[0]) ;
+			g_job        = from_string<JobIdx>(assignment[1]) ;
+			g_trace_file = new ::string(assignment[2])        ;
+			g_server_fd  = server_fd                          ;
+			::_exit(_exec_job(start_overhead)) ;                                                    // dont run worker destructors
+		}
+		trace("job",pid) ;
+		try                       { OMsgBuf().send(Fd::Stdout,pid) ;   }                            // message is small enough to be written atomically, backend relies on it
+		catch (::string const& e) { trace("lost_backend",e) ; return 0 ; }                          // job process sees eof on stdin and exits
+		if (pid<0) return 1 ;                                                                       // backend sees the error and retires us
+		int wstatus ;
+		::waitpid(pid,&wstatus,0) ;
+		if ( !WIFEXITED(wstatus) || WEXITSTATUS(wstatus)!=0 ) {
+			trace("reconnect",pid,wstatus) ;
+			server_fd.close() ;
+		}
+	}
+}
+
+int main( int argc , char* argv[] ) {
+	Pdate start_overhead = Pdate(New) ;
+	//
+	set_sig({SIGPIPE},true/*block*/) ;             // server connection is persistent, report errors if it is lost (job is spawned with all signals unblocked)
+	//
+	if (argc==4) {                                 // syntax is : job_exec server:port root_dir trace_file
+		g_service    = argv[1]               ;
+		g_root_dir   = new ::string{argv[2]} ;
+		g_trace_file = new ::string{argv[3]} ;
+		if (::chdir(g_root_dir->c_str())!=0) exit(Rc::System,"cannot chdir to root : ",*g_root_dir) ;
+		unlnk(*g_trace_file) ;
+		return _worker() ;
+	}
+	swear_prod(argc==6,argc) ;                     // syntax is : job_exec server:port seq_id job_idx root_dir trace_file
+	g_service    =                     argv[1]  ;
+	g_seq_id     = from_string<SeqId >(argv[2]) ;
+	g_job        = from_string<JobIdx>(argv[3]) ;
+	g_root_dir   = new ::string       (argv[4]) ; // passed early so we can chdir and trace early
+	g_trace_file = new ::string       (argv[5]) ; // .
+	return _exec_job(start_overhead) ;
+}
@@ -0,0 +1,173 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+// lcache_server : serve a cache dir (in the DirCache format) to repos configured with a daemon cache
+// each client connection is served by its own thread : requests on a connection are served in order, which is what DaemonCache relies on to pipeline match requests
+// DirCache is not thread safe, so accesses to the cache dir are serialized while target contents are streamed without holding the lock
+// a single server must run for a given cache dir as it is the only one to access it, LMAKE/server in the cache dir records it
+
+#include "app.hh"
+#include "process.hh"
+
+#include "lmakeserver/caches/daemon_cache.hh"
+
+using namespace Caches ;
+using namespace Disk   ;
+
+ENUM( EventKind
+,	Master
+,	Int
+)
+
+struct Client {
+	::atomic<bool> done   = false ;
+	::jthread      thread ;
+} ;
+
+static DirCache                     _g_cache ;
+static Mutex<MutexLvl::CacheServer> _g_mutex ; // protects _g_cache
+
+static void _serve_download( Fd fd , CacheRpcReq const& req ) {
+	CacheRpcReply         reply { .proc=req.proc } ;
+	::vector<AutoCloseFd> fds   ;
+	DirCacheCodec         codec = {}               ;
+	try {
+		Lock lock { _g_mutex } ;
+		reply.job_info = _g_cache.get_entry( req.jn , reply.targets , fds , codec ) ;                 // contents are opened under lock, then streamed without
+		reply.ok       = true                                                      ;
+	} catch (::string const& e) {
+		reply.err = e ;
+		reply.targets.clear() ;
+	}
+	OMsgBuf().send(fd,reply) ;
+	if (!reply.ok) return ;
+	for( AutoCloseFd const& tfd : fds ) {
+		if (!tfd) continue ;                                                                           // not a regular file
+		bool ok = true ;
+		try                       { DirCache::s_send_content(fd,tfd,codec) ;                  }
+		catch (::string const& e) { Trace("download_aborted",req.jn,e) ; ok = false ;         }        // if connection is lost, s_send_end fails as well
+		DirCache::s_send_end(fd,ok) ;
+		if (!ok) break ;
+	}
+}
+
+static void _serve_upload( Fd fd , CacheRpcReq const& req ) {
+	CacheRpcReply reply  { .proc=req.proc } ;
+	::vector_s    staged ;
+	::vector_s    xxhs   ;
+	bool          ok     = true             ;
+	try {
+		for( DirCache::EntryTarget const& et : req.targets ) {
+			::string& s = staged.emplace_back() ;
+			::string& x = xxhs  .emplace_back() ;
+			if ( et.tag!=FileTag::Reg && et.tag!=FileTag::Exe ) continue ;
+			s  = _g_cache.recv_target( fd , et.tag==FileTag::Exe , x ) ;
+			ok = +s ;
+			if (!ok) break ;                                                                           // client sends nothing more after an abort
+		}
+		if (ok) {
+			Lock lock { _g_mutex } ;
+			try                       { reply.ok = _g_cache.put_entry( req.jn , req.repo , req.job_info , req.targets , staged , xxhs ) ; }
+			catch (::string const& e) { Trace("upload_failed",req.jn,e) ;                                                               }
+		}
+	} catch (::string const&) {
+		for( ::string const& s : staged ) if (+s) unlnk(s) ;
+		throw ;
+	}
+	for( ::string const& s : staged ) if (+s) unlnk(s) ;                                              // staged contents that have not been moved to entry, e.g. because blob existed
+	OMsgBuf().send(fd,reply) ;
+}
+
+static void _client_thread_func( Fd fd , Client* client ) {
+	t_thread_key = 'C' ;
+	Trace trace("client",fd) ;
+	try {
+		for(;;) {
+			CacheRpcReq req = IMsgBuf().receive<CacheRpcReq>(fd) ;
+			trace("req",req) ;
+			switch (req.proc) {
+				case CacheRpcProc::Match : {
+					CacheRpcReply reply { .proc=req.proc } ;
+					{	Lock lock { _g_mutex } ;
+						for( ::string const& jd : req.job_dirs ) reply.trees.push_back(_g_cache.read_match_tree(jd)) ;
+					}
+					OMsgBuf().send(fd,reply) ;
+				} break ;
+				case CacheRpcProc::Download : _serve_download(fd,req) ; break ;
+				case CacheRpcProc::Upload   : _serve_upload  (fd,req) ; break ;
+			DF}
+		}
+	} catch (::string const& e) {                                                                      // client has gone
+		trace("close",e) ;
+	}
+	client->done = true ;                                                                              // fd is closed by main thread, which may shut it down concurrently
+}
+
+int main( int argc , char* argv[] ) {
+	if ( argc<2 || argc>4 ) exit(Rc::Usage,"syntax : lcache_server cache_dir [compression [blob_key]]") ;
+	::string dir = mk_abs(argv[1],cwd()+'/') ;
+	if (!is_dir(dir)) exit(Rc::Usage,"cache dir ",dir," does not exist") ;
+	//
+	Fd int_fd = open_sig_fd({SIGINT,SIGHUP,SIGTERM}) ;                                     // must be done before app_init so that all threads block the signal
+	set_sig({SIGPIPE},true/*block*/) ;
+	g_root_dir      = new ::string{dir}                                                  ; // cache dir is not a repo, dont search for it
+	g_startup_dir_s = new ::string                                                       ;
+	g_trace_file    = new ::string{to_string(dir,'/',AdminDir,"/trace/lcache_server")} ;
+	app_init(No/*chk_version*/,false/*cd_root*/) ;
+	//
+	try {
+		::map_ss dct { {"dir",dir} } ;
+		if (argc>2) dct["compress"] = argv[2] ;
+		if (argc>3) dct["blob_key"] = argv[3] ;
+		_g_cache.config_dir(dct) ;
+	} catch (::string const& e) { exit(Rc::Usage,e) ; }
+	unlnk( to_string(dir,'/',AdminDir,"/tmp") , true/*dir_ok*/ ) ;                                   // contents staged by a previous run
+	//
+	::string     mrkr      = to_string(dir,'/',CacheServerMrkr) ;
+	ServerSockFd server_fd { New }                               ;
+	{	::vector_s lines = read_lines(mrkr) ;
+		if ( lines.size()>=2 && kill_process(from_string<pid_t>(lines[1]),0) ) exit(Rc::Usage,"cache server already running for ",dir," with pid ",lines[1]) ;
+		::string tmp = to_string(mrkr,'.',getpid()) ;
+		OFStream(tmp)
+			<< server_fd.service() << '\n'
+			<< getpid()            << '\n'
+		;
+		::rename( tmp.c_str() , mrkr.c_str() ) ;
+	}
+	Trace trace("main",dir,server_fd.service()) ;
+	//
+	::umap<Fd,Client> clients ;                                                                       // Client's are neither copyable nor movable
+	Epoll             epoll   { New } ;
+	epoll.add_read( server_fd , EventKind::Master ) ;
+	epoll.add_read( int_fd    , EventKind::Int    ) ;
+	for(;;) {
+		for( Epoll::Event event : epoll.wait() ) {
+			EventKind kind = event.data<EventKind>() ;
+			switch (kind) {
+				case EventKind::Master : {
+					for( auto it=clients.begin() ; it!=clients.end() ;) {                                      // reap clients that have gone
+						if (!it->second.done) { it++ ; continue ; }
+						it->second.thread.join() ;
+						::close(it->first) ;
+						it = clients.erase(it) ;
+					}
+					Fd      fd     = Fd(server_fd.accept()) ;
+					Client& client = clients[fd]            ;
+					client.thread = ::jthread( _client_thread_func , fd , &client ) ;
+					trace("new_client",fd) ;
+				} break ;
+				case EventKind::Int :
+					trace("interrupted") ;
+					goto Done ;
+			DF}
+		}
+	}
+Done :
+	for( auto& [fd,c] : clients ) ::shutdown( fd , SHUT_RDWR ) ;                                     // unblock client threads
+	for( auto& [fd,c] : clients ) { c.thread.join() ; ::close(fd) ; }
+	unlnk(mrkr) ;
+	trace("done") ;
+	return 0 ;
+}
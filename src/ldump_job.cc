@@ -48,12 +48,12 @@ void print_start(JobRpcReply const& jrr) {
 	::cout << "auto_mkdir  : "  << jrr.autodep_env.auto_mkdir  <<'\n' ;
 	::cout << "chroot      : "  << jrr.chroot                  <<'\n' ;
 	::cout << "cwd_s       : "  << jrr.cwd_s                   <<'\n' ;
-	::cout << "hash_algo   : "  << jrr.hash_algo               <<'\n' ;
 	::cout << "ignore_stat : "  << jrr.autodep_env.ignore_stat <<'\n' ;
 	::cout << "interpreter : "  << jrr.interpreter             <<'\n' ;
 	::cout << "kill_sigs   : "  << jrr.kill_sigs               <<'\n' ;
 	::cout << "live_out    : "  << jrr.live_out                <<'\n' ;
 	::cout << "method      : "  << jrr.method                  <<'\n' ;
+	::cout << "shm_report  : "  << jrr.autodep_env.shm_report  <<'\n' ;
 	::cout << "small_id    : "  << jrr.small_id                <<'\n' ;
 	::cout << "stdin       : "  << jrr.stdin                   <<'\n' ;
 	::cout << "stdout      : "  << jrr.stdout                  <<'\n' ;
@@ -93,10 +93,12 @@ void print_end(JobRpcReq const& jrr) {
 }
 
 int main( int argc , char* argv[] ) {
-	if (argc!=2) exit(Rc::Usage,"usage : ldump_job file") ;
+	if ( argc!=2 && argc!=3 ) exit(Rc::Usage,"usage : ldump_job file | ldump_job job_info_dir job_idx") ;
 	app_init() ;
 	//
-	JobInfo job_info { argv[1] } ;
+	JobInfo job_info ;
+	if (argc==2) job_info = JobInfo(argv[1]) ;
+	else         job_info = JobInfoStore(argv[1],false/*writable*/).read(from_string<JobIdx>(argv[2])) ;
 	//
 	::cout << "eta  : " << job_info.start.eta                  <<'\n' ;
 	::cout << "host : " << SockFd::s_host(job_info.start.host) <<'\n' ;
@@ -3,6 +3,8 @@
 // This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
+#include <sys/resource.h>
+
 #include "core.hh"
 
 #include "codec.hh"
@@ -64,18 +66,20 @@ namespace Backends {
 	// Backend
 	//
 
-	::string                          Backend::s_executable              ;
-	Backend*                          Backend::s_tab[N<Tag>]             ;
-	Mutex<MutexLvl::Backend >         Backend::_s_mutex                  ;
-	Mutex<MutexLvl::StartJob>         Backend::_s_starting_job_mutex     ;
-	::atomic<JobIdx>                  Backend::_s_starting_job           ;
-	::map<JobIdx,Backend::StartEntry> Backend::_s_start_tab              ;
-	SmallIds<SmallId>                 Backend::_s_small_ids              ;
-	Backend::JobThread     *          Backend::_s_job_start_thread       = nullptr ;
-	Backend::JobMngtThread *          Backend::_s_job_mngt_thread        = nullptr ;
-	Backend::JobThread     *          Backend::_s_job_end_thread         = nullptr ;
-	Backend::DeferredThread*          Backend::_s_deferred_report_thread = nullptr ;
-	Backend::DeferredThread*          Backend::_s_deferred_wakeup_thread = nullptr ;
+	::string                             Backend::s_executable              ;
+	Backend*                             Backend::s_tab[N<Tag>]             ;
+	Mutex<MutexLvl::Backend >            Backend::_s_mutex                  ;
+	Mutex<MutexLvl::StartJob>            Backend::_s_starting_job_mutex     ;
+	::condition_variable_any             Backend::_s_starting_job_cond      ;
+	::umap<JobIdx,uint8_t>               Backend::_s_starting_jobs          ;
+	::map<JobIdx,Backend::StartEntry>    Backend::_s_start_tab              ;
+	Backend::HeartbeatTab                Backend::_s_heartbeat_tab          ;
+	SmallIds<SmallId,true/*ThreadSafe*/> Backend::_s_small_ids              ;
+	Backend::JobThread     *             Backend::_s_job_thread             = nullptr ;
+	Backend::JobQueue                    Backend::_s_job_queue              ;
+	size_t                               Backend::_s_max_job_conns          = 0 ;
+	Backend::DeferredThread*             Backend::_s_deferred_report_thread = nullptr ;
+	Backend::DeferredThread*             Backend::_s_deferred_wakeup_thread = nullptr ;
 
 	static ::vmap_s<DepDigest> _mk_digest_deps( ::vmap_s<DepSpec>&& deps_attrs ) {
 		::vmap_s<DepDigest> res ; res.reserve(deps_attrs.size()) ;
@@ -209,12 +213,11 @@ namespace Backends {
 			case JobProc::None  : return false ;                       // if connection is lost, ignore it
 			case JobProc::Start : SWEAR(+fd,jrr.proc) ; break ;        // fd is needed to reply
 		DF}
-		Job                                        job               { jrr.job }             ;
-		::string                                   jaf               = job->ancillary_file() ;
+		Job                                        job               { jrr.job }           ;
 		JobExec                                    job_exec          ;
-		Rule                                       rule              = job->rule             ;
-		Rule::SimpleMatch                          match             = job->simple_match()   ;
-		JobRpcReply                                reply             { JobProc::Start }      ;
+		Rule                                       rule              = job->rule           ;
+		Rule::SimpleMatch                          match             = job->simple_match() ;
+		JobRpcReply                                reply             { JobProc::Start }    ;
 		::pair<vmap<Node,FileAction>,vector<Node>> pre_actions       ;
 		StartCmdAttrs                              start_cmd_attrs   ;
 		::pair_ss/*script,call*/                   cmd               ;
@@ -225,9 +228,11 @@ namespace Backends {
 		Pdate                                      eta               ;
 		SubmitAttrs                                submit_attrs      ;
 		::vmap_ss                                  rsrcs             ;
+		::vector<ReqIdx>                           reqs              ;
+		Tag                                        tag               = Tag::Unknown        ;
+		bool                                       keep_tmp          = false/*garbage*/    ;
+		in_addr_t                                  host              = fd.peer_addr()      ;
 		Trace trace(BeChnl,"_s_handle_job_start",jrr) ;
-		_s_starting_job = jrr.job ;
-		Lock lock { _s_starting_job_mutex } ;
 		{	Lock lock { _s_mutex } ;                                   // prevent sub-backend from manipulating _s_start_tab from main thread, lock for minimal time
 			//
 			auto        it    = _s_start_tab.find(+job) ; if (it==_s_start_tab.end()       ) { trace("not_in_tab"                             ) ; return false ; }
@@ -236,183 +241,197 @@ namespace Backends {
 			if (!entry.useful()) { trace("useless") ; return false ; } // no Req found, job has been cancelled but start message still arrives, give up
 			submit_attrs = ::move(entry.submit_attrs) ;
 			rsrcs        =        entry.rsrcs         ;
+			reqs         =        entry.reqs          ;
+			tag          =        entry.tag           ;
 			//                               vvvvvvvvvvvvvvvvvvvvvvv
 			append_line_to_string( jrr.msg , s_start(entry.tag,+job) ) ;
 			//                               ^^^^^^^^^^^^^^^^^^^^^^^
-			::vmap_s<DepDigest>& deps          = submit_attrs.deps ;
-			size_t               n_submit_deps = deps.size()       ;
-			int                  step          = 0                 ;
-			bool                 keep_tmp      = false/*garbage*/  ;
 			tie(eta,keep_tmp) = entry.req_info() ;
-			trace("submit_attrs",submit_attrs) ;
-			deps_attrs = rule->deps_attrs.eval(match) ;                // this cannot fail as it was already run to construct job
-			try {
-				cmd               = rule->cmd              .eval(match,rsrcs,&deps) ; step = 1 ;
-				start_cmd_attrs   = rule->start_cmd_attrs  .eval(match,rsrcs,&deps) ; step = 2 ;
-				start_rsrcs_attrs = rule->start_rsrcs_attrs.eval(match,rsrcs,&deps) ; step = 3 ;
-				//
-				try                       { start_cmd_attrs.chk(start_rsrcs_attrs.method) ; }
-				catch (::string const& e) { throw ::pair_ss/*msg,err*/(e,{}) ;              }
-				step = 4 ;
-				//
-				pre_actions = job->pre_actions( match , true/*mark_target_dirs*/ ) ; step = 5 ;
-			} catch (::pair_ss const& msg_err) {
-				append_line_to_string(start_msg_err.first  , msg_err.first  ) ;
-				append_line_to_string(start_msg_err.second , msg_err.second ) ;
-				switch (step) {
-					case 0 : append_line_to_string( start_msg_err.first , rule->cmd              .s_exc_msg(false/*using_static*/) ) ; break ;
-					case 1 : append_line_to_string( start_msg_err.first , rule->start_cmd_attrs  .s_exc_msg(false/*using_static*/) ) ; break ;
-					case 2 : append_line_to_string( start_msg_err.first , rule->start_rsrcs_attrs.s_exc_msg(false/*using_static*/) ) ; break ;
-					case 3 :                                                                                                           break ;
-					case 4 : append_line_to_string( start_msg_err.first , "cannot wash targets"                                    ) ; break ;
-				DF}
-			}
-			trace("deps",step,deps) ;
-			// record as much info as possible in reply
-			switch (step) {
-				case 5 :
-					// do not generate error if *_none_attrs is not available, as we will not restart job when fixed : do our best by using static info
-					try {
-						start_none_attrs = rule->start_none_attrs.eval(match,rsrcs,&deps) ;
-					} catch (::pair_ss const& msg_err) {
-						/**/              start_none_attrs  = rule->start_none_attrs.spec                            ;
-						set_nl(jrr.msg) ; jrr.msg          += rule->start_none_attrs.s_exc_msg(true/*using_static*/) ;
-						/**/              start_msg_err     = msg_err                                                ;
-					}
-					keep_tmp |= start_none_attrs.keep_tmp ;
-					//
-					for( auto [t,a] : pre_actions.first )              reply.pre_actions.emplace_back(t->name(),a) ;
-				[[fallthrough]] ;
-				case 4 :
-				case 3 :
-					/**/                                               reply.method                    = start_rsrcs_attrs.method       ;
-					/**/                                               reply.timeout                   = start_rsrcs_attrs.timeout      ;
-					for( ::pair_ss& kv : start_rsrcs_attrs.env )       reply.env.push_back(::move(kv)) ;
-				[[fallthrough]] ;
-				case 2 :
-					/**/                                               reply.interpreter               = start_cmd_attrs.interpreter    ;
-					/**/                                               reply.autodep_env.auto_mkdir    = start_cmd_attrs.auto_mkdir     ;
-					/**/                                               reply.autodep_env.ignore_stat   = start_cmd_attrs.ignore_stat    ;
-					/**/                                               reply.autodep_env.tmp_view      = ::move(start_cmd_attrs.tmp   ) ;                 // tmp directory as viewed by job
-					/**/                                               reply.chroot                    = ::move(start_cmd_attrs.chroot) ;
-					/**/                                               reply.use_script                = start_cmd_attrs.use_script     ;
-					for( ::pair_ss& kv : start_cmd_attrs.env )         reply.env.push_back(::move(kv)) ;
-				[[fallthrough]] ;
-				case 1 :
-					/**/                                               reply.cmd                       = ::move(cmd)                    ;
-				[[fallthrough]] ;
-				case 0 : {
-					VarIdx ti = 0 ;
-					for( ::string const& tn : match.static_matches() ) reply.static_matches.emplace_back( tn , rule->matches[ti++].second.flags ) ;
-					for( ::string const& p  : match.star_patterns () ) reply.star_matches  .emplace_back( p  , rule->matches[ti++].second.flags ) ;
-					if (rule->stdin_idx !=Rule::NoVar)                 reply.stdin                     = deps_attrs          [rule->stdin_idx ].second.txt ;
-					if (rule->stdout_idx!=Rule::NoVar)                 reply.stdout                    = reply.static_matches[rule->stdout_idx].first      ;
-					/**/                                               reply.addr                      = fd.peer_addr()                                    ;
-					/**/                                               reply.autodep_env.lnk_support   = g_config.lnk_support                              ;
-					/**/                                               reply.autodep_env.reliable_dirs = g_config.reliable_dirs                            ;
-					/**/                                               reply.autodep_env.src_dirs_s    = g_src_dirs_s                                      ;
-					/**/                                               reply.autodep_env.root_dir      = *g_root_dir                                       ;
-					/**/                                               reply.cwd_s                     = rule->cwd_s                                       ;
-					/**/                                               reply.date_prec                 = g_config.date_prec                                ;
-					/**/                                               reply.hash_algo                 = g_config.hash_algo                                ;
-					/**/                                               reply.keep_tmp                  = keep_tmp                                          ;
-					/**/                                               reply.kill_sigs                 = ::move(start_none_attrs.kill_sigs)                ;
-					/**/                                               reply.live_out                  = submit_attrs.live_out                             ;
-					/**/                                               reply.network_delay             = g_config.network_delay                            ;
-					/**/                                               reply.remote_admin_dir          = g_config.remote_admin_dir                         ;
-					for( ::pair_ss& kv : start_none_attrs .env )       reply.env.push_back(::move(kv)) ;
-				} break ;
-			DF}
+			// job is now under our responsibility : until its start is fully handled, it is known as started by a provisional date
+			// so that heartbeat and kill contact it through its port, where requests wait until job_exec is ready to handle them
+			entry.start_date = New      ;
+			entry.last_seen  = New      ;
+			entry.conn.host  = host     ;
+			entry.conn.port  = jrr.port ;
+		}
+		::vmap_s<DepDigest>& deps          = submit_attrs.deps ;
+		size_t               n_submit_deps = deps.size()       ;
+		int                  step          = 0                 ;
+		trace("submit_attrs",submit_attrs) ;
+		deps_attrs = rule->deps_attrs.eval(match) ;                    // this cannot fail as it was already run to construct job
+		try {
+			cmd               = rule->cmd              .eval(match,rsrcs,&deps) ; step = 1 ;
+			start_cmd_attrs   = rule->start_cmd_attrs  .eval(match,rsrcs,&deps) ; step = 2 ;
+			start_rsrcs_attrs = rule->start_rsrcs_attrs.eval(match,rsrcs,&deps) ; step = 3 ;
 			//
-			reply.deps = _mk_digest_deps(::move(deps_attrs)) ;
-			if (+deps) {
-				::umap_s<VarIdx> dep_idxes ; for( VarIdx i=0 ; i<reply.deps.size() ; i++ ) dep_idxes[reply.deps[i].first] = i ;
-				for( auto const& [dn,dd] : deps )
-					if ( auto it=dep_idxes.find(dn) ; it!=dep_idxes.end() )                                       reply.deps[it->second].second |= dd ;   // update existing dep
-					else                                                    { dep_idxes[dn] = reply.deps.size() ; reply.deps.emplace_back(dn,dd) ;      } // create new dep
-			}
+			try                       { start_cmd_attrs.chk(start_rsrcs_attrs.method) ; }
+			catch (::string const& e) { throw ::pair_ss/*msg,err*/(e,{}) ;              }
+			step = 4 ;
 			//
-			bool dep_ready = true ;
-			for( auto const& [dn,dd] : ::vector_view(deps.data()+n_submit_deps,deps.size()-n_submit_deps) )                     // note : this is ok even if deps is empty
-				for( Req r : entry.reqs )
-					// to be sure, we should check done(Dsk) rather than done(Status), but we do not seek security here, we seek perf (real check will be done at end of job)
-					// and most of the time, done(Status) implies file is ok, and we have less false positive as we do not have the opportunity to fully assess sources
-					if (!Node(dn)->done(r,NodeGoal::Status)) { dep_ready = false ; goto EarlyEnd ; }
-			if (step<5) {
-			EarlyEnd :
-				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-				OMsgBuf().send(fd,JobRpcReply(JobProc::None)) ;                                                                 // silently tell job_exec to give up
-				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-				Status status = Status::EarlyErr ;
-				if (!dep_ready) {
-					status        = Status::EarlyChkDeps ;
-					start_msg_err = {}                   ;
+			pre_actions = job->pre_actions( match , true/*mark_target_dirs*/ ) ; step = 5 ;
+		} catch (::pair_ss const& msg_err) {
+			append_line_to_string(start_msg_err.first  , msg_err.first  ) ;
+			append_line_to_string(start_msg_err.second , msg_err.second ) ;
+			switch (step) {
+				case 0 : append_line_to_string( start_msg_err.first , rule->cmd              .s_exc_msg(false/*using_static*/) ) ; break ;
+				case 1 : append_line_to_string( start_msg_err.first , rule->start_cmd_attrs  .s_exc_msg(false/*using_static*/) ) ; break ;
+				case 2 : append_line_to_string( start_msg_err.first , rule->start_rsrcs_attrs.s_exc_msg(false/*using_static*/) ) ; break ;
+				case 3 :                                                                                                           break ;
+				case 4 : append_line_to_string( start_msg_err.first , "cannot wash targets"                                    ) ; break ;
+			DF}
+		}
+		trace("deps",step,deps) ;
+		// record as much info as possible in reply
+		switch (step) {
+			case 5 :
+				// do not generate error if *_none_attrs is not available, as we will not restart job when fixed : do our best by using static info
+				try {
+					start_none_attrs = rule->start_none_attrs.eval(match,rsrcs,&deps) ;
+				} catch (::pair_ss const& msg_err) {
+					/**/              start_none_attrs  = rule->start_none_attrs.spec                            ;
+					set_nl(jrr.msg) ; jrr.msg          += rule->start_none_attrs.s_exc_msg(true/*using_static*/) ;
+					/**/              start_msg_err     = msg_err                                                ;
 				}
+				keep_tmp |= start_none_attrs.keep_tmp ;
+				//
+				for( auto [t,a] : pre_actions.first )              reply.pre_actions.emplace_back(t->name(),a) ;
+			[[fallthrough]] ;
+			case 4 :
+			case 3 :
+				/**/                                               reply.method                    = start_rsrcs_attrs.method       ;
+				/**/                                               reply.timeout                   = start_rsrcs_attrs.timeout      ;
+				for( ::pair_ss& kv : start_rsrcs_attrs.env )       reply.env.push_back(::move(kv)) ;
+			[[fallthrough]] ;
+			case 2 :
+				/**/                                               reply.interpreter               = start_cmd_attrs.interpreter    ;
+				/**/                                               reply.autodep_env.auto_mkdir    = start_cmd_attrs.auto_mkdir     ;
+				/**/                                               reply.autodep_env.ignore_stat   = start_cmd_attrs.ignore_stat    ;
+				/**/                                               reply.autodep_env.shm_report    = start_cmd_attrs.shm_report     ;
+				/**/                                               reply.autodep_env.tmp_view      = ::move(start_cmd_attrs.tmp   ) ;                 // tmp directory as viewed by job
+				/**/                                               reply.chroot                    = ::move(start_cmd_attrs.chroot) ;
+				/**/                                               reply.use_script                = start_cmd_attrs.use_script     ;
+				for( ::pair_ss& kv : start_cmd_attrs.env )         reply.env.push_back(::move(kv)) ;
+			[[fallthrough]] ;
+			case 1 :
+				/**/                                               reply.cmd                       = ::move(cmd)                    ;
+			[[fallthrough]] ;
+			case 0 : {
+				VarIdx ti = 0 ;
+				for( ::string const& tn : match.static_matches() ) reply.static_matches.emplace_back( tn , rule->matches[ti++].second.flags ) ;
+				for( ::string const& p  : match.star_patterns () ) reply.star_matches  .emplace_back( p  , rule->matches[ti++].second.flags ) ;
+				if (rule->stdin_idx !=Rule::NoVar)                 reply.stdin                     = deps_attrs          [rule->stdin_idx ].second.txt ;
+				if (rule->stdout_idx!=Rule::NoVar)                 reply.stdout                    = reply.static_matches[rule->stdout_idx].first      ;
+				/**/                                               reply.addr                      = host                                              ;
+				/**/                                               reply.autodep_env.lnk_support   = g_config.lnk_support                              ;
+				/**/                                               reply.autodep_env.reliable_dirs = g_config.reliable_dirs                            ;
+				/**/                                               reply.autodep_env.src_dirs_s    = g_src_dirs_s                                      ;
+				/**/                                               reply.autodep_env.root_dir      = *g_root_dir                                       ;
+				/**/                                               reply.cwd_s                     = rule->cwd_s                                       ;
+				/**/                                               reply.date_prec                 = g_config.date_prec                                ;
+				/**/                                               reply.keep_tmp                  = keep_tmp                                          ;
+				/**/                                               reply.kill_sigs                 = ::move(start_none_attrs.kill_sigs)                ;
+				/**/                                               reply.live_out                  = submit_attrs.live_out                             ;
+				/**/                                               reply.network_delay             = g_config.network_delay                            ;
+				/**/                                               reply.remote_admin_dir          = g_config.remote_admin_dir                         ;
+				for( ::pair_ss& kv : start_none_attrs .env )       reply.env.push_back(::move(kv)) ;
+			} break ;
+		DF}
+		//
+		reply.deps = _mk_digest_deps(::move(deps_attrs)) ;
+		if (+deps) {
+			::umap_s<VarIdx> dep_idxes ; for( VarIdx i=0 ; i<reply.deps.size() ; i++ ) dep_idxes[reply.deps[i].first] = i ;
+			for( auto const& [dn,dd] : deps )
+				if ( auto it=dep_idxes.find(dn) ; it!=dep_idxes.end() )                                       reply.deps[it->second].second |= dd ;   // update existing dep
+				else                                                    { dep_idxes[dn] = reply.deps.size() ; reply.deps.emplace_back(dn,dd) ;      } // create new dep
+		}
+		//
+		bool dep_ready = true ;
+		for( auto const& [dn,dd] : ::vector_view(deps.data()+n_submit_deps,deps.size()-n_submit_deps) )                         // note : this is ok even if deps is empty
+			for( Req r : reqs )
+				// to be sure, we should check done(Dsk) rather than done(Status), but we do not seek security here, we seek perf (real check will be done at end of job)
+				// and most of the time, done(Status) implies file is ok, and we have less false positive as we do not have the opportunity to fully assess sources
+				if (!Node(dn)->done(r,NodeGoal::Status)) { dep_ready = false ; goto EarlyEnd ; }
+		if (step<5) {
+		EarlyEnd :
+			//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+			OMsgBuf().send(fd,JobRpcReply(JobProc::None)) ;                                                                     // silently tell job_exec to give up
+			//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+			Status status = Status::EarlyErr ;
+			if (!dep_ready) {
+				status        = Status::EarlyChkDeps ;
+				start_msg_err = {}                   ;
+			}
+			{	Lock lock { _s_mutex } ;
+				auto it = _s_start_tab.find(+job) ;
+				if ( it==_s_start_tab.end() || it->second.conn.seq_id!=jrr.seq_id ) { trace("vanished") ; return false ; }     // job end has been invented in the mean time
 				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-				s_end( entry.tag , +job , status ) ;                                                                            // dont care about backend, job is dead for other reasons
+				s_end( tag , +job , status ) ;                                                                                  // dont care about backend, job is dead for other reasons
 				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-				JobDigest digest {
-					.status = status
-				,	.deps   = reply.deps
-				,	.stderr = start_msg_err.second
-				} ;
-				trace("early",digest) ;
-				JobInfo ji {
-					{
-						.eta          = eta
-					,	.submit_attrs = ::move(submit_attrs)
-					,	.rsrcs        = rsrcs
-					,	.host         = reply.addr
-					,	.pre_start    = jrr
-					,	.start        = ::move(reply)
-					,	.stderr       = start_msg_err.second
-					}
-				,	{	{ JobProc::End , jrr.seq_id , jrr.job , ::copy(digest) } }
-				} ;
-				ji.write(jaf) ;
-				job_exec = { job , reply.addr , FileSig(jaf) , New } ;                                                          // job starts and ends
-				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-				g_engine_queue.emplace( JobProc::Start , ::copy(job_exec) , false/*report_now*/ , ::move(pre_actions.second) , ""s , ::move(jrr.msg            ) ) ;
-				g_engine_queue.emplace( JobProc::End   , ::move(job_exec) , ::move(rsrcs) , ::move(digest)                         , ::move(start_msg_err.first) ) ;
-				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-				trace("release_start_tab",entry,step,start_msg_err) ;
+				trace("release_start_tab",it->second,step,start_msg_err) ;
 				_s_release_start_entry(it) ;
+			}
+			JobDigest digest {
+				.status = status
+			,	.deps   = reply.deps
+			,	.stderr = start_msg_err.second
+			} ;
+			trace("early",digest) ;
+			JobInfo ji {
+				{
+					.eta          = eta
+				,	.submit_attrs = ::move(submit_attrs)
+				,	.rsrcs        = rsrcs
+				,	.host         = reply.addr
+				,	.pre_start    = jrr
+				,	.start        = ::move(reply)
+				,	.stderr       = start_msg_err.second
+				}
+			,	{	{ JobProc::End , jrr.seq_id , jrr.job , ::copy(digest) } }
+			} ;
+			job_exec = { job , reply.addr , job->write_job_info(ji) , New } ;                                                   // job starts and ends
+			//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+			g_engine_queue.emplace( JobProc::Start , ::copy(job_exec) , false/*report_now*/ , ::move(pre_actions.second) , ""s , ::move(jrr.msg            ) ) ;
+			g_engine_queue.emplace( JobProc::End   , ::move(job_exec) , ::move(rsrcs) , ::move(digest)                         , ::move(start_msg_err.first) ) ;
+			//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+			return false ;
+		}
+		//
+		reply.small_id            = _s_small_ids.acquire() ;
+		reply.keep_conn           = _s_job_thread->n_slaves<=_s_max_job_conns ;                                                              // if short of fds, job_exec connects for each request
+		reply.autodep_env.tmp_dir = keep_tmp ?
+			to_string(*g_root_dir            ,'/',job->ancillary_file(AncillaryTag::KeepTmp))
+		:	to_string(g_config.remote_tmp_dir,'/',reply.small_id                            )
+		;
+		SmallId small_id = reply.small_id ;                                                                                     // save before move
+		//vvvvvvvvvvvvvvvvvvvvvv
+		OMsgBuf().send(fd,reply) ;                                                                                              // send reply ASAP to minimize overhead
+		//^^^^^^^^^^^^^^^^^^^^^^
+		SigDate start_date = job->write_job_info(JobInfoStart({
+			.rule_cmd_crc =        rule->cmd_crc
+		,	.stems        = ::move(match.stems         )
+		,	.eta          =        eta
+		,	.submit_attrs =        submit_attrs
+		,	.rsrcs        = ::move(rsrcs               )
+		,	.host         =        host
+		,	.pre_start    =        jrr
+		,	.start        = ::move(reply               )
+		,	.stderr       =        start_msg_err.second
+		})) ;
+		job_exec = { job , host , start_date } ;                                                                                // job starts
+		{	Lock lock { _s_mutex } ;
+			auto it = _s_start_tab.find(+job) ;
+			if ( it==_s_start_tab.end() || it->second.conn.seq_id!=jrr.seq_id ) {                                               // job end has been invented in the mean time
+				trace("vanished") ;
+				_s_small_ids.release(small_id) ;
 				return false ;
 			}
-			//
-			reply.small_id            = _s_small_ids.acquire() ;
-			reply.autodep_env.tmp_dir = keep_tmp ?
-				to_string(*g_root_dir            ,'/',job->ancillary_file(AncillaryTag::KeepTmp))
-			:	to_string(g_config.remote_tmp_dir,'/',reply.small_id                            )
-			;
-			//vvvvvvvvvvvvvvvvvvvvvv
-			OMsgBuf().send(fd,reply) ;                                                                                          // send reply ASAP to minimize overhead
-			//^^^^^^^^^^^^^^^^^^^^^^
-			in_addr_t reply_addr = reply.addr ;                                                                                 // save before move
-			serialize(
-				OFStream(dir_guard(jaf))
-			,	JobInfoStart({
-					.rule_cmd_crc =        rule->cmd_crc
-				,	.stems        = ::move(match.stems         )
-				,	.eta          =        eta
-				,	.submit_attrs =        submit_attrs
-				,	.rsrcs        = ::move(rsrcs               )
-				,	.host         =        reply_addr
-				,	.pre_start    =        jrr
-				,	.start        = ::move(reply               )
-				,	.stderr       =        start_msg_err.second
-				})
-			) ;
-			job_exec            = { job , reply.addr , FileSig(jaf) } ;                                                         // job starts
-			entry.start_date    = job_exec.start_date                 ;
-			entry.conn.host     = job_exec.host                       ;
-			entry.conn.port     = jrr.port                            ;
-			entry.conn.small_id = reply.small_id                      ;
-			//
-			trace("started",job_exec,reply) ;
+			StartEntry& entry = it->second ;
+			entry.start_date    = job_exec.start_date ;
+			entry.conn.small_id = small_id            ;
+			trace("started",job_exec,entry) ;
 		}
 		bool report_now = +pre_actions.second || +start_msg_err.second || Delay(job->exec_time)>=start_none_attrs.start_delay ; // dont defer long jobs or if a message is to be delivered to user
-		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 		g_engine_queue.emplace( JobProc::Start , ::copy(job_exec) , report_now , ::move(pre_actions.second) , ::move(start_msg_err.second) , jrr.msg+start_msg_err.first ) ;
 		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 		if (!report_now) {
@@ -433,11 +452,15 @@ namespace Backends {
 		DF}
 		Job job { jmrr.job } ;
 		Trace trace(BeChnl,"_s_handle_job_mngt",jmrr) ;
+		{	Lock lock { _s_starting_job_mutex } ;                         // ensure _s_handled_job_start is done for this job as entry is only complete by then
+			_s_starting_job_cond.wait( lock , [&](){ return !_s_starting_jobs.contains(+job) ; } ) ;
+		}
 		{	Lock lock { _s_mutex } ;                                      // prevent sub-backend from manipulating _s_start_tab from main thread, lock for minimal time
 			//                                                                                                                                            keep_fd
 			auto        it    = _s_start_tab.find(+job) ; if (it==_s_start_tab.end()        ) { trace("not_in_tab"                              ) ; return false ; }
 			StartEntry& entry = it->second              ; if (entry.conn.seq_id!=jmrr.seq_id) { trace("bad_seq_id",entry.conn.seq_id,jmrr.seq_id) ; return false ; }
 			trace("entry",job,entry) ;
+			entry.last_seen = New ;                                       // job is obviously alive, no need to wake it up for a while
 			switch (jmrr.proc) { //!           vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 				case JobMngtProc::ChkDeps    :
 				case JobMngtProc::DepVerbose : g_engine_queue.emplace( jmrr.proc , JobExec(job,entry.conn.host,entry.start_date,New) , jmrr.fd , ::move(jmrr.deps) ) ; break ;
@@ -460,7 +483,9 @@ namespace Backends {
 		JobExec   je    ;
 		::vmap_ss rsrcs ;
 		Trace trace(BeChnl,"_s_handle_job_end",jrr) ;
-		if (jrr.job==_s_starting_job) Lock lock{_s_starting_job_mutex} ; // ensure _s_handled_job_start is done for this job
+		{	Lock lock { _s_starting_job_mutex } ;                        // ensure _s_handled_job_start is done for this job
+			_s_starting_job_cond.wait( lock , [&](){ return !_s_starting_jobs.contains(+job) ; } ) ;
+		}
 		{	Lock lock { _s_mutex } ;                                     // prevent sub-backend from manipulating _s_start_tab from main thread, lock for minimal time
 			//
 			auto        it    = _s_start_tab.find(+job) ; if (it==_s_start_tab.end()       ) { trace("not_in_tab"                             ) ; return false ; }
@@ -486,16 +511,55 @@ namespace Backends {
 			dep.acquire_crc() ;
 			dd.crc_sig(dep) ;
 		}
-		::string jaf = job->ancillary_file() ;
-		serialize( OFStream(jaf,::ios::app) , JobInfoEnd{jrr} ) ;        // /!\ _s_starting_job ensures ancillary file is written by _s_handle_job_start before we append to it
+		je.end_date = job->write_job_info(JobInfoEnd{jrr}) ;            // /!\ _s_starting_jobs ensures start info is written by _s_handle_job_start before we write end info
 		job->end_exec() ;
-		je.end_date = FileSig(jaf) ;
 		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 		g_engine_queue.emplace( JobProc::End , ::move(je) , ::move(rsrcs) , ::move(jrr.digest) , ::move(jrr.msg) ) ;
 		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 		return false/*keep_fd*/ ;
 	}
 
+	bool/*keep_fd*/ Backend::_s_handle_job_mux( JobMuxRpcReq&& jmrr , SlaveSockFd const& fd ) {
+		if (jmrr.is_mngt) return _s_handle_job_mngt(::move(jmrr.jmrr),fd) ;
+		switch (jmrr.jrr.proc) {
+			case JobProc::None  : return false                                      ; // if connection is lost, ignore it
+			case JobProc::Start : {
+				SWEAR(+fd) ;
+				{	Lock lock { _s_starting_job_mutex } ;
+					_s_starting_jobs[jmrr.jrr.job]++ ;                                 // record before reply can be sent so job end waits for start to be fully handled
+				}
+				_s_job_queue.emplace( ::move(jmrr.jrr) , SlaveSockFd(fd.dup()) ) ; // fd is owned by job thread and may be closed while start is handled
+				return false ;
+			}
+			case JobProc::End :
+				_s_job_queue.emplace( ::move(jmrr.jrr) , SlaveSockFd() ) ;         // job end may wait for job start and writes job info, dont block job thread
+				return false ;
+		DF}
+	}
+
+	// python evaluation is serialized by the Gil, but the rest of job start and job end is done in parallel for independent jobs
+	// as queue is FIFO, the start of a job is popped before its end, so a job end waiting for its start cannot dead-lock
+	void Backend::_s_job_queue_thread_func(::stop_token stop) {
+		t_thread_key = 'S' ;
+		Trace trace(BeChnl,"_s_job_queue_thread_func") ;
+		for(;;) {
+			auto [popped,jrr_fd] = _s_job_queue.pop(stop) ;
+			if (!popped) break ;
+			if (jrr_fd.first.proc==JobProc::End) {
+				_s_handle_job_end(::move(jrr_fd.first)) ;
+				continue ;
+			}
+			JobIdx job = jrr_fd.first.job ;
+			_s_handle_job_start( ::move(jrr_fd.first) , jrr_fd.second ) ;
+			{	Lock lock { _s_starting_job_mutex } ;
+				auto it = _s_starting_jobs.find(job) ; SWEAR(it!=_s_starting_jobs.end(),job) ;
+				if (!--it->second) _s_starting_jobs.erase(it) ;
+			}
+			_s_starting_job_cond.notify_all() ;
+		}
+		trace("done") ;
+	}
+
 	// kill all if ri==0
 	void Backend::_s_kill_req(ReqIdx ri) {
 		Trace trace(BeChnl,"s_kill_req",ri) ;
@@ -547,88 +611,119 @@ namespace Backends {
 		//                                   ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 	}
 
+	void Backend::_s_schedule_heartbeat( JobIdx job , SeqId seq_id , Pdate date ) {
+		_s_mutex.swear_locked() ;
+		auto it = _s_heartbeat_tab.lower_bound(date) ;                                                    // join the next bucket if close enough so that checks are done by batches
+		if ( it==_s_heartbeat_tab.end() || it->first>date+g_config.heartbeat_tick ) it = _s_heartbeat_tab.try_emplace(it,date) ;
+		it->second.emplace_back(job,seq_id) ;
+	}
+
+	// each job is checked at its own date, so detection latency does not depend on the number of running jobs
+	// started jobs are only woken up if they have not sent any message during the last heartbeat period
 	void Backend::_s_heartbeat_thread_func(::stop_token stop) {
 		t_thread_key = 'H' ;
 		Trace trace(BeChnl,"_heartbeat_thread_func") ;
-		Pdate  last_wrap_around{New} ;
-		//
-		StartEntry::Conn         conn         ;
-		::pair_s<HeartbeatState> lost_report  = {}/*garbage*/ ;
-		Status                   status       = {}/*garbage*/ ;
-		Pdate                    eta          ;
-		::vmap_ss                rsrcs        ;
-		SubmitAttrs              submit_attrs ;
-		SigDate                  start_date   ;
-		for( JobIdx job=0 ;; job++ ) {
-			{	Lock lock { _s_mutex }                    ;                                                  // lock _s_start_tab for minimal time
-				auto it   = _s_start_tab.lower_bound(job) ;
-				if (it==_s_start_tab.end()) goto WrapAround ;
-				//
-				job = it->first ;                                                                            // job is now the next valid entry
-				StartEntry& entry = it->second ;
-				//
-				if (!entry    )                      continue ;                                              // not a real entry                        ==> no check, no wait
-				if (!entry.old) { entry.old = true ; continue ; }                                            // entry is too new, wait until next round ==> no check, no wait
-				start_date = entry.start_date ;
-				conn       = entry.conn       ;
-				if (+start_date.date) goto Wakeup ;
-				lost_report = s_heartbeat(entry.tag,job) ;
-				if (lost_report.second==HeartbeatState::Alive) goto Next ;                                   // job is still alive
-				if (!lost_report.first                       ) lost_report.first = "vanished before start" ;
-				//
-				Status hbs = lost_report.second==HeartbeatState::Err ? Status::EarlyLostErr : Status::LateLost ;
-				//
-				rsrcs        = ::move(entry.rsrcs       )     ;
-				submit_attrs = ::move(entry.submit_attrs)     ;
-				eta          = entry.req_info().first         ;
-				status       = _s_release_start_entry(it,hbs) ;
-				trace("handle_job",job,entry,status) ;
+		struct Lost {
+			JobIdx                   job          = 0 ;
+			Status                   status       = {}/*garbage*/ ;
+			::pair_s<HeartbeatState> lost_report  ;
+			StartEntry::Conn         conn         ;
+			Pdate                    eta          ;
+			::vmap_ss                rsrcs        ;
+			SubmitAttrs              submit_attrs ;
+		} ;
+		for(;;) {
+			Pdate                                         now       { New } ;
+			Pdate                                         next      ;
+			::vmap<JobIdx,pair<StartEntry::Conn,SigDate>> to_wakeup ;
+			::vector<Lost>                                losts     ;
+			{	Lock lock { _s_mutex } ;                                                                     // a single lock for all due jobs
+				while ( +_s_heartbeat_tab && _s_heartbeat_tab.begin()->first<=now ) {
+					::vector<::pair<JobIdx,SeqId>> bucket = ::move(_s_heartbeat_tab.begin()->second) ;
+					_s_heartbeat_tab.erase(_s_heartbeat_tab.begin()) ;
+					for( auto [job,seq_id] : bucket ) {
+						auto it = _s_start_tab.find(job) ;
+						if ( it==_s_start_tab.end() || it->second.conn.seq_id!=seq_id ) continue ;               // job has ended or restarted since it was scheduled
+						StartEntry& entry = it->second ;
+						if (+entry.start_date.date) {
+							Pdate d = entry.last_seen+g_config.heartbeat ;
+							if (d>now) { _s_schedule_heartbeat(job,seq_id,d) ; continue ; }                      // job has recently shown to be alive
+							to_wakeup.push_back({ job , {entry.conn,entry.start_date} }) ;
+							_s_schedule_heartbeat(job,seq_id,now+g_config.heartbeat) ;
+							continue ;
+						}
+						::pair_s<HeartbeatState> lost_report = s_heartbeat(entry.tag,job) ;
+						if (lost_report.second==HeartbeatState::Alive) { _s_schedule_heartbeat(job,seq_id,now+g_config.heartbeat) ; continue ; }
+						if (!lost_report.first                       ) lost_report.first = "vanished before start" ;
+						//
+						Status hbs  = lost_report.second==HeartbeatState::Err ? Status::EarlyLostErr : Status::LateLost ;
+						Lost&  lost = losts.emplace_back() ;
+						lost.job          =                        job           ;
+						lost.lost_report  = ::move                (lost_report       ) ;
+						lost.conn         =                        entry.conn          ;
+						lost.rsrcs        = ::move                (entry.rsrcs       ) ;
+						lost.submit_attrs = ::move                (entry.submit_attrs) ;
+						lost.eta          = entry.req_info().first                     ;
+						lost.status       = _s_release_start_entry(it,hbs            ) ;
+						trace("handle_job",job,lost.status) ;
+					}
+				}
+				for( Tag t : All<Tag> ) if (s_ready(t)) s_tab[+t]->tick() ;
+				next = +_s_heartbeat_tab ? _s_heartbeat_tab.begin()->first : now+g_config.heartbeat ;
 			}
-			{	Job       j  { job            } ;
-				JobDigest jd { .status=status } ;
-				if (status==Status::EarlyLostErr) {                                                          // if we do not retry, record run info
+			for( Lost& l : losts ) {
+				Job       j          { l.job            } ;
+				JobDigest jd         { .status=l.status } ;
+				SigDate   start_date = New                ;
+				if (l.status==Status::EarlyLostErr) {                                                        // if we do not retry, record run info
 					JobInfo ji {
-						{	.eta          = eta
-						,	.submit_attrs = submit_attrs
-						,	.rsrcs        = rsrcs
-						,	.host         = conn.host
-						,	.pre_start    { JobProc::None , conn.seq_id , job }
-						,	.start        { JobProc::None                     }
+						{	.eta          = l.eta
+						,	.submit_attrs = l.submit_attrs
+						,	.rsrcs        = l.rsrcs
+						,	.host         = l.conn.host
+						,	.pre_start    { JobProc::None , l.conn.seq_id , l.job }
+						,	.start        { JobProc::None                         }
 						}
-					,	{	.end { JobProc::End , conn.seq_id , job , ::copy(jd) , ::copy(lost_report.first) } }
+					,	{	.end { JobProc::End , l.conn.seq_id , l.job , ::copy(jd) , ::copy(l.lost_report.first) } }
 					} ;
-					j->write_job_info(ji) ;
+					start_date = j->write_job_info(ji) ;
 				}
-				JobExec je { j , FileSig(j->ancillary_file()) , New } ;                                      // job starts and ends, no host
-				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-				g_engine_queue.emplace( JobProc::Start , ::copy(je) , false/*report_now*/                                    ) ;
-				g_engine_queue.emplace( JobProc::End   , ::move(je) , ::move(rsrcs) , ::move(jd) , ::move(lost_report.first) ) ;
-				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-				goto Next ;
+				JobExec je { j , start_date , New } ;                                                        // job starts and ends, no host
+				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+				g_engine_queue.emplace( JobProc::Start , ::copy(je) , false/*report_now*/                                        ) ;
+				g_engine_queue.emplace( JobProc::End   , ::move(je) , ::move(l.rsrcs) , ::move(jd) , ::move(l.lost_report.first) ) ;
+				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 			}
-		Wakeup :
-			_s_wakeup_remote(job,conn,start_date,JobMngtProc::Heartbeat) ;
-		Next :
-			if (!g_config.heartbeat_tick.sleep_for(stop)) break ;                                            // limit job checks
-			continue ;
-		WrapAround :
-			job = 0 ;
-			Delay d = g_config.heartbeat + g_config.network_delay ;                                          // ensure jobs have had a minimal time to start and signal it
-			if ((last_wrap_around+d).sleep_until(stop)) { last_wrap_around = Pdate(New) ; continue ; }       // limit job checks
-			else                                        {                                 break    ; }
+			for( auto const& [j,c] : to_wakeup ) _s_wakeup_remote( j , c.first , c.second , JobMngtProc::Heartbeat ) ; // outside lock as connecting to job may take time
+			if (!::max(next,now+g_config.heartbeat_tick).sleep_until(stop)) break ;                          // limit job checks
 		}
 		trace("done") ;
 	}
 
 	void Backend::s_config( ::array<Config::Backend,N<Tag>> const& config , bool dynamic ) {
-		static ::jthread      heartbeat_thread      {    _s_heartbeat_thread_func                 } ;
-		static JobThread      job_start_thread      {'S',_s_handle_job_start      ,4096/*backlog*/} ; _s_job_start_thread       = &job_start_thread       ; // 4096 : max usual value as set in ...
-		static JobMngtThread  job_mngt_thread       {'M',_s_handle_job_mngt       ,4096/*backlog*/} ; _s_job_mngt_thread        = &job_mngt_thread        ; // ... /proc/sys/net/core/somaxconn
-		static JobThread      job_end_thread        {'E',_s_handle_job_end        ,4096/*backlog*/} ; _s_job_end_thread         = &job_end_thread         ; // .
-		static DeferredThread deferred_report_thread{'R',_s_handle_deferred_report                } ; _s_deferred_report_thread = &deferred_report_thread ;
-		static DeferredThread deferred_wakeup_thread{'W',_s_handle_deferred_wakeup                } ; _s_deferred_wakeup_thread = &deferred_wakeup_thread ;
+		static ::jthread      heartbeat_thread      ;
+		static JobThread      job_thread            {'J',_s_handle_job_mux        ,4096/*backlog*/,true/*persistent*/} ; _s_job_thread             = &job_thread             ; // 4096 : max usual value as set in ...
+		static DeferredThread deferred_report_thread{'R',_s_handle_deferred_report                                     } ; _s_deferred_report_thread = &deferred_report_thread ; // ... /proc/sys/net/core/somaxconn
+		static DeferredThread deferred_wakeup_thread{'W',_s_handle_deferred_wakeup                                     } ; _s_deferred_wakeup_thread = &deferred_wakeup_thread ;
+		static ::vector<::jthread> job_start_threads = []()->::vector<::jthread> {
+			::vector<::jthread> res ;
+			for( uint8_t i=0 ; i<NJobThreads ; i++ ) res.emplace_back(_s_job_queue_thread_func) ;
+			return res ;
+		}() ;
 		Trace trace(BeChnl,"s_config",STR(dynamic)) ;
 		if (!dynamic) s_executable = *g_lmake_dir+"/_bin/job_exec" ;
+		if ( !dynamic && +g_config.heartbeat ) heartbeat_thread = ::jthread(_s_heartbeat_thread_func) ;                                                // heartbeat is static, no thread if no job is ever checked
+		if (!dynamic) {                                                                                                                                 // persistent job connections use 1 fd per job
+			struct rlimit rl ;
+			::getrlimit(RLIMIT_NOFILE,&rl) ;
+			if ( rl.rlim_cur!=RLIM_INFINITY && rl.rlim_cur<rl.rlim_max ) {
+				::rlim_t old_limit = rl.rlim_cur ;
+				rl.rlim_cur = rl.rlim_max==RLIM_INFINITY ? ::max(old_limit,::rlim_t(1<<20)) : rl.rlim_max ;                                             // dont ask for more than usual nr_open
+				if (::setrlimit(RLIMIT_NOFILE,&rl)!=0) rl.rlim_cur = old_limit ;
+			}
+			_s_max_job_conns = rl.rlim_cur==RLIM_INFINITY ? Npos : rl.rlim_cur/2 ;                                                                      // keep half of fds for other purposes
+			trace("max_job_conns",_s_max_job_conns) ;
+		}
 		//
 		Lock lock{_s_mutex} ;
 		for( Tag t : All<Tag> ) if (+t) {
@@ -654,9 +749,7 @@ namespace Backends {
 			try                       { be->config(cfg.dct,dynamic) ; be->config_err.clear() ; trace("ready",t  ) ; }
 			catch (::string const& e) { SWEAR(+e)                   ; be->config_err = e     ; trace("err"  ,t,e) ; }                                       // empty config_err means ready
 		}
-		job_start_thread.wait_started() ;
-		job_mngt_thread .wait_started() ;
-		job_end_thread  .wait_started() ;
+		job_thread.wait_started() ;
 	}
 
 	::vector_s Backend::acquire_cmd_line( Tag tag , JobIdx job , ::vector<ReqIdx> const& reqs , ::vmap_ss&& rsrcs , SubmitAttrs const& submit_attrs ) {
@@ -674,11 +767,10 @@ namespace Backends {
 		if (fresh) {                                                    entry.submit_attrs = submit_attrs ;                                            }
 		else       { uint8_t n_retries = entry.submit_attrs.n_retries ; entry.submit_attrs = submit_attrs ; entry.submit_attrs.n_retries = n_retries ; } // keep retry count if it was counting
 		trace("create_start_tab",job,entry) ;
+		if (+g_config.heartbeat) _s_schedule_heartbeat( job , entry.conn.seq_id , Pdate(New)+g_config.heartbeat+g_config.network_delay ) ; // ensure job has had a minimal time to start and signal it
 		::vector_s cmd_line {
 			s_executable
-		,	_s_job_start_thread->fd.service(s_tab[+tag]->addr)
-		,	_s_job_mngt_thread ->fd.service(s_tab[+tag]->addr)
-		,	_s_job_end_thread  ->fd.service(s_tab[+tag]->addr)
+		,	_s_job_thread->fd.service(s_tab[+tag]->addr)
 		,	::to_string(entry.conn.seq_id)
 		,	::to_string(job              )
 		,	*g_root_dir
@@ -688,4 +780,13 @@ namespace Backends {
 		return cmd_line ;
 	}
 
+	::vector_s Backend::worker_cmd_line( Tag tag , size_t id ) const {
+		return {
+			s_executable
+		,	_s_job_thread->fd.service(s_tab[+tag]->addr)
+		,	*g_root_dir
+		,	to_string(g_config.remote_admin_dir,"/job_trace/worker_",id)
+		} ;
+	}
+
 }
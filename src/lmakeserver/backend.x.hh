@@ -50,6 +50,8 @@ namespace Backends {
 		using Pdate       = Time::Pdate       ;
 		using SigDate     = Disk::SigDate     ;
 
+		static constexpr uint8_t NJobThreads = 4 ; // python evaluation is serialized by the Gil, but the rest of job start and end (washing, writing job info, ...) is done in parallel
+
 		struct StartEntry {
 			friend ::ostream& operator<<( ::ostream& , StartEntry const& ) ;
 			struct Conn {
@@ -83,7 +85,7 @@ namespace Backends {
 			::vmap_ss        rsrcs        ;
 			::vector<ReqIdx> reqs         ;
 			SubmitAttrs      submit_attrs ;
-			bool             old          = false        ; // becomes true the first time heartbeat passes (only old entries are checked by heartbeat, so first time is skipped for improved perf)
+			Pdate            last_seen    ;                // date of last message from job, which proves it is alive without having to wake it up
 			Tag              tag          = Tag::Unknown ;
 		} ;
 
@@ -128,33 +130,39 @@ namespace Backends {
 		static void            _s_kill_req              ( ReqIdx=0                                                              ) ; // kill all if req==0
 		static void            _s_wakeup_remote         ( JobIdx , StartEntry::Conn const& , SigDate const& start , JobMngtProc ) ;
 		static void            _s_heartbeat_thread_func ( ::stop_token                                                          ) ;
+		static void            _s_schedule_heartbeat    ( JobIdx , SeqId , Pdate                                                ) ; // _s_mutex must be locked
+		static void            _s_job_queue_thread_func ( ::stop_token                                                          ) ;
 		static bool/*keep_fd*/ _s_handle_job_start      ( JobRpcReq    && , SlaveSockFd const& ={}                              ) ;
 		static bool/*keep_fd*/ _s_handle_job_mngt       ( JobMngtRpcReq&& , SlaveSockFd const& ={}                              ) ;
 		static bool/*keep_fd*/ _s_handle_job_end        ( JobRpcReq    && , SlaveSockFd const& ={}                              ) ;
+		static bool/*keep_fd*/ _s_handle_job_mux        ( JobMuxRpcReq && , SlaveSockFd const& ={}                              ) ;
 		static void            _s_handle_deferred_report( DeferredEntry&&                                                       ) ;
 		static void            _s_handle_deferred_wakeup( DeferredEntry&&                                                       ) ;
 		static Status          _s_release_start_entry   ( ::map<JobIdx,StartEntry>::iterator , Status                           ) ;
 		//
-		using JobThread      = ServerThread<JobRpcReq    > ;
-		using JobMngtThread  = ServerThread<JobMngtRpcReq> ;
+		using JobThread      = ServerThread<JobMuxRpcReq > ;
 		using DeferredThread = QueueThread <DeferredEntry> ;
+		using JobQueue       = ThreadQueue <::pair<JobRpcReq,SlaveSockFd>> ;
+		using HeartbeatTab   = ::map<Pdate,::vector<::pair<JobIdx,SeqId>>> ; // checks are grouped in buckets no wider than heartbeat_tick
 		// static data
 	public :
 		static ::string s_executable  ;
 		static Backend* s_tab[N<Tag>] ;
 
 	private :
-		static JobThread     *           _s_job_start_thread       ;
-		static JobMngtThread *           _s_job_mngt_thread        ;
-		static JobThread     *           _s_job_end_thread         ;
-		static DeferredThread*           _s_deferred_report_thread ;
-		static DeferredThread*           _s_deferred_wakeup_thread ;
-		static Mutex<MutexLvl::Backend>  _s_mutex                  ;
-		static ::atomic<JobIdx>          _s_starting_job           ;                                      // this job is starting when _starting_job_mutex is locked
-		static Mutex<MutexLvl::StartJob> _s_starting_job_mutex     ;
-		static ::map<JobIdx,StartEntry>  _s_start_tab              ;                                      // use map instead of umap because heartbeat iterates over while tab is moving
-		static SmallIds<SmallId>         _s_small_ids              ;
-		static SmallId                   _s_max_small_id           ;
+		static JobThread     *                      _s_job_thread             ;                           // job_exec's send all their requests on a persistent connection
+		static JobQueue                             _s_job_queue              ;                           // start & end requests are handled by a pool of threads, fd is dup'ed as job thread owns its own
+		static size_t                               _s_max_job_conns          ;                           // beyond this number of connections, job_exec's are asked not to keep their connection
+		static DeferredThread*                      _s_deferred_report_thread ;
+		static DeferredThread*                      _s_deferred_wakeup_thread ;
+		static Mutex<MutexLvl::Backend>             _s_mutex                  ;
+		static ::umap<JobIdx,uint8_t>               _s_starting_jobs          ;                           // jobs whose start is being handled (with count), protected by _s_starting_job_mutex
+		static Mutex<MutexLvl::StartJob>            _s_starting_job_mutex     ;
+		static ::condition_variable_any             _s_starting_job_cond      ;                           // notified when a job leaves _s_starting_jobs
+		static ::map<JobIdx,StartEntry>             _s_start_tab              ;
+		static HeartbeatTab                         _s_heartbeat_tab          ;                           // jobs to check by date, entries of jobs that have ended or restarted are ignored when due
+		static SmallIds<SmallId,true/*ThreadSafe*/> _s_small_ids              ;
+		static SmallId                              _s_max_small_id           ;
 	public :
 		// services
 		// PER_BACKEND : these virtual functions must be implemented by sub-backend, some of them have default implementations that do nothing when meaningful
@@ -177,6 +185,7 @@ namespace Backends {
 		virtual ::string/*msg*/          start    (JobIdx       ) = 0 ;                                   // tell sub-backend job started, return an informative message
 		virtual ::pair_s<bool/*retry*/>  end      (JobIdx,Status) { return {}                         ; } // tell sub-backend job ended, return a message and whether to retry jobs with garbage status
 		virtual ::pair_s<HeartbeatState> heartbeat(JobIdx       ) { return {{},HeartbeatState::Alive} ; } // regularly called between launch and start, initially with enough delay for job to connect
+		virtual void                     tick     (             ) {                                     } // regularly called by heartbeat thread, e.g. to release resources idle for too long
 		//
 		virtual ::vmap_ss mk_lcl( ::vmap_ss&& /*rsrcs*/ , ::vmap_s<size_t> const& /*capacity*/ ) const { return {} ; }   // map resources for this backend to local resources knowing local capacity
 		//
@@ -184,6 +193,7 @@ namespace Backends {
 	protected :
 		::vector_s acquire_cmd_line( Tag , JobIdx , ::vector<ReqIdx> const& , ::vmap_ss&& rsrcs , SubmitAttrs const& ) ; // must be called once before job is launched, SubmitAttrs must be the ...
 		/**/                                                                                                             // ... operator| of the submit/add_pressure corresponding values for the job
+		::vector_s worker_cmd_line( Tag , size_t id                                                          ) const ; // a job_exec worker runs jobs it reads on stdin, see job_exec.cc
 		// data
 		in_addr_t addr       = NoSockAddr ;
 		::string  config_err ;
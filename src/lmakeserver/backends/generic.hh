@@ -5,7 +5,7 @@
 
 #include "core.hh"
 
-// XXX : rework to maintain an ordered list of waiting_queues in ReqEntry to avoid walking through all rsrcs for each launched job
+#include "waiting_queues.hh"
 
 // a job may have 3 states :
 // - waiting : job has been submitted and is retained here until we can spawn it
@@ -103,12 +103,13 @@ namespace Backends {
 
 		struct WaitingEntry {
 			WaitingEntry() = default ;
-			WaitingEntry( RsrcsAsk const& rsa , SubmitAttrs const& sa , bool v ) : rsrcs_ask{rsa} , n_reqs{1} , submit_attrs{sa} , verbose{v} {}
+			WaitingEntry( RsrcsAsk const& rsa , ReqIdx r , SubmitAttrs const& sa , bool v , Delay et ) : rsrcs_ask{rsa} , reqs{r} , submit_attrs{sa} , verbose{v} , exec_time{et} {}
 			// data
-			RsrcsAsk    rsrcs_ask    ;
-			ReqIdx      n_reqs       = 0     ; // number of reqs waiting for this job
-			SubmitAttrs submit_attrs ;
-			bool        verbose      = false ;
+			RsrcsAsk         rsrcs_ask    ;
+			::vector<ReqIdx> reqs         ;         // reqs waiting for this job, so that launch need not look for them in all reqs
+			SubmitAttrs      submit_attrs ;
+			bool             verbose      = false ;
+			Delay            exec_time    ;         // estimated exec time, captured at submit time as job cannot be accessed from launch, 0 if unknown
 		} ;
 
 		struct SpawnedEntry {
@@ -116,35 +117,23 @@ namespace Backends {
 			SpawnId id      = -1    ;
 			bool    started = false ; // if true <=> start() has been called for this job, for assert only
 			bool    verbose = false ;
+			Pdate   eta     = {}    ; // estimated end date, may be in the past if job is longer than estimated, 0 if unknown
 		} ;
 
-		struct PressureEntry {
-			// services
-			bool              operator== (PressureEntry const&      ) const = default ;
-			::strong_ordering operator<=>(PressureEntry const& other) const {
-				if (pressure!=other.pressure) return other.pressure<=>pressure  ; // higher pressure first
-				else                          return job           <=>other.job ;
-			}
-			// data
-			CoarseDelay pressure ;
-			JobIdx      job      ;
-		} ;
-
-		struct ReqEntry {
+		struct ReqEntry : WaitingQueues<RsrcsAsk> {
 			ReqEntry() = default ;
 			ReqEntry( JobIdx nj , bool v ) : n_jobs{nj} , verbose{v} {}
 			// service
 			void clear() {
-				waiting_queues.clear() ;
-				waiting_jobs  .clear() ;
-				queued_jobs   .clear() ;
+				WaitingQueues<RsrcsAsk>::clear() ;
+				waiting_jobs.clear() ;
+				queued_jobs .clear() ;
 			}
 			// data
-			::umap<RsrcsAsk,set<PressureEntry>> waiting_queues ;
-			::umap<JobIdx,CoarseDelay         > waiting_jobs   ;
-			::uset<JobIdx                     > queued_jobs    ;         // spawned jobs until start
-			JobIdx                              n_jobs         = 0     ; // manage -j option (if >0 no more than n_jobs can be launched on behalf of this req)
-			bool                                verbose        = false ;
+			::umap<JobIdx,CoarseDelay> waiting_jobs ;
+			::uset<JobIdx            > queued_jobs  ;         // spawned jobs until start
+			JobIdx                     n_jobs       = 0     ; // manage -j option (if >0 no more than n_jobs can be launched on behalf of this req)
+			bool                       verbose      = false ;
 		} ;
 
 		// specialization
@@ -153,6 +142,7 @@ namespace Backends {
 		//
 		virtual bool/*ok*/   fit_eventually( RsrcsDataAsk const&          ) const { return true ; } // true if job with such resources can be spawned eventually
 		virtual bool/*ok*/   fit_now       ( RsrcsAsk     const&          ) const { return true ; } // true if job with such resources can be spawned now
+		virtual Pdate        backfill_date ( RsrcsAsk     const&          ) const { return Pdate::Future ; } // for a job that does not fit now, lower pressure jobs may only be launched if they end before
 		virtual RsrcsData    adapt         ( RsrcsDataAsk const&          ) const = 0 ;             // adapt asked resources to currently available ones
 		virtual ::vmap_ss    export_       ( RsrcsData    const&          ) const = 0 ;             // export resources in   a publicly manageable form
 		virtual RsrcsDataAsk import_       ( ::vmap_ss        && , ReqIdx ) const = 0 ;             // import resources from a publicly manageable form
@@ -162,7 +152,8 @@ namespace Backends {
 		virtual ::pair_s<HeartbeatState> heartbeat_queued_job( JobIdx , SpawnedEntry const&          ) const { return {{},HeartbeatState::Alive} ; } // only called before start
 		virtual void                     kill_queued_job     ( JobIdx , SpawnedEntry const&          ) const = 0 ;                                   // .
 		//
-		virtual SpawnId launch_job( JobIdx , Pdate prio , ::vector_s const& cmd_line   , Rsrcs const& , bool verbose ) const = 0 ;
+		virtual SpawnId                        launch_job         ( JobIdx , Pdate prio , ::vector_s const& cmd_line , Rsrcs const& , bool verbose ) const = 0 ;
+		virtual ::vmap<JobIdx,::string/*err*/> flush_launched_jobs(                                                                                ) const { return {} ; } // called after launch_job for all launched jobs
 
 		// services
 		virtual bool is_local() const {
@@ -198,8 +189,8 @@ namespace Backends {
 			Trace trace(BeChnl,"submit",rsa,pressure) ;
 			//
 			re.waiting_jobs[job] = pressure ;
-			waiting_jobs.emplace( job , WaitingEntry(rsa,submit_attrs,re.verbose) ) ;
-			re.waiting_queues[rsa].insert({pressure,job}) ;
+			waiting_jobs.emplace( job , WaitingEntry(rsa,req,submit_attrs,re.verbose,Job(job)->best_exec_time().first) ) ; // submit is called from engine thread
+			re.insert_waiting(rsa,{pressure,job}) ;
 		}
 		virtual void add_pressure( JobIdx job , ReqIdx req , SubmitAttrs const& submit_attrs ) {
 			Trace trace(BeChnl,"add_pressure",job,req,submit_attrs) ;
@@ -222,24 +213,23 @@ namespace Backends {
 			trace(BeChnl,"adjusted_pressure",pressure) ;
 			//
 			re.waiting_jobs[job] = pressure ;
-			re.waiting_queues[we.rsrcs_ask].insert({pressure,job}) ;                                             // job must be known
+			re.insert_waiting(we.rsrcs_ask,{pressure,job}) ;                                                     // job must be known
 			we.submit_attrs |= submit_attrs ;
 			we.verbose      |= re.verbose   ;
-			we.n_reqs++ ;
+			we.reqs.push_back(req) ;
 		}
 		virtual void set_pressure( JobIdx job , ReqIdx req , SubmitAttrs const& submit_attrs ) {
 			ReqEntry& re = reqs.at(req)           ;                                                              // req must be known to already know job
 			auto      it = waiting_jobs.find(job) ;
 			//
 			if (it==waiting_jobs.end()) return ;                                                                 // job is not waiting anymore, ignore
-			WaitingEntry        & we           = it->second                         ;
-			CoarseDelay         & old_pressure = re.waiting_jobs  .at(job         ) ;                            // job must be known
-			::set<PressureEntry>& q            = re.waiting_queues.at(we.rsrcs_ask) ;                            // including for this req
-			CoarseDelay           pressure     = submit_attrs.pressure              ;
+			WaitingEntry& we           = it->second                 ;
+			CoarseDelay & old_pressure = re.waiting_jobs.at(job)    ;                                            // job must be known, including for this req
+			CoarseDelay   pressure     = submit_attrs.pressure      ;
 			Trace trace(BeChnl,"set_pressure","pressure",pressure) ;
 			we.submit_attrs |= submit_attrs ;
-			q.erase ({old_pressure,job}) ;
-			q.insert({pressure    ,job}) ;
+			re.erase_waiting (we.rsrcs_ask,{old_pressure,job}) ;
+			re.insert_waiting(we.rsrcs_ask,{pressure    ,job}) ;
 			old_pressure = pressure ;
 		}
 	protected :
@@ -292,8 +282,8 @@ namespace Backends {
 				// kill waiting jobs
 				for( auto const& [j,_] : re.waiting_jobs ) {
 					WaitingEntry& we = waiting_jobs.at(j) ;
-					if (we.n_reqs==1) waiting_jobs.erase(j) ;
-					else              we.n_reqs--           ;
+					if (we.reqs.size()==1) waiting_jobs.erase(j) ;
+					else                   ::erase(we.reqs,req)  ;
 					res.push_back(j) ;
 				}
 				re.clear() ;
@@ -322,42 +312,52 @@ namespace Backends {
 			DF}
 			//
 			::vmap<JobIdx,pair_s<vmap_ss/*rsrcs*/>> err_jobs ;
+			Pdate                                   now      = New ;
 			for( auto [req,eta] : Req::s_etas() ) {                                                              // /!\ it is forbidden to dereference req without taking Req::s_reqs_mutex first
 				auto rit = reqs.find(+req) ;
 				if (rit==reqs.end()) continue ;
-				JobIdx                               n_jobs = rit->second.n_jobs         ;
-				::umap<RsrcsAsk,set<PressureEntry>>& queues = rit->second.waiting_queues ;
+				ReqEntry& req_entry = rit->second ;
 				for(;;) {
-					if ( n_jobs && spawned_jobs.size()>=n_jobs ) break ;                                         // cannot have more than n_jobs running jobs because of this req, process next req
-					auto candidate = queues.end() ;
+					if ( req_entry.n_jobs && spawned_jobs.size()>=req_entry.n_jobs ) break ;                     // cannot have more than n_jobs running jobs because of this req, process next req
+					// waiting_heads is ordered by pressure, so the first head that fits is the best candidate
+					// unless it would delay the best job that does not fit, as estimated by backfill_date
+					PressureEntry candidate     {} ;
+					RsrcsAsk      candidate_rsa {} ;
 					if (+rsrcs_ask) {
-						if (fit_now(rsrcs_ask)) candidate = queues.find(rsrcs_ask) ;                             // if we have resources, only consider jobs with same resources
+						if (fit_now(rsrcs_ask))                                                                  // if we have resources, only consider jobs with same resources
+							if ( auto it=req_entry.waiting_queues.find(rsrcs_ask) ; it!=req_entry.waiting_queues.end() ) { candidate = *it->second.begin() ; candidate_rsa = it->first ; }
 					} else {
-						for( auto it=queues.begin() ; it!=queues.end() ; it++ ) {
-							if ( candidate!=queues.end() && it->second.begin()->pressure<=candidate->second.begin()->pressure ) continue ;
-							if ( fit_now(it->first)                                                                           ) candidate = it ;       // continue to find a better candidate
+						Pdate backfill_limit = Pdate::Future ;
+						bool  blocked        = false         ;
+						for( auto const& [pe,rsa] : req_entry.waiting_heads ) {
+							if (!fit_now(rsa)) {
+								if (!blocked) { blocked = true ; backfill_limit = backfill_date(rsa) ; }        // only reserve resources for the best blocked job
+								continue ;
+							}
+							if ( blocked && backfill_limit!=Pdate::Future ) {                                   // no reservation if backfill is not supported or disabled
+								Delay exec_time = waiting_jobs.at(pe.job).exec_time ;
+								if ( !exec_time || now+exec_time>backfill_limit ) continue ;                        // a job of unknown duration could delay blocked job for any time
+							}
+							candidate     = pe  ;
+							candidate_rsa = rsa ;
+							break ;
 						}
 					}
-					if (candidate==queues.end()) break ;                                                                                               // nothing for this req, process next req
+					if (!candidate_rsa) break ;                                                                  // nothing for this req, process next req
 					//
-					::set<PressureEntry>& pressure_set   = candidate->second            ;
-					auto                  pressure_first = pressure_set.begin()         ; SWEAR(pressure_first!=pressure_set.end(),candidate->first) ; // what is this candiate with no pressure ?
-					Pdate                 prio           = eta-pressure_first->pressure ;
-					JobIdx                j              = pressure_first->job          ;
-					auto                  wit            = waiting_jobs.find(j)         ;
-					RsrcsAsk const&       rsrcs_ask      = candidate->first             ;
-					Rsrcs                 rsrcs          { New , adapt(*rsrcs_ask) }    ;
-					::vmap_ss             rsrcs_map      = export_(*rsrcs)              ;
-					bool                  ok             = true                         ;
+					Pdate     prio      = eta-candidate.pressure             ;
+					JobIdx    j         = candidate.job                      ;
+					auto      wit       = waiting_jobs.find(j)               ;
+					Rsrcs     rsrcs     { New , adapt(*candidate_rsa) }      ;
+					::vmap_ss rsrcs_map = export_(*rsrcs)                    ;
+					bool      ok        = true                               ;
 					//
-					::vector<ReqIdx> rs { +req } ;
-					for( auto const& [r,re] : reqs )
-						if ( r==+req ) SWEAR(re.waiting_jobs.find(j)!=re.waiting_jobs.end()) ;
-						else           if   (re.waiting_jobs.find(j)!=re.waiting_jobs.end()) rs.push_back(r) ;
-					::vector_s cmd_line = acquire_cmd_line( T , j , rs , ::move(rsrcs_map) , wit->second.submit_attrs ) ;
+					::vector<ReqIdx> rs       = ::move(wit->second.reqs)                                                           ; // req is among them
+					::vector_s       cmd_line = acquire_cmd_line( T , j , rs , ::move(rsrcs_map) , wit->second.submit_attrs ) ;
 					try {
 						SpawnId id = launch_job( j , prio , cmd_line , rsrcs , wit->second.verbose ) ;
-						spawned_jobs[j] = { .rsrcs=rsrcs , .id=id , .verbose=wit->second.verbose } ;
+						Delay exec_time = wit->second.exec_time ;
+						spawned_jobs[j] = { .rsrcs=rsrcs , .id=id , .verbose=wit->second.verbose , .eta=+exec_time?now+exec_time:Pdate() } ;
 						trace(BeChnl,"child",req,j,prio,id,cmd_line) ;
 					} catch (::string const& e) {
 						err_jobs.push_back({j,{e,rsrcs_map}}) ;
@@ -368,21 +368,20 @@ namespace Backends {
 					for( ReqIdx r : rs ) {
 						ReqEntry& re   = reqs.at(r)              ;
 						auto      wit1 = re.waiting_jobs.find(j) ;
-						if (r!=+req) {
-							auto                  wit2 = re.waiting_queues.find(rsrcs_ask) ;
-							::set<PressureEntry>& pes  = wit2->second                      ;
-							PressureEntry         pe   { wit1->second , j }                ; // /!\ pressure is job pressure for r, not for req
-							SWEAR(pes.contains(pe)) ;
-							if (pes.size()==1) re.waiting_queues.erase(wit2) ;               // last entry for this rsrcs, erase the entire queue
-							else               pes              .erase(pe  ) ;
-						}
+						/**/    re.erase_waiting( candidate_rsa , {wit1->second,j} ) ;                // /!\ pressure is job pressure for r, not for req
 						/**/    re.waiting_jobs.erase (wit1) ;
 						if (ok) re.queued_jobs .insert(j   ) ;
 					}
-					if (pressure_set.size()==1) queues      .erase(candidate     ) ;         // last entry for this rsrcs, erase the entire queue
-					else                        pressure_set.erase(pressure_first) ;
 				}
 			}
+			// jobs that could not be actually submitted are reported as if launch_job had failed
+			for( auto&& [j,e] : flush_launched_jobs() ) {
+				auto sit = spawned_jobs.find(j) ; SWEAR(sit!=spawned_jobs.end(),j) ;
+				trace(BeChnl,"flush_err",j,e) ;
+				err_jobs.push_back({j,{::move(e),export_(*sit->second.rsrcs)}}) ;
+				/**/                       spawned_jobs  .erase(sit) ;
+				for( auto& [r,re] : reqs ) re.queued_jobs.erase(j  ) ;
+			}
 			if(err_jobs.size()>0) throw err_jobs ;
 		}
 
@@ -3,6 +3,7 @@
 // This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
+#include <poll.h>
 #include <sys/sysinfo.h>
 #include <sys/resource.h>
 
@@ -89,6 +90,17 @@ namespace Backends::Local {
 
 	constexpr Tag MyTag = Tag::Local ;
 
+	static constexpr Delay WorkerIdleDelay { 60 } ; // workers idle for longer than this are retired, they are spawned again when needed
+
+	// a worker is a job_exec process waiting for jobs to run, cf. job_exec.cc
+	// it reports through out the pid of a process forked in advance for the next job, and this process is fed with its job assignment through in
+	struct Worker {
+		AutoCloseFd in        ;
+		AutoCloseFd out       ;
+		pid_t       job       = 0 ; // pre-forked job process, 0 until reported
+		Pdate       idle_date ;
+	} ;
+
 	struct LocalBackend : GenericBackend<MyTag,pid_t,RsrcsData,RsrcsDataAsk,true/*IsLocal*/> {
 
 		static void _wait_thread_func( ::stop_token stop , LocalBackend* self ) {
@@ -114,8 +126,16 @@ namespace Backends::Local {
 			return capacity() ;
 		}
 
-		virtual void config( ::vmap_ss const& dct , bool dynamic ) {
-			Trace trace("Local::config",STR(dynamic),dct) ;
+		virtual void config( ::vmap_ss const& dct_ , bool dynamic ) {
+			Trace trace("Local::config",STR(dynamic),dct_) ;
+			::vmap_ss dct ; dct.reserve(dct_.size()) ;                         // resources only
+			for( auto const& [k,v] : dct_ ) {
+				try {
+					if (k=="n_workers") { n_workers = from_string<size_t>(v) ; continue ; }
+					if (k=="backfill" ) { backfill  = from_string<bool  >(v) ; continue ; }
+				} catch (::string const& e) { throw to_string("wrong value for entry ",k," : ",v) ; }
+				dct.emplace_back(k,v) ;
+			}
 			if (dynamic) {
 				/**/                                         if (rsrc_keys.size()!=dct.size()) throw "cannot change resource names while lmake is running"s ;
 				for( size_t i=0 ; i<rsrc_keys.size() ; i++ ) if (rsrc_keys[i]!=dct[i].first  ) throw "cannot change resource names while lmake is running"s ;
@@ -143,7 +163,9 @@ namespace Backends::Local {
 					::setrlimit(RLIMIT_NPROC,&rl) ;
 				}
 			}
-			trace("done") ;
+			_retire_idle_workers() ;                                           // n_workers may have decreased
+			while (_workers.size()<n_workers) _spawn_worker() ;               // pre-fork workers so they are warm when jobs come in
+			trace("done",_workers.size()) ;
 		}
 		virtual ::vmap_s<size_t> const& capacity() const {
 			return public_capacity ;
@@ -155,37 +177,139 @@ namespace Backends::Local {
 		virtual bool/*ok*/   fit_eventually( RsrcsDataAsk const& rsa          ) const { return rsa. fit_in(         capacity_)     ; }
 		virtual bool/*ok*/   fit_now       ( RsrcsAsk     const& rsa          ) const { return rsa->fit_in(occupied,capacity_)     ; }
 		virtual RsrcsData    adapt         ( RsrcsDataAsk const& rsa          ) const { return rsa. within(occupied,capacity_)     ; }
+		// date at which enough running jobs are expected to have ended for rsa to fit, based on their estimated exec time
+		virtual Pdate backfill_date(RsrcsAsk const& rsa) const {
+			if (!backfill) return Pdate::Future ;
+			Pdate                          now  = New ;
+			::vmap<Pdate,RsrcsData const*> ends ; ends.reserve(spawned_jobs.size()) ;
+			for( auto const& [_,se] : spawned_jobs ) ends.emplace_back( ::max(se.eta,now) , &*se.rsrcs ) ; // jobs longer than estimated or of unknown duration are expected to end now, which is conservative
+			::sort(ends) ;
+			RsrcsData occ = occupied ;
+			for( auto const& [eta,rs] : ends ) {
+				occ -= *rs ;
+				if (rsa->fit_in(occ,capacity_)) return eta ;
+			}
+			return Pdate::Future ;                                             // cannot happen as rsa fits eventually, but dont reserve anything if it does
+		}
 		virtual ::vmap_ss    export_       ( RsrcsData    const& rs           ) const { return rs.mk_vmap(rsrc_keys)               ; }
 		virtual RsrcsDataAsk import_       ( ::vmap_ss        && rsa , ReqIdx ) const { return RsrcsDataAsk(::move(rsa),rsrc_idxs) ; }
 		//
 		virtual ::string start_job( JobIdx , SpawnedEntry const& e ) const {
 			return to_string("pid:",e.id) ;
 		}
-		virtual ::pair_s<bool/*retry*/> end_job( JobIdx , SpawnedEntry const& se , Status ) const {
+		virtual ::pair_s<bool/*retry*/> end_job( JobIdx , SpawnedEntry const& se , Status status ) const {
 			occupied -= *se.rsrcs ;
 			Trace trace("end","occupied_rsrcs",'-',occupied) ;
-			_wait_queue.push(se.id) ;                                          // defer wait in case job_exec process does some time consuming book-keeping
+			auto it = _worker_jobs.find(se.id) ;
+			if (it==_worker_jobs.end()) {
+				_wait_queue.push(se.id) ;                                      // defer wait in case job_exec process does some time consuming book-keeping
+			} else {
+				pid_t worker = it->second ;
+				_worker_jobs.erase(it) ;
+				if (is_lost(status)) {
+					_retire_worker(worker) ;                                   // job process may still be around, dont wait for it
+				} else {
+					_workers.at(worker).idle_date = New ;
+					_idle_workers.push_back(worker) ;                          // worker waits for job process, which is about to exit
+				}
+			}
 			return {{},true/*retry*/} ;                                        // retry if garbage
 		}
 		virtual ::pair_s<HeartbeatState> heartbeat_queued_job( JobIdx j , SpawnedEntry const& se ) const { // called after job_exec has had time to start
 			kill_queued_job(j,se) ;                                                                        // ensure job_exec is dead or will die shortly
 			return {{}/*msg*/,HeartbeatState::Lost} ;
 		}
+		virtual void tick() {
+			_retire_idle_workers() ;
+		}
+		using GenericBackend::launch ;
+		virtual void launch( Bool3 go , Rsrcs rsrcs ) {
+			GenericBackend::launch(go,rsrcs) ;
+			if ( !spawned_jobs.size() && !g_config.heartbeat ) _retire_idle_workers(true/*all*/) ; // without heartbeat, nothing retires idle workers until next job, so dont keep them around
+		}
 		virtual void kill_queued_job( JobIdx , SpawnedEntry const& se ) const {
 			kill_process(se.id,SIGHUP) ;                                        // jobs killed here have not started yet, so we just want to kill job_exec
-			_wait_queue.push(se.id) ;                                           // defer wait in case job_exec process does some time consuming book-keeping
+			auto it = _worker_jobs.find(se.id) ;
+			if (it==_worker_jobs.end()) {
+				_wait_queue.push(se.id) ;                                       // defer wait in case job_exec process does some time consuming book-keeping
+			} else {
+				_retire_worker(it->second) ;                                    // connection to server may have been cut in the middle of a message
+				_worker_jobs.erase(it) ;
+			}
 		}
 		virtual pid_t launch_job( JobIdx , Pdate /*prio*/ , ::vector_s const& cmd_line , Rsrcs const& rsrcs , bool /*verbose*/ ) const {
-			Child child { true/*as_session*/ , cmd_line , Child::None , Child::None } ;
-			pid_t pid = child.pid ;
-			child.mk_daemon() ;                                                // we have recorded the pid to wait and there is no fd to close
-			if (pid<0) throw "cannot spawn process"s ;
+			pid_t pid = _launch_by_worker(cmd_line) ;
+			if (pid<0) {
+				Child child { true/*as_session*/ , cmd_line , Child::None , Child::None } ;
+				pid = child.pid ;
+				child.mk_daemon() ;                                            // we have recorded the pid to wait and there is no fd to close
+				if (pid<0) throw "cannot spawn process"s ;
+			}
 			occupied += *rsrcs ;
 			Trace trace("occupied_rsrcs",'+',occupied) ;
 			return pid ;
 		}
 
 	private :
+		void _spawn_worker() const {
+			size_t id = 0 ; while (_workers_ids.contains(id)) id++ ;                                          // ids are only used to name trace files
+			Child child { true/*as_session*/ , worker_cmd_line(MyTag,id) , Child::Pipe , Child::Pipe } ;
+			if (child.pid<0) { Trace("spawn_worker_failed",id) ; return ; }
+			::fcntl( child.stdin  , F_SETFD , FD_CLOEXEC ) ;                                                  // other workers and jobs must not keep our pipes open ...
+			::fcntl( child.stdout , F_SETFD , FD_CLOEXEC ) ;                                                  // ... so that worker sees eof when we close it
+			::fcntl( child.stdin  , F_SETFL , O_NONBLOCK ) ;                                                  // never wait for a worker, a full pipe means it is lost
+			Worker& w = _workers[child.pid] ;
+			w.in        = ::move(child.stdin ) ;
+			w.out       = ::move(child.stdout) ;
+			w.idle_date = New                  ;
+			_workers_ids[id] = child.pid ;
+			_idle_workers.push_back(child.pid) ;
+			Trace("spawn_worker",id,child.pid) ;
+			child.mk_daemon() ;                                                                                // worker is waited by _wait_jobs when retired
+		}
+		void _retire_worker(pid_t worker) const {
+			Trace trace("retire_worker",worker) ;
+			_workers.erase(worker) ;                                                                           // closing pipes tells worker to exit once job process is gone
+			for( auto it=_workers_ids.begin() ; it!=_workers_ids.end() ; it++ ) if (it->second==worker) { _workers_ids.erase(it) ; break ; }
+			::erase(_idle_workers,worker) ;
+			_wait_queue.push(worker) ;
+		}
+		void _retire_idle_workers(bool all=false) const {                                                     // _idle_workers is sorted by idle date
+			Pdate now = New ;
+			while ( +_idle_workers && all                                                              ) _retire_worker(_idle_workers.front()) ;
+			while ( +_idle_workers && _workers.size()>n_workers                                        ) _retire_worker(_idle_workers.front()) ;
+			while ( +_idle_workers && _workers.at(_idle_workers.front()).idle_date+WorkerIdleDelay<now ) _retire_worker(_idle_workers.front()) ;
+		}
+		bool/*ready*/ _worker_ready(Worker& w) const {                                                       // never block, throw if worker is lost
+			if (w.job) return true ;
+			struct ::pollfd pfd { .fd=w.out , .events=POLLIN , .revents=0 } ;
+			if (::poll(&pfd,1,0/*ms*/)<=0) return false ;                                                     // pre-forked job process is not reported yet
+			w.job = IMsgBuf().receive<pid_t>(w.out) ;                                                         // pid is written atomically, so it is entirely available
+			if (w.job<0) throw "cannot fork"s ;
+			return true ;
+		}
+		pid_t _launch_by_worker(::vector_s const& cmd_line) const {                                           // return -1 if no worker is ready
+			_retire_idle_workers() ;
+			if ( !_idle_workers && _workers.size()<n_workers ) _spawn_worker() ;                              // replace retired workers, it is ready for next jobs
+			for( size_t i=_idle_workers.size() ; i>0 ; i-- ) {                                                // prefer recently used workers so that others may retire
+				pid_t   worker = _idle_workers[i-1]   ;
+				Worker& w      = _workers.at(worker) ;
+				try {
+					if (!_worker_ready(w)) continue ;
+					OMsgBuf().send( w.in , ::vector_s{cmd_line[2]/*seq_id*/,cmd_line[3]/*job*/,cmd_line[5]/*trace_file*/} ) ; // cf. acquire_cmd_line, pipe is empty, so this cannot block
+					pid_t pid = w.job ;
+					w.job = 0 ;
+					_idle_workers.erase(_idle_workers.begin()+(i-1)) ;
+					_worker_jobs[pid] = worker ;
+					Trace("launch_by_worker",worker,pid) ;
+					return pid ;
+				} catch (::string const& e) {
+					Trace("lost_worker",worker,e) ;
+					_retire_worker(worker) ;                                                                   // only removes entry i-1 from _idle_workers, which we do not visit again
+				}
+			}
+			return -1 ;
+		}
 		void _wait_jobs(::stop_token stop) {                                   // execute in a separate thread
 			Trace trace("_wait_jobs",MyTag) ;
 			for(;;) {
@@ -204,8 +328,14 @@ namespace Backends::Local {
 		RsrcsData         capacity_       ;
 		RsrcsData mutable occupied        ;
 		::vmap_s<size_t>  public_capacity ;
+		size_t            n_workers       = 0     ;                          // 0 means jobs are launched by spawning a job_exec process
+		bool              backfill        = false ;                          // if true, lower pressure jobs are launched only if they do not delay a job that does not fit
 	private :
-		ThreadQueue<pid_t> mutable _wait_queue ;
+		ThreadQueue<pid_t>         mutable _wait_queue   ;
+		::umap<pid_t,Worker>       mutable _workers      ;
+		::map<size_t,pid_t>        mutable _workers_ids  ;                   // id -> worker
+		::vector<pid_t>            mutable _idle_workers ;
+		::umap<pid_t/*job*/,pid_t> mutable _worker_jobs  ;                   // job process -> worker running it
 
 	} ;
 
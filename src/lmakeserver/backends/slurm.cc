@@ -24,9 +24,45 @@ namespace Backends::Slurm {
 	struct Daemon {
 		friend ::ostream& operator<<( ::ostream& , Daemon const& ) ;
 		// data
-		Pdate           time_origin { "2023-01-01 00:00:00" } ; // this leaves room til 2091
-		float           nice_factor { 1                     } ; // conversion factor in the form of number of nice points per second
-		::map_s<size_t> licenses    ;                           // licenses sampled from daemon
+		Pdate           time_origin  { "2023-01-01 00:00:00" } ; // this leaves room til 2091
+		float           nice_factor  { 1                     } ; // conversion factor in the form of number of nice points per second
+		uint32_t        max_array_sz = 1                       ; // max number of tasks in a job array (MaxArraySize in slurm config), 1 means no arrays
+		::map_s<size_t> licenses     ;                           // licenses sampled from daemon
+	} ;
+
+	//
+	// job ids
+	//
+
+	struct SlurmId {
+		friend ::ostream& operator<<( ::ostream& , SlurmId const& ) ;
+		static constexpr uint32_t NoTask = -1 ;
+		// accesses
+		bool operator==(SlurmId const&) const = default ;
+		bool is_array() const { return task!=NoTask ; }
+		// data
+		uint32_t job  = 0      ; // slurm job id, or array job id for array tasks
+		uint32_t task = NoTask ; // task id within array
+	} ;
+
+	// snapshot of the records of all our jobs, obtained with a single request to slurm controller
+	// there is no destructor : msg is freed when reloaded, freeing it at exit would call libslurm during static destruction, after it may have been torn down
+	struct JobStates : ::umap<uint32_t/*job or array job*/,::vector<slurm_job_info_t const*>> {
+		using Base = ::umap<uint32_t,::vector<slurm_job_info_t const*>> ;
+		// services
+		void load (::string const& key) ; // only records of jobs whose name starts with key are retained
+		void clear(                   ) ;
+		// data
+		Pdate           date ;            // date at which snapshot was taken
+		job_info_msg_t* msg  = nullptr ;  // records point inside msg
+	} ;
+
+	struct LaunchEntry {                                    // a job launched but not yet submitted to slurm
+		JobIdx     job      = 0     ;
+		uint32_t   id       = 0     ;                       // lmake side id, returned by launch_job
+		int32_t    nice     = 0     ;
+		::vector_s cmd_line ;
+		bool       verbose  = false ;
 	} ;
 
 	//
@@ -90,16 +126,17 @@ namespace Backends::Slurm {
 
 	using p_cxxopts = ::unique_ptr<cxxopts::Options> ;
 
-	void slurm_init() ;
+	void slurm_init(::string const& lib_slurm) ;
 
 	p_cxxopts                 create_parser     (                        ) ;
 	RsrcsData                 parse_args        (::string const& args    ) ;
-	void                      slurm_cancel      (uint32_t        slurm_id) ;
-	::pair_s<Bool3/*job_ok*/> slurm_job_state   (uint32_t        slurm_id) ;
+	void                      slurm_cancel      (SlurmId         slurm_id) ;
+	::pair_s<Bool3/*job_ok*/> slurm_job_state   (SlurmId         slurm_id) ;
+	::pair_s<Bool3/*job_ok*/> slurm_job_state   (SlurmId         slurm_id , ::vector<slurm_job_info_t const*> const& records) ;
 	::string                  read_stderr       (JobIdx                  ) ;
 	Daemon                    slurm_sense_daemon(                        ) ;
 	//
-	uint32_t slurm_spawn_job( ::string const& key , JobIdx , int32_t nice , ::vector_s const& cmd_line , RsrcsData const& rsrcs , bool verbose ) ;
+	uint32_t slurm_spawn_jobs( ::string const& key , ::vector<LaunchEntry> const& , RsrcsData const& rsrcs ) ; // jobs are submitted as an array if several
 
 	p_cxxopts g_optParse = create_parser() ;
 
@@ -132,7 +169,7 @@ namespace Backends::Slurm {
 		}
 
 		// static data
-		static QueueThread<uint32_t>* _s_slurm_cancel_thread ; // when a req is killed, a lot of queued jobs may be canceled, better to do it in a separate thread
+		static QueueThread<SlurmId>* _s_slurm_cancel_thread ; // when a req is killed, a lot of queued jobs may be canceled, better to do it in a separate thread
 
 		// accesses
 
@@ -143,13 +180,12 @@ namespace Backends::Slurm {
 
 		virtual void config( vmap_ss const& dct , bool dynamic ) {
 			Trace trace(BeChnl,"Slurm::config",STR(dynamic),dct) ;
-			if (!dynamic) slurm_init() ;
-			static QueueThread<uint32_t> slurm_cancel_thread{'C',slurm_cancel} ; _s_slurm_cancel_thread = &slurm_cancel_thread ;
 			//
 			repo_key = base_name(*g_root_dir)+':' ; // cannot put this code directly as init value as g_root_dir is not available early enough
 			for( auto const& [k,v] : dct ) {
 				try {
 					switch (k[0]) {
+						case 'l' : if(k=="lib_slurm"        ) { lib_slurm         =                       v  ; continue ; } break ;
 						case 'n' : if(k=="n_max_queued_jobs") { n_max_queued_jobs = from_string<uint32_t>(v) ; continue ; } break ;
 						case 'r' : if(k=="repo_key"         ) { repo_key          =                       v  ; continue ; } break ;
 						case 'u' : if(k=="use_nice"         ) { use_nice          = from_string<bool    >(v) ; continue ; } break ;
@@ -158,6 +194,8 @@ namespace Backends::Slurm {
 				} catch (::string const& e) { trace("bad_val",k,v) ; throw to_string("wrong value for entry "   ,k,": ",v) ; }
 				/**/                        { trace("bad_key",k  ) ; throw to_string("unexpected config entry: ",k       ) ; }
 			}
+			if (!dynamic) slurm_init(lib_slurm) ;
+			static QueueThread<SlurmId> slurm_cancel_thread{'C',slurm_cancel} ; _s_slurm_cancel_thread = &slurm_cancel_thread ;
 			if (!dynamic) daemon = slurm_sense_daemon() ;
 			trace("done") ;
 		}
@@ -205,22 +243,23 @@ namespace Backends::Slurm {
 		}
 		virtual ::string start_job( JobIdx , SpawnedEntry const& se ) const {
 			spawned_rsrcs.dec(se.rsrcs) ;
-			return to_string("slurm_id:",se.id) ;
+			return to_string("slurm_id:",slurm_ids.at(se.id)) ;
 		}
 		virtual ::pair_s<bool/*retry*/> end_job( JobIdx j , SpawnedEntry const& se , Status s ) const {
+			SlurmId sid = _pop_slurm_id(se.id) ;
 			if ( !se.verbose && s>Status::Async ) return {{},true/*retry*/} ;                           // common case, must be fast, if job was ended asynchronously, better to ask slurm controler why
 			::pair_s<Bool3/*job_ok*/> info ;
 			for( int c=0 ; c<2 ; c++ ) {
 				Delay d { 0.01 }                                              ;
 				Pdate e = Pdate(New) + ::max(g_config.network_delay,Delay(1)) ; // ensure a reasonable minimum
 				for( Pdate c = New ;; c+=d ) {
-					info = slurm_job_state(se.id) ;
+					info = slurm_job_state(sid) ;
 					if (info.second!=Maybe) goto JobDead ;
 					if (c>=e              ) break        ;
 					d.sleep_for() ;                                             // wait, hoping job is dying, double delay every loop until hearbeat tick
 					d = ::min( d+d , g_config.heartbeat_tick ) ;
 				}
-				if (c==0) _s_slurm_cancel_thread->push(se.id) ;                 // if still alive after network delay, (asynchronously as faster and no return value) cancel job and retry
+				if (c==0) _s_slurm_cancel_thread->push(sid) ;                   // if still alive after network delay, (asynchronously as faster and no return value) cancel job and retry
 			}
 			info.first = "job is still alive" ;
 		JobDead :
@@ -230,10 +269,19 @@ namespace Backends::Slurm {
 			}
 			return { info.first , info.second!=No } ;
 		}
+		// heartbeat is called for each queued job in turn, answer from a snapshot taken at most once per heartbeat round rather than asking the controller for each job
 		virtual ::pair_s<HeartbeatState> heartbeat_queued_job( JobIdx j , SpawnedEntry const& se ) const {
-			::pair_s<Bool3/*job_ok*/> info = slurm_job_state(se.id) ;
+			SlurmId sid = slurm_ids.at(se.id) ;
+			Pdate   now { New }               ;
+			if (now>snapshot.date+g_config.heartbeat) {
+				snapshot.load(repo_key) ;
+				snapshot.date = now ;                                                                  // even if load failed, so as not to overload controller
+			}
+			auto                      it   = snapshot.find(sid.job)                                                       ;
+			::pair_s<Bool3/*job_ok*/> info = it==snapshot.end() ? slurm_job_state(sid) : slurm_job_state(sid,it->second) ; // if not in snapshot (e.g. too recent), ask controller
 			if (info.second==Maybe) return {{}/*msg*/,HeartbeatState::Alive} ;
 			//
+			_pop_slurm_id(se.id) ;
 			if (se.verbose) {
 				::string stderr = read_stderr(j) ;
 				if (+stderr) { set_nl(info.first) ; info.first += stderr ; }
@@ -243,28 +291,63 @@ namespace Backends::Slurm {
 			else                  return { info.first , HeartbeatState::Err  } ;
 		}
 		virtual void kill_queued_job( JobIdx , SpawnedEntry const& se ) const {
-			_s_slurm_cancel_thread->push(se.id) ;                               // asynchronous (as faster and no return value) cancel
+			_s_slurm_cancel_thread->push(_pop_slurm_id(se.id)) ;                                         // asynchronous (as faster and no return value) cancel
 			spawned_rsrcs.dec(se.rsrcs) ;
 		}
+		// jobs are only recorded here and actually submitted in flush_launched_jobs, so that jobs with identical resources are submitted as a single job array
 		virtual uint32_t/*id*/ launch_job( JobIdx j , Pdate prio , ::vector_s const& cmd_line , Rsrcs const& rs , bool verbose ) const {
 			int32_t nice = use_nice ? int32_t((prio-daemon.time_origin).sec()*daemon.nice_factor) : 0 ;
 			nice &= 0x7fffffff ;                                                                         // slurm will not accept negative values, default values overflow in ... 2091
-			uint32_t id = slurm_spawn_job( repo_key , j , nice , cmd_line , *rs , verbose ) ;
+			uint32_t id = next_id++ ;
 			Trace trace(BeChnl,"Slurm::launch_job",repo_key,j,id,nice,cmd_line,rs,STR(verbose)) ;
-			spawned_rsrcs.inc(rs) ;                                                                      // only reserv resources once we are sure job is launched
+			launch_batches[rs].push_back({ .job=j , .id=id , .nice=nice , .cmd_line=cmd_line , .verbose=verbose }) ;
+			spawned_rsrcs.inc(rs) ;                                                                      // reserve resources right away so that fit_now sees batched jobs
 			return id ;
 		}
+		virtual ::vmap<JobIdx,::string/*err*/> flush_launched_jobs() const {
+			::vmap<JobIdx,::string/*err*/> res ;
+			for( auto& [rs,les] : launch_batches ) {
+				size_t max_sz = rs->size()==1 ? ::max(daemon.max_array_sz,uint32_t(1)) : 1 ;           // heterogeneous jobs cannot be submitted as arrays
+				for( size_t i=0 ; i<les.size() ; i+=max_sz ) {
+					::vector<LaunchEntry> batch { ::make_move_iterator(les.begin()+i) , ::make_move_iterator(les.begin()+::min(i+max_sz,les.size())) } ;
+					try {
+						uint32_t sid = slurm_spawn_jobs( repo_key , batch , *rs ) ;
+						Trace trace(BeChnl,"Slurm::flush_launched_jobs",sid,batch.size()) ;
+						if (batch.size()==1) slurm_ids[batch[0].id] = {.job=sid} ;                     // a single job is submitted as a plain job
+						else                 for( uint32_t t=0 ; t<batch.size() ; t++ ) slurm_ids[batch[t].id] = {.job=sid,.task=t} ;
+					} catch (::string const& e) {
+						for( LaunchEntry const& le : batch ) {
+							spawned_rsrcs.dec(rs) ;
+							res.emplace_back(le.job,e) ;
+						}
+					}
+				}
+			}
+			launch_batches.clear() ;
+			return res ;
+		}
+		SlurmId _pop_slurm_id(uint32_t id) const {
+			auto    it  = slurm_ids.find(id) ; SWEAR(it!=slurm_ids.end(),id) ;
+			SlurmId res = it->second         ;
+			slurm_ids.erase(it) ;
+			return res ;
+		}
 
 		// data
-		SpawnedMap mutable  spawned_rsrcs     ;         // number of spawned jobs queued in slurm queue
-		::vector<RsrcsData> req_forces        ;         // indexed by req, resources forced by req
-		uint32_t            n_max_queued_jobs = -1    ; // no limit by default
-		bool                use_nice          = false ;
-		::string            repo_key          ;         // a short identifier of the repository
-		Daemon              daemon            ;         // info sensed from slurm daemon
+		SpawnedMap mutable                           spawned_rsrcs     ;                   // number of spawned jobs queued in slurm queue
+		::umap<Rsrcs,::vector<LaunchEntry>> mutable launch_batches    ;                   // jobs launched but not submitted yet, by resources
+		::umap<uint32_t,SlurmId>            mutable slurm_ids         ;                   // indexed by id returned by launch_job
+		JobStates                           mutable snapshot          ;                   // used to answer heartbeats
+		uint32_t                            mutable next_id           = 0               ;
+		::vector<RsrcsData>                         req_forces        ;                   // indexed by req, resources forced by req
+		uint32_t                                    n_max_queued_jobs = -1              ; // no limit by default
+		bool                                        use_nice          = false           ;
+		::string                                    repo_key          ;                   // a short identifier of the repository
+		::string                                    lib_slurm         = "libslurm.so"   ; // may be set to a stand-in library exporting the same symbols, e.g. for tests
+		Daemon                                      daemon            ;                   // info sensed from slurm daemon
 	} ;
 
-	QueueThread<uint32_t>* SlurmBackend::_s_slurm_cancel_thread ;
+	QueueThread<SlurmId>* SlurmBackend::_s_slurm_cancel_thread ;
 
 	//
 	// init
@@ -277,7 +360,17 @@ namespace Backends::Slurm {
 	//
 
 	::ostream& operator<<( ::ostream& os , Daemon const& d ) {
-		return os << "Daemon(" << d.time_origin <<','<< d.nice_factor <<','<< d.licenses <<')' ;
+		return os << "Daemon(" << d.time_origin <<','<< d.nice_factor <<','<< d.max_array_sz <<','<< d.licenses <<')' ;
+	}
+
+	//
+	// SlurmId
+	//
+
+	::ostream& operator<<( ::ostream& os , SlurmId const& si ) {
+		/**/               os <<      si.job  ;
+		if (si.is_array()) os <<'_'<< si.task ;
+		return             os                 ;
 	}
 
 	//
@@ -382,39 +475,43 @@ namespace Backends::Slurm {
 		decltype(::slurm_free_submit_response_response_msg)* free_submit_response_response_msg = nullptr/*garbage*/ ;
 		decltype(::slurm_init_job_desc_msg                )* init_job_desc_msg                 = nullptr/*garbage*/ ;
 		decltype(::slurm_kill_job                         )* kill_job                          = nullptr/*garbage*/ ;
+		decltype(::slurm_kill_job2                        )* kill_job2                         = nullptr/*garbage*/ ;
 		decltype(::slurm_load_ctl_conf                    )* load_ctl_conf                     = nullptr/*garbage*/ ;
 		decltype(::slurm_list_append                      )* list_append                       = nullptr/*garbage*/ ;
 		decltype(::slurm_list_create                      )* list_create                       = nullptr/*garbage*/ ;
 		decltype(::slurm_list_destroy                     )* list_destroy                      = nullptr/*garbage*/ ;
 		decltype(::slurm_load_job                         )* load_job                          = nullptr/*garbage*/ ;
+		decltype(::slurm_load_job_user                    )* load_job_user                     = nullptr/*garbage*/ ;
 		decltype(::slurm_strerror                         )* strerror                          = nullptr/*garbage*/ ;
 		decltype(::slurm_submit_batch_het_job             )* submit_batch_het_job              = nullptr/*garbage*/ ;
 		decltype(::slurm_submit_batch_job                 )* submit_batch_job                  = nullptr/*garbage*/ ;
 	}
 
-	static constexpr char LibSlurm[] = "libslurm.so" ;
-	template<class T> void _load_func( void* handler , T*& dst , const char* name ) {
+	// all accesses to slurm go through SlurmApi, so that libslurm.so may be replaced by any library exporting the same symbols (lib_slurm config entry)
+	template<class T> void _load_func( void* handler , ::string const& lib , T*& dst , const char* name ) {
 		dst = reinterpret_cast<T*>(::dlsym(handler,name)) ;
-		if (!dst) throw to_string("cannot find ",name," in ",LibSlurm) ;
+		if (!dst) throw to_string("cannot find ",name," in ",lib) ;
 	}
-	void slurm_init() {
-		Trace trace(BeChnl,"slurm_init") ;
-		void* handler = ::dlopen(LibSlurm,RTLD_NOW|RTLD_GLOBAL) ;
-		if (!handler) throw to_string("cannot find ",LibSlurm) ;
+	void slurm_init(::string const& lib) {
+		Trace trace(BeChnl,"slurm_init",lib) ;
+		void* handler = ::dlopen(lib.c_str(),RTLD_NOW|RTLD_GLOBAL) ;
+		if (!handler) throw to_string("cannot find ",lib) ;
 		//
-		_load_func( handler , SlurmApi::free_ctl_conf                     , "slurm_free_ctl_conf"                     ) ;
-		_load_func( handler , SlurmApi::free_job_info_msg                 , "slurm_free_job_info_msg"                 ) ;
-		_load_func( handler , SlurmApi::free_submit_response_response_msg , "slurm_free_submit_response_response_msg" ) ;
-		_load_func( handler , SlurmApi::init_job_desc_msg                 , "slurm_init_job_desc_msg"                 ) ;
-		_load_func( handler , SlurmApi::kill_job                          , "slurm_kill_job"                          ) ;
-		_load_func( handler , SlurmApi::load_ctl_conf                     , "slurm_load_ctl_conf"                     ) ;
-		_load_func( handler , SlurmApi::list_append                       , "slurm_list_append"                       ) ;
-		_load_func( handler , SlurmApi::list_create                       , "slurm_list_create"                       ) ;
-		_load_func( handler , SlurmApi::list_destroy                      , "slurm_list_destroy"                      ) ;
-		_load_func( handler , SlurmApi::load_job                          , "slurm_load_job"                          ) ;
-		_load_func( handler , SlurmApi::strerror                          , "slurm_strerror"                          ) ;
-		_load_func( handler , SlurmApi::submit_batch_het_job              , "slurm_submit_batch_het_job"              ) ;
-		_load_func( handler , SlurmApi::submit_batch_job                  , "slurm_submit_batch_job"                  ) ;
+		_load_func( handler , lib , SlurmApi::free_ctl_conf                     , "slurm_free_ctl_conf"                     ) ;
+		_load_func( handler , lib , SlurmApi::free_job_info_msg                 , "slurm_free_job_info_msg"                 ) ;
+		_load_func( handler , lib , SlurmApi::free_submit_response_response_msg , "slurm_free_submit_response_response_msg" ) ;
+		_load_func( handler , lib , SlurmApi::init_job_desc_msg                 , "slurm_init_job_desc_msg"                 ) ;
+		_load_func( handler , lib , SlurmApi::kill_job                          , "slurm_kill_job"                          ) ;
+		_load_func( handler , lib , SlurmApi::kill_job2                         , "slurm_kill_job2"                         ) ;
+		_load_func( handler , lib , SlurmApi::load_ctl_conf                     , "slurm_load_ctl_conf"                     ) ;
+		_load_func( handler , lib , SlurmApi::list_append                       , "slurm_list_append"                       ) ;
+		_load_func( handler , lib , SlurmApi::list_create                       , "slurm_list_create"                       ) ;
+		_load_func( handler , lib , SlurmApi::list_destroy                      , "slurm_list_destroy"                      ) ;
+		_load_func( handler , lib , SlurmApi::load_job                          , "slurm_load_job"                          ) ;
+		_load_func( handler , lib , SlurmApi::load_job_user                     , "slurm_load_job_user"                     ) ;
+		_load_func( handler , lib , SlurmApi::strerror                          , "slurm_strerror"                          ) ;
+		_load_func( handler , lib , SlurmApi::submit_batch_het_job              , "slurm_submit_batch_het_job"              ) ;
+		_load_func( handler , lib , SlurmApi::submit_batch_job                  , "slurm_submit_batch_job"                  ) ;
 		trace("done") ;
 	}
 
@@ -488,14 +585,16 @@ namespace Backends::Slurm {
 		return res ;
 	}
 
-	void slurm_cancel(uint32_t slurm_id) {
+	void slurm_cancel(SlurmId slurm_id) {
 		//This for loop with a retry comes from the scancel Slurm utility code
 		//Normally we kill mainly waiting jobs, but some "just started jobs" could be killed like that also
 		//Running jobs are killed by lmake/job_exec
 		Trace trace(BeChnl,"slurm_cancel",slurm_id) ;
-		int i   = 0/*garbage*/ ;
+		int      i      = 0/*garbage*/                                     ;
+		::string id_str = slurm_id.is_array() ? to_string(slurm_id) : ""s ; // array tasks can only be designated by a string of the form job_task
 		for( i=0 ; i<10/*MAX_CANCEL_RETRY*/ ; i++ ) {
-			if (SlurmApi::kill_job(slurm_id,SIGKILL,KILL_FULL_JOB)==SLURM_SUCCESS) { trace("done") ; return ; }
+			int rc = slurm_id.is_array() ? SlurmApi::kill_job2(id_str.c_str(),SIGKILL,KILL_FULL_JOB,nullptr/*sibling*/) : SlurmApi::kill_job(slurm_id.job,SIGKILL,KILL_FULL_JOB) ;
+			if (rc==SLURM_SUCCESS) { trace("done") ; return ; }
 			switch (errno) {
 				case ESLURM_INVALID_JOB_ID             :
 				case ESLURM_ALREADY_DONE               : trace("already_dead",errno) ;                return ;
@@ -507,16 +606,30 @@ namespace Backends::Slurm {
 		FAIL("cannot cancel job ",slurm_id," after ",i," retries : ",slurm_err()) ;
 	}
 
-	::pair_s<Bool3/*job_ok*/> slurm_job_state(uint32_t slurm_id) {                                                                           // Maybe means job has not completed
+	::pair_s<Bool3/*job_ok*/> slurm_job_state(SlurmId slurm_id) {                                                                            // Maybe means job has not completed
 		Trace trace(BeChnl,"slurm_job_state",slurm_id) ;
 		job_info_msg_t* resp = nullptr/*garbage*/ ;
 		//
-		if (SlurmApi::load_job(&resp,slurm_id,SHOW_LOCAL)!=SLURM_SUCCESS) return { "cannot load job info : "+slurm_err() , Yes/*job_ok*/ } ; // no info on job -> retry
+		if (SlurmApi::load_job(&resp,slurm_id.job,SHOW_LOCAL)!=SLURM_SUCCESS) return { "cannot load job info : "+slurm_err() , Yes/*job_ok*/ } ; // no info on job -> retry
+		//
+		::vector<slurm_job_info_t const*> records ; for ( uint32_t i=0 ; i<resp->record_count ; i++ ) records.push_back(&resp->job_array[i]) ;
+		::pair_s<Bool3/*job_ok*/>         res     = slurm_job_state(slurm_id,records)                                                          ;
+		SlurmApi::free_job_info_msg(resp) ;
+		return res ;
+	}
+
+	::pair_s<Bool3/*job_ok*/> slurm_job_state( SlurmId slurm_id , ::vector<slurm_job_info_t const*> const& records ) {                        // Maybe means job has not completed
+		// for array tasks, only consider the records of the task, or the record of the not yet split array if task has no record of its own
+		uint32_t task = NO_VAL ;
+		if (slurm_id.is_array())
+			for ( slurm_job_info_t const* jip : records )
+				if (jip->array_task_id==slurm_id.task) { task = slurm_id.task ; break ; }
 		//
 		bool completed = true ;                                                                                                              // job is completed if all tasks are
-		for ( uint32_t i=0 ; i<resp->record_count ; i++ ) {
-			slurm_job_info_t const& ji = resp->job_array[i]                          ;
+		for ( slurm_job_info_t const* jip : records ) {
+			slurm_job_info_t const& ji = *jip                                        ;
 			job_states              js = job_states( ji.job_state & JOB_STATE_BASE ) ;
+			if ( slurm_id.is_array() && ji.array_task_id!=task ) continue ;
 			//
 			completed &= js>=JOB_COMPLETE ;
 			if (js<=JOB_COMPLETE) continue ;                                                                                                 // we only search errors
@@ -545,10 +658,32 @@ namespace Backends::Slurm {
 				default : FAIL("Slurm: wrong job state return for job (",slurm_id,"): ",js) ;
 			}
 		}
-		SlurmApi::free_job_info_msg(resp) ;
 		return { {} , Maybe|completed } ;
 	}
 
+	void JobStates::clear() {
+		Base::clear() ;
+		if (msg) SlurmApi::free_job_info_msg(msg) ;
+		msg = nullptr ;
+	}
+
+	void JobStates::load(::string const& key) {
+		Trace trace(BeChnl,"JobStates::load",key) ;
+		clear() ;
+		if (SlurmApi::load_job_user(&msg,::getuid(),SHOW_LOCAL)!=SLURM_SUCCESS) {                                                              // a single request for all our jobs
+			trace("err",slurm_err()) ;
+			msg = nullptr ;                                                                                                                    // without snapshot, heartbeats fall back to per job requests
+			return ;
+		}
+		for ( uint32_t i=0 ; i<msg->record_count ; i++ ) {
+			slurm_job_info_t const& ji = msg->job_array[i]                                                      ;
+			if ( !ji.name || !::string_view(ji.name).starts_with(key) ) continue ;                                                              // not an lmake job from this repo
+			uint32_t                id = ji.array_job_id ? ji.array_job_id : ji.het_job_id ? ji.het_job_id : ji.job_id ;                    // array tasks and het components are designated by their leader
+			(*this)[id].push_back(&ji) ;
+		}
+		trace("done",size()) ;
+	}
+
 	static ::string _get_log_dir    (JobIdx job) { return Job(job)->ancillary_file(AncillaryTag::Backend) ; }
 	static ::string _get_stderr_path(JobIdx job) { return _get_log_dir(job) + "/stderr"                   ; }
 	static ::string _get_stdout_path(JobIdx job) { return _get_log_dir(job) + "/stdout"                   ; }
@@ -566,29 +701,53 @@ namespace Backends::Slurm {
 	}
 
 	static ::string _cmd_to_string(::vector_s const& cmd_line) {
-		::string res = "#!/bin/sh" ;
-		char sep = '\n' ;
-		for ( ::string const& s : cmd_line ) { append_to_string(res,sep,s) ; sep = ' ' ; }
-		res += '\n' ;
+		::string res ;
+		char sep = 0 ;
+		for ( ::string const& s : cmd_line ) { if (sep) res += sep ; res += s ; sep = ' ' ; }
 		return res ;
 	}
-	uint32_t slurm_spawn_job( ::string const& key , JobIdx job , int32_t nice , ::vector_s const& cmd_line , RsrcsData const& rsrcs , bool verbose ) {
+	// a single job is submitted as is, several jobs are submitted as an array whose script selects the command line from the task id
+	static ::string _mk_script( ::vector<LaunchEntry> const& les ) {
+		::string res = "#!/bin/sh\n" ;
+		if (les.size()==1) {
+			append_to_string(res,_cmd_to_string(les[0].cmd_line),'\n') ;
+		} else {
+			res += "case $SLURM_ARRAY_TASK_ID in\n" ;
+			for( size_t t=0 ; t<les.size() ; t++ ) {
+				append_to_string(res,'\t',t,") ",_cmd_to_string(les[t].cmd_line)) ;
+				if (les[t].verbose) append_to_string(res," >",mk_shell_str(_get_stdout_path(les[t].job))," 2>",mk_shell_str(_get_stderr_path(les[t].job))) ;
+				res += " ;;\n" ;
+			}
+			res += "esac\n" ;
+		}
+		return res ;
+	}
+	uint32_t slurm_spawn_jobs( ::string const& key , ::vector<LaunchEntry> const& les , RsrcsData const& rsrcs ) {
 		static char* env[1] = {const_cast<char *>("")} ;
-		Trace trace(BeChnl,"slurm_spawn_job",key,job,nice,cmd_line,rsrcs,STR(verbose)) ;
+		Trace trace(BeChnl,"slurm_spawn_jobs",key,les.size(),rsrcs) ;
 		//
 		SWEAR(rsrcs.size()> 0) ;
-		SWEAR(nice        >=0) ;
+		SWEAR(les  .size()> 0) ;
+		SWEAR( les.size()==1 || rsrcs.size()==1 , les.size() , rsrcs.size() ) ;                       // heterogeneous jobs cannot be submitted as arrays
 		//
-		::string                 wd        = *g_root_dir              ;
-		auto                     job_name  = key + Job(job)->name()   ;
-		::string                 script    = _cmd_to_string(cmd_line) ;
+		bool    is_array = les.size()>1                ;
+		bool    verbose  = !is_array && les[0].verbose ;                                               // for arrays, stdout & stderr are redirected by script
+		int32_t nice     = les[0].nice                 ;
+		for( LaunchEntry const& le : les ) {
+			SWEAR(le.nice>=0) ;
+			nice = ::min(nice,le.nice) ;                                                               // a single nice value for the whole array : take the most urgent
+			if (le.verbose) mkdir(_get_log_dir(le.job)) ;
+		}
+		::string                 wd        = *g_root_dir                                                                ;
+		::string                 job_name  = is_array ? to_string(key,les.size(),"_jobs") : key+Job(les[0].job)->name() ;
+		::string                 script    = _mk_script(les)                                                            ;
+		::string                 array_inx = is_array ? to_string("0-",les.size()-1) : ""s                              ;
 		::string                 s_errPath ;
 		::string                 s_outPath ;
-		::vector<job_desc_msg_t> job_descr { rsrcs.size() }           ;
-		if(verbose) {
-			s_errPath = _get_stderr_path(job) ;
-			s_outPath = _get_stdout_path(job) ;
-			mkdir(_get_log_dir(job)) ;
+		::vector<job_desc_msg_t> job_descr { rsrcs.size() }                                                             ;
+		if (verbose) {
+			s_errPath = _get_stderr_path(les[0].job) ;
+			s_outPath = _get_stdout_path(les[0].job) ;
 		}
 		for( uint32_t i=0 ; RsrcsDataSingle const& r : rsrcs ) {
 			job_desc_msg_t* j = &job_descr[i] ;
@@ -613,6 +772,7 @@ namespace Backends::Slurm {
 			if(+r.qos     ) j->qos           = const_cast<char*>(r.qos           .data()) ;
 			if(+r.reserv  ) j->reservation   = const_cast<char*>(r.reserv        .data()) ;
 			if(i==0       ) j->script        =                   script          .data()  ;
+			if(is_array   ) j->array_inx     =                   array_inx       .data()  ;
 			/**/            j->nice          = NICE_OFFSET+nice                           ;
 			i++ ;
 		}
@@ -639,11 +799,14 @@ namespace Backends::Slurm {
 		Trace trace(BeChnl,"slurm_sense_daemon") ;
 		slurm_conf_t* conf = nullptr ;
 		// XXX : remember last conf read so as to pass a real update_time param & optimize call
-		if (!is_target("/etc/slurm/slurm.conf")                           ) throw "no slurm config file /etc/slur/slurm.conf"s          ;
-		if (SlurmApi::load_ctl_conf(0/*update_time*/,&conf)!=SLURM_SUCCESS) throw to_string("cannot reach slurm daemon : ",slurm_err()) ;
+		if (SlurmApi::load_ctl_conf(0/*update_time*/,&conf)!=SLURM_SUCCESS) {                                                         // only check config file on error as a stand-in lib may not need it
+			if (!is_target("/etc/slurm/slurm.conf")) throw "no slurm config file /etc/slur/slurm.conf"s          ;
+			/**/                                     throw to_string("cannot reach slurm daemon : ",slurm_err()) ;
+		}
 		SWEAR(conf) ;
 		Daemon res ;
 		trace("conf",STR(conf)) ;
+		res.max_array_sz = ::max(conf->max_array_sz,uint32_t(1)) ;                                    // 0 means arrays are disabled
 		if (conf->priority_params) {
 			static ::string const to_mrkr  = "time_origin=" ;
 			static ::string const npd_mrkr = "nice_factor=" ;
@@ -0,0 +1,59 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include "config.hh"
+#include "time.hh"
+
+// this file only depends on basic libs so that it can be exercised standalone, cf. waiting_queues_test.cc
+
+namespace Backends {
+
+	struct PressureEntry {
+		// services
+		bool              operator== (PressureEntry const&      ) const = default ;
+		::strong_ordering operator<=>(PressureEntry const& other) const {
+			if (pressure!=other.pressure) return other.pressure<=>pressure  ; // higher pressure first
+			else                          return job           <=>other.job ;
+		}
+		// data
+		Time::CoarseDelay pressure ;
+		JobIdx            job      ;
+	} ;
+
+	// waiting jobs are queued by asked resources, each queue being ordered by pressure
+	// as there may be a lot of different resources, the head of each queue is indexed so that best candidates are found without walking through all queues
+	template<class RsrcsAsk> struct WaitingQueues {
+		// services
+		void clear() {
+			waiting_queues.clear() ;
+			waiting_heads .clear() ;
+		}
+		void insert_waiting( RsrcsAsk const& rsa , PressureEntry const& pe ) {
+			::set<PressureEntry>& q = waiting_queues[rsa] ;
+			if (!q) {
+				waiting_heads.try_emplace(pe,rsa) ;
+			} else if (pe<*q.begin()) {
+				waiting_heads.erase(*q.begin()) ;
+				waiting_heads.try_emplace(pe,rsa) ;
+			}
+			q.insert(pe) ;
+		}
+		void erase_waiting( RsrcsAsk const& rsa , PressureEntry const& pe ) {
+			auto                  it = waiting_queues.find(rsa) ; SWEAR(it!=waiting_queues.end()) ;
+			::set<PressureEntry>& q  = it->second               ; SWEAR(q.contains(pe)          ) ;
+			if (pe!=*q.begin()) { q.erase(pe) ; return ; }                                        // head is unchanged
+			waiting_heads.erase(pe) ;
+			q            .erase(pe) ;
+			if (+q) waiting_heads .try_emplace(*q.begin(),rsa) ;
+			else    waiting_queues.erase      (it            ) ;                                  // last entry for this rsrcs, erase the entire queue
+		}
+		// data
+		::umap<RsrcsAsk,set<PressureEntry>> waiting_queues ;
+		::map <PressureEntry,RsrcsAsk     > waiting_heads  ; // first entry of each waiting queue, ordered by pressure
+	} ;
+
+}
@@ -0,0 +1,87 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+// micro-benchmark of waiting queues as used by GenericBackend::launch, with synthetic job indices and resources
+
+#include "waiting_queues.hh"
+
+using namespace Backends ;
+using namespace Time     ;
+
+using Rsrcs = uint32_t ;                                     // stands for RsrcsAsk, only hashing and comparing are needed
+
+static constexpr JobIdx NJobs   = 1'000'000 ;
+static constexpr Rsrcs  NRsrcs  = 1'000     ;
+static constexpr JobIdx NNaive  = 10'000    ;                // former algorithm walks all queues for each launch, measure it on a limited number of launches
+
+static uint64_t g_rand = 1 ;
+static uint32_t _rand() {                                    // deterministic so that runs are comparable
+	g_rand = g_rand*6364136223846793005ull + 1442695040888963407ull ;
+	return g_rand>>33 ;
+}
+
+static Rsrcs         _rsrcs   (JobIdx j) { return j%NRsrcs                                           ; }
+static bool          _fit_now (Rsrcs  r) { return r%4                                                ; } // a quarter of resources never fit, so that heads are skipped
+static PressureEntry _pressure(JobIdx j) { return { CoarseDelay(Delay(double(_rand()%100'000)/10)) , j } ; }
+
+static void _report( const char* what , Pdate start , JobIdx n ) {
+	Delay d = Pdate(New)-start ;
+	::cout << ::setw(12)<<::left<<what <<" : "<< d.short_str() <<" for "<< n <<" ops ("<< double(d)*1e9/n <<"ns/op)\n" ;
+}
+
+int main() {
+	WaitingQueues<Rsrcs>  wq        ;
+	::vector<CoarseDelay> pressures ( NJobs ) ;
+	//
+	Pdate start = New ;
+	for( JobIdx j=0 ; j<NJobs ; j++ ) {
+		PressureEntry pe = _pressure(j) ;
+		pressures[j] = pe.pressure ;
+		wq.insert_waiting(_rsrcs(j),pe) ;
+	}
+	_report( "insert" , start , NJobs ) ;
+	SWEAR( wq.waiting_heads.size()==NRsrcs , wq.waiting_heads.size() ) ;
+	//
+	start = New ;
+	for( JobIdx j=0 ; j<NJobs ; j+=10 ) {                    // set_pressure on 10% of jobs
+		PressureEntry pe = _pressure(j) ;
+		wq.erase_waiting (_rsrcs(j),{pressures[j],j}) ;
+		wq.insert_waiting(_rsrcs(j),pe              ) ;
+		pressures[j] = pe.pressure ;
+	}
+	_report( "set_pressure" , start , NJobs/10 ) ;
+	//
+	start = New ;
+	for( JobIdx i=0 ; i<NNaive ; i++ ) {                     // former algorithm : walk all queues and keep the best fitting head
+		PressureEntry best     { .pressure={} , .job=NJobs } ;
+		bool          found    = false ;
+		for( auto const& [r,q] : wq.waiting_queues ) if ( _fit_now(r) && (!found||*q.begin()<best) ) { best = *q.begin() ; found = true ; }
+		SWEAR(found) ;
+		SWEAR( best==wq.waiting_heads.begin()->first || !_fit_now(wq.waiting_heads.begin()->second) ) ; // sanity check only, queues are not modified
+	}
+	_report( "naive_find" , start , NNaive ) ;
+	//
+	JobIdx n_launched = 0 ;
+	start = New ;
+	for( bool only_fit : {true,false} ) {                   // launch jobs that fit, then all remaining ones as if resources were freed
+		PressureEntry last {} ;
+		bool          first = true ;
+		for(;;) {
+			auto it = wq.waiting_heads.begin() ;
+			if (only_fit) while ( it!=wq.waiting_heads.end() && !_fit_now(it->second) ) it++ ;
+			if (it==wq.waiting_heads.end()) break ;
+			auto [pe,r] = *it ;
+			SWEAR( first || last<pe , last.job , pe.job ) ;  // jobs are launched by decreasing pressure
+			wq.erase_waiting(r,pe) ;
+			last  = pe    ;
+			first = false ;
+			n_launched++ ;
+		}
+	}
+	_report( "launch" , start , n_launched ) ;
+	SWEAR( n_launched==NJobs , n_launched ) ;
+	SWEAR( !wq.waiting_queues && !wq.waiting_heads ) ;
+	return 0 ;
+}
@@ -7,7 +7,8 @@
 
 #include <grp.h>
 
-#include "caches/dir_cache.hh"                                                 // PER_CACHE : add include line for each cache method
+#include "caches/daemon_cache.hh"                                              // PER_CACHE : add include line for each cache method
+#include "caches/dir_cache.hh"                                                 // .
 
 namespace Caches {
 
@@ -21,12 +22,17 @@ namespace Caches {
 		for( auto const& [key,config] : configs ) {
 			Cache* cache = nullptr/*garbage*/ ;
 			switch (config.tag) {
-				case Tag::None : cache = new Cache    ; break ;                // base class Cache actually caches nothing
-				case Tag::Dir  : cache = new DirCache ; break ;                // PER_CACHE : add a case for each cache method
+				case Tag::None   : cache = new Cache       ; break ;             // base class Cache actually caches nothing
+				case Tag::Dir    : cache = new DirCache    ; break ;             // PER_CACHE : add a case for each cache method
+				case Tag::Daemon : cache = new DaemonCache ; break ;             // .
 			DF}
 			cache->config(config) ;
 			s_tab.emplace(key,cache) ;
 		}
 	}
 
+	void Cache::s_flush() {
+		for( auto const& [_,cache] : s_tab ) cache->flush() ;
+	}
+
 }
@@ -26,7 +26,7 @@ namespace Caches {
 		using Id = ::string ;
 
 		struct Match {
-			bool           completed = true  ;             //                            if false <=> answer is delayed and an action will be post to the main loop when ready
+			bool           completed = true  ;             //                            if false <=> answer is delayed and an EngineClosureCache will be posted to the main loop when ready, match is then called again
 			Bool3          hit       = No    ;             // if completed
 			::vector<Node> new_deps  = {}    ;             // if completed&&hit==Maybe : deps that were not done and need to be done before answering hit/miss
 			Id             id        = {}    ;             // if completed&&hit==Yes   : an id to easily retrieve matched results when calling download
@@ -34,6 +34,7 @@ namespace Caches {
 
 		// statics
 		static void s_config(::map_s<Config::Cache> const&) ;
+		static void s_flush () ;                                                                                         // wait for background uploads before exiting
 		//
 		// static data
 		static ::map_s<Cache*> s_tab ;
@@ -45,6 +46,8 @@ namespace Caches {
 		virtual Match      match   ( Job , Req                                                   ) { return { .completed=true , .hit=No } ; }
 		virtual JobDigest  download( Job , Id        const& , JobReason const& , Disk::NfsGuard& ) { FAIL() ;                               } // no download possible since we never match
 		virtual bool/*ok*/ upload  ( Job , JobDigest const& ,                    Disk::NfsGuard& ) { return false ;                         }
+		virtual void       forget  ( Req , Job={}                                                ) {}                                         // forget delayed match results of req (for job if provided) that will not be consumed
+		virtual void       flush   (                                                             ) {}
 
 	} ;
 
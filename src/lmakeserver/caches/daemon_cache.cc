@@ -0,0 +1,347 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+// a cache accessed through lcache_server, which owns a cache dir in the DirCache format
+//	- the daemon does all accesses to the cache dir, hence there is no need for the repo to see it, nor to lock it across NFS
+//	- match : job dirs are sent in batches on a dedicated connection without waiting for replies, a thread collects replies in order
+//	          the returned match trees are walked in the engine thread, exactly as for DirCache
+//	- download/upload : handled in order by a transfer thread on another connection, target contents are streamed rather than held in memory
+//	          uploads are fire and forget : targets are checked against their sig after being sent and the upload is aborted if they were modified
+//	          downloads are started when a match hits and staged in the repo, the job is woken up and finds the staged result through match
+//	          hence the engine thread never waits for the server
+
+#include "daemon_cache.hh"
+
+using namespace Disk ;
+
+namespace Caches {
+
+	::ostream& operator<<( ::ostream& os , CacheRpcReq const& crr ) {
+		/**/                                 os << "CacheRpcReq(" << crr.proc ;
+		switch (crr.proc) {
+			case CacheRpcProc::Match    : os <<','<< crr.job_dirs                              ; break ;
+			case CacheRpcProc::Download : os <<','<< crr.jn                                    ; break ;
+			case CacheRpcProc::Upload   : os <<','<< crr.jn <<','<< crr.repo <<','<< crr.targets.size() ; break ;
+			default : ;
+		}
+		return                               os <<')' ;
+	}
+
+	::ostream& operator<<( ::ostream& os , CacheRpcReply const& crr ) {
+		/**/                                 os << "CacheRpcReply(" << crr.proc ;
+		switch (crr.proc) {
+			case CacheRpcProc::Match    : os <<','<< crr.trees.size()                          ; break ;
+			case CacheRpcProc::Download : os <<','<< STR(crr.ok) <<','<< crr.err <<','<< crr.targets.size() ; break ;
+			case CacheRpcProc::Upload   : os <<','<< STR(crr.ok)                               ; break ;
+			default : ;
+		}
+		return                               os <<')' ;
+	}
+
+	void DaemonCache::config(Config::Cache const& config) {
+		::map_ss dct = mk_map(config.dct) ;
+		//
+		Hash::Xxh repo_hash ;
+		if (dct.contains("repo")) repo_hash.update(dct.at("repo")) ; else throw "repo not found"s ;
+		repo = "repo-"+::string(repo_hash.digest()) ;                                                         // same as DirCache so entries are shared with direct accesses
+		//
+		if      (dct.contains("service")) service = dct.at("service") ;
+		else if (dct.contains("dir"    )) {
+			::string   mrkr       = to_string(dct.at("dir"),'/',CacheServerMrkr) ;
+			::ifstream mrkr_stream { mrkr }                                      ;
+			if (!::getline(mrkr_stream,service)) throw to_string("cannot find cache server in ",mrkr," (consider : lcache_server ",dct.at("dir"),')') ;
+		} else {
+			throw "service not found"s ;
+		}
+		_staging_dir = to_string(PrivateAdminDir,"/cache_download/",service) ;
+		unlnk( _staging_dir , true/*dir_ok*/ ) ;                                                              // clean up downloads left by a previous run
+		try {
+			_fd       = ClientSockFd(service) ; _fd      .no_std() ;
+			_match_fd = ClientSockFd(service) ; _match_fd.no_std() ;
+		} catch (::string const& e) {
+			throw to_string("cannot connect to cache server ",service," : ",e) ;
+		}
+	}
+
+	void DaemonCache::_start_threads() {
+		if (+_match_threads) return ;
+		_match_threads.emplace_back( [this](::stop_token stop)->void { _match_send_thread_func(stop) ; } ) ;
+		_match_threads.emplace_back( [this](::stop_token stop)->void { _match_recv_thread_func(stop) ; } ) ;
+		_transfer_thread = ::jthread( [this](::stop_token stop)->void { _transfer_thread_func(stop) ; } ) ;
+	}
+
+	void DaemonCache::flush() {
+		if (!_transfer_thread.joinable()) return ;
+		_transfer_thread.request_stop() ;                                                                     // transfer thread only stops once its queue is empty
+		_transfer_thread.join() ;
+	}
+
+	void DaemonCache::_match_send_thread_func(::stop_token stop) {
+		t_thread_key = 'K' ;
+		Trace trace("DaemonCache::_match_send_thread_func") ;
+		for(;;) {
+			auto [popped,entry] = _match_queue.pop(stop) ;
+			if (!popped) break ;
+			::vector<MatchEntry> batch { ::move(entry) } ;
+			while (batch.size()<MaxMatchBatch) {                                                              // gather all pending matches in a single request
+				auto [popped_,entry_] = _match_queue.try_pop() ;
+				if (!popped_) break ;
+				batch.push_back(::move(entry_)) ;
+			}
+			CacheRpcReq req { .proc=CacheRpcProc::Match } ;
+			for( MatchEntry const& e : batch ) req.job_dirs.push_back(e.jn) ;
+			trace("send",req) ;
+			if (!_match_lost)
+				try                       { OMsgBuf().send(_match_fd,req) ;            }
+				catch (::string const& e) { trace("lost",e) ; _match_lost = true ; }
+			_match_sent.emplace(::move(batch)) ;                                                                 // if lost, recv thread answers with misses without reading
+		}
+		trace("done") ;
+	}
+
+	void DaemonCache::_match_recv_thread_func(::stop_token stop) {
+		t_thread_key = 'K' ;
+		Trace trace("DaemonCache::_match_recv_thread_func") ;
+		for(;;) {
+			auto [popped,batch] = _match_sent.pop(stop) ;
+			if (!popped) break ;
+			CacheRpcReply reply ;
+			if (!_match_lost)
+				try                       { reply = IMsgBuf().receive<CacheRpcReply>(_match_fd) ; }
+				catch (::string const& e) { trace("lost",e) ; _match_lost = true ;               }
+			if (reply.trees.size()!=batch.size()) {
+				trace("bad_reply",reply,batch.size()) ;
+				reply.trees.clear() ;
+				reply.trees.resize(batch.size()) ;                                                            // all entries miss
+			}
+			{	Lock lock { _match_mutex } ;
+				for( size_t i=0 ; i<batch.size() ; i++ ) _match_results[{batch[i].job,batch[i].req}] = ::move(reply.trees[i]) ;
+			}
+			for( MatchEntry const& e : batch ) g_engine_queue.emplace(e.job,e.req) ;                          // wake up jobs, which will call match again and find results
+		}
+		trace("done") ;
+	}
+
+	void DaemonCache::_transfer_thread_func(::stop_token stop) {
+		t_thread_key = 'K' ;
+		Trace trace("DaemonCache::_transfer_thread_func") ;
+		for(;;) {
+			auto [popped,transfer] = _transfer_queue.pop(stop) ;
+			if (!popped) break ;
+			switch (transfer.proc) {
+				case CacheRpcProc::Download : _do_download(::move(transfer)) ; break ;
+				case CacheRpcProc::Upload   : _do_upload  (::move(transfer)) ; break ;
+			DF}
+		}
+		trace("done") ;
+	}
+
+	void DaemonCache::_unlnk_staged(Downloaded const& dl) {
+		for( ::string const& f : dl.staged ) if (+f) unlnk(f) ;
+	}
+
+	// any error on _fd leaves the stream in an unknown state : do not try to resynchronize, just stop using server
+	void DaemonCache::_do_download(Transfer&& transfer) {
+		static ::atomic<uint64_t> s_seq = 0 ;
+		Trace trace("DaemonCache::_do_download",transfer.job,transfer.req,transfer.jn) ;
+		CacheRpcReply reply  ;
+		::vector_s    staged ;
+		try {
+			if (!_fd) throw "lost connection"s ;
+			try {
+				OMsgBuf().send( _fd , CacheRpcReq{ .proc=CacheRpcProc::Download , .jn=transfer.jn } ) ;
+				reply = IMsgBuf().receive<CacheRpcReply>(_fd) ;
+				if (reply.proc!=CacheRpcProc::Download                                          ) throw "protocol error"s ;
+				if (reply.ok && reply.targets.size()!=reply.job_info.end.end.digest.targets.size()) throw "protocol error"s ;
+				if (reply.ok)
+					for( DirCache::EntryTarget const& et : reply.targets ) {
+						::string& s = staged.emplace_back() ;
+						if ( et.tag!=FileTag::Reg && et.tag!=FileTag::Exe ) continue ;
+						s = to_string(_staging_dir,'/',s_seq++) ;
+						AutoCloseFd wfd = open_write( s , false/*append*/ , et.tag==FileTag::Exe ) ;
+						if (!wfd                                ) throw to_string("cannot create ",s) ;
+						if (!DirCache::s_recv_content(_fd,wfd)) { reply.ok = false ; reply.err = "aborted by cache server" ; break ; } // stream is still in sync
+					}
+			} catch (::string const& e) {
+				trace("lost",e) ;
+				_fd.close() ;
+				throw to_string("lost connection to cache server ",service," : ",e) ;
+			}
+		} catch (::string const& e) {
+			reply.ok  = false ;
+			reply.err = e     ;
+		}
+		trace("done",STR(reply.ok),reply.err) ;
+		Downloaded dl { .ok=reply.ok , .job_info=::move(reply.job_info) , .targets=::move(reply.targets) , .staged=::move(staged) } ;
+		if (!dl.ok) { _unlnk_staged(dl) ; dl = {} ; }
+		{	Lock lock { _match_mutex } ;
+			Downloaded& entry = _download_results[{transfer.job,transfer.req}] ;
+			_unlnk_staged(entry) ;                                                                            // in case a previous result was not consumed
+			entry = ::move(dl) ;
+		}
+		g_engine_queue.emplace(transfer.job,transfer.req) ;                                                   // wake up job, which will call match again and find result
+	}
+
+	void DaemonCache::_do_upload(Transfer&& transfer) {
+		Trace trace("DaemonCache::_do_upload",transfer.jn) ;
+		if (!_fd) { trace("lost") ; return ; }
+		CacheRpcReq req { .proc=CacheRpcProc::Upload , .jn=::move(transfer.jn) , .repo=repo , .job_info=::move(transfer.job_info) , .targets=::move(transfer.targets) } ;
+		try {
+			OMsgBuf().send(_fd,req) ;
+			::vmap_s<TargetDigest> const& tds = req.job_info.end.end.digest.targets ;
+			for( NodeIdx ti=0 ; ti<req.targets.size() ; ti++ ) {
+				FileTag tag = req.targets[ti].tag ;
+				if ( tag!=FileTag::Reg && tag!=FileTag::Exe ) continue ;
+				::string const& tn  = tds[ti].first      ;
+				AutoCloseFd     rfd = open_read(tn)      ;
+				if (+rfd) DirCache::s_send_content(_fd,rfd) ;
+				bool ok = +rfd && FileSig(tn)==transfer.sigs[ti] ;                                              // target may have been rewritten since checked in engine thread, or while being sent
+				DirCache::s_send_end(_fd,ok) ;
+				if (!ok) { trace("modified",tn) ; break ; }                                                    // server stops reading upon abort
+			}
+			CacheRpcReply reply = IMsgBuf().receive<CacheRpcReply>(_fd) ;
+			if (reply.proc!=CacheRpcProc::Upload) throw "protocol error"s ;
+			trace("done",STR(reply.ok)) ;
+		} catch (::string const& e) {
+			trace("lost",e) ;
+			_fd.close() ;
+		}
+	}
+
+	Cache::Match DaemonCache::match( Job job , Req req ) {
+		Trace trace("DaemonCache::match",job,req) ;
+		MatchTree tree  ;
+		bool      ready = false ;
+		{	Lock lock { _match_mutex } ;
+			if ( auto it=_download_results.find({job,req}) ; it!=_download_results.end() ) {
+				if (it->second.ok) {
+					trace("downloaded") ;
+					return { .completed=true , .hit=Yes , .id{to_string(size_t(+req))} } ;                      // result is left for download
+				}
+				_download_results.erase(it) ;
+				trace("download_failed") ;
+				return { .completed=true , .hit=No } ;
+			}
+			if ( auto it=_match_results.find({job,req}) ; it!=_match_results.end() ) {
+				tree  = ::move(it->second) ;
+				ready = true               ;
+				_match_results.erase(it) ;
+			}
+		}
+		if (!ready) {
+			if (_match_lost) {
+				trace("lost") ;
+				return { .completed=true , .hit=No } ;
+			}
+			_start_threads() ;
+			_match_queue.emplace( MatchEntry{ .job=job , .req=req , .jn=DirCache::s_job_dir(job) } ) ;
+			trace("delayed") ;
+			return { .completed=false } ;
+		}
+		Match res = DirCache::s_match(tree,req) ;
+		if (res.hit!=Yes) return res ;
+		_transfer_queue.emplace( Transfer{ .proc=CacheRpcProc::Download , .job=job , .req=req , .jn=to_string(DirCache::s_job_dir(job),'/',res.id) } ) ;
+		trace("downloading",res.id) ;
+		return { .completed=false } ;
+	}
+
+	void DaemonCache::forget( Req req , Job job ) {
+		Lock lock { _match_mutex } ;
+		if (+job) {
+			_match_results.erase({job,req}) ;
+			if ( auto it=_download_results.find({job,req}) ; it!=_download_results.end() ) { _unlnk_staged(it->second) ; _download_results.erase(it) ; }
+		} else {
+			::erase_if( _match_results    , [&](auto const& jr_t)->bool { return jr_t.first.second==req ; } ) ;
+			::erase_if( _download_results , [&](auto const& jr_d)->bool {
+				if (jr_d.first.second!=req) return false ;
+				_unlnk_staged(jr_d.second) ;
+				return true ;
+			} ) ;
+		}
+	}
+
+	// download only moves staged contents in place, actual transfer has been done by transfer thread
+	JobDigest DaemonCache::download( Job job , Id const& id , JobReason const& reason , NfsGuard& nfs_guard ) {
+		Req req { from_string<ReqIdx>(id) } ;
+		Trace trace("DaemonCache::download",job,req) ;
+		Downloaded dl ;
+		{	Lock lock { _match_mutex } ;
+			auto it = _download_results.find({job,req}) ;
+			if (it==_download_results.end()) throw "no downloaded result"s ;
+			dl = ::move(it->second) ;
+			_download_results.erase(it) ;
+		}
+		//
+		JobInfo&                job_info = dl.job_info                     ;
+		::vmap_s<TargetDigest>& targets  = job_info.end.end.digest.targets ;
+		::vector_s              copied   ;
+		try {
+			for( NodeIdx ti=0 ; ti<targets.size() ; ti++ ) {
+				auto&                        [tn,td] = targets[ti]    ;
+				DirCache::EntryTarget const& et      = dl.targets[ti] ;
+				copied.push_back(tn) ;
+				nfs_guard.change(tn) ;
+				unlnk(tn) ;
+				switch (et.tag) {
+					case FileTag::None : break ;
+					case FileTag::Reg  :
+					case FileTag::Exe  :
+						if (::rename( dl.staged[ti].c_str() , dir_guard(tn).c_str() )!=0) throw to_string("cannot move ",dl.staged[ti]," to ",tn) ;
+						dl.staged[ti].clear() ;                                                                  // consumed
+					break ;
+					case FileTag::Lnk : lnk( tn , et.content ) ; break ;
+				DF}
+				td.sig = FileSig(tn) ;                                                                       // target digest is not stored in cache
+			}
+			// update some info
+			job_info.start.pre_start.job       = +job   ;                                                   // id is not stored in cache
+			job_info.start.submit_attrs.reason = reason ;
+			job_info.end.end.digest.end_date   = New    ;                                                   // date must be after files are copied
+			job->write_job_info(job_info) ;
+			trace("done") ;
+			return job_info.end.end.digest ;
+		} catch(::string const& e) {
+			for( ::string const& f : copied ) unlnk(f) ;                                                    // clean up partial job
+			_unlnk_staged(dl) ;
+			trace("failed") ;
+			throw e ;
+		}
+	}
+
+	// upload only checks targets, actual transfer is done by transfer thread
+	bool/*ok*/ DaemonCache::upload( Job job , JobDigest const& digest , NfsGuard& nfs_guard ) {
+		Trace trace("DaemonCache::upload",job) ;
+		Transfer transfer { .proc=CacheRpcProc::Upload , .jn=DirCache::s_job_dir(job) } ;
+		if (!DirCache::s_upload_info(job,transfer.job_info)) {
+			trace("not_cachable") ;
+			return false/*ok*/ ;
+		}
+		if (digest.targets.size()!=transfer.job_info.end.end.digest.targets.size()) {                       // daemon relies on job info to know targets
+			trace("inconsistent_targets") ;
+			return false/*ok*/ ;
+		}
+		try {
+			for( auto const& [tn,td] : digest.targets ) {
+				FileInfo               fi { nfs_guard.access(tn) }       ;
+				DirCache::EntryTarget& et = transfer.targets.emplace_back() ;
+				if ( td.crc.valid() && td.crc.is_reg() && td.crc!=Crc::Empty && fi.sig()!=td.sig ) {         // crc would not be the content key
+					trace("modified",tn) ;
+					return false/*ok*/ ;
+				}
+				et.tag = fi.tag() ;
+				if (et.tag==FileTag::Lnk) et.content = read_lnk(tn) ;
+				transfer.sigs.push_back(fi.sig()) ;
+			}
+		} catch (::string const& e) {
+			trace("failed",e) ;
+			return false/*ok*/ ;
+		}
+		_start_threads() ;
+		_transfer_queue.emplace(::move(transfer)) ;
+		trace("queued") ;
+		return true/*ok*/ ;
+	}
+
+}
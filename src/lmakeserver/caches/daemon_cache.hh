@@ -0,0 +1,103 @@
+// This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+// Copyright (c) 2023 Doliam
+// This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+// This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+#pragma once
+
+#include "dir_cache.hh"
+
+ENUM( CacheRpcProc
+,	None
+,	Match
+,	Download
+,	Upload
+)
+
+namespace Caches {
+
+	// protocol between DaemonCache and lcache_server
+	// each connection carries a stream of requests, each answered in order by a reply, so that requests can be pipelined
+	// regular target contents are not part of messages, they are streamed in target order (cf DirCache::s_send_content) :
+	//	- for Upload   : after the request, the first aborted content ends the request
+	//	- for Download : after the reply if ok, the first aborted content ends the reply
+	static constexpr char CacheServerMrkr[] = ADMIN_DIR "/server" ;        // within cache dir, contains service and pid of running daemon
+
+	struct CacheRpcReq {
+		friend ::ostream& operator<<( ::ostream& , CacheRpcReq const& ) ;
+		using Proc = CacheRpcProc ;
+		// data
+		Proc                            proc     = Proc::None ;
+		::vector_s                      job_dirs = {}         ;             // if proc==Match    : a batch of job dirs
+		::string                        jn       = {}         ;             // if proc==Download : entry, if proc==Upload : job dir
+		::string                        repo     = {}         ;             // if proc==Upload
+		JobInfo                         job_info = {}         ;             // if proc==Upload
+		::vector<DirCache::EntryTarget> targets  = {}         ;             // if proc==Upload   : in the same order as job_info targets, reg contents follow
+	} ;
+
+	struct CacheRpcReply {
+		friend ::ostream& operator<<( ::ostream& , CacheRpcReply const& ) ;
+		using Proc = CacheRpcProc ;
+		// data
+		Proc                            proc     = Proc::None ;
+		bool                            ok       = false      ;             // if proc==Download|Upload
+		::string                        err      = {}         ;             // if proc==Download && !ok
+		::vector<DirCache::MatchTree>   trees    = {}         ;             // if proc==Match    : in the same order as job_dirs
+		JobInfo                         job_info = {}         ;             // if proc==Download
+		::vector<DirCache::EntryTarget> targets  = {}         ;             // if proc==Download : in the same order as job_info targets, reg contents follow
+	} ;
+
+	struct DaemonCache : Cache {                                           // PER_CACHE : inherit from Cache and provide implementation
+		using MatchEntry = DirCache::MatchEntry ;
+		using MatchTree  = DirCache::MatchTree  ;
+		static constexpr size_t MaxMatchBatch = 128 ;                      // max number of job dirs sent in a single match request
+		struct Transfer {                                                  // a download or upload, handled by transfer thread
+			CacheRpcProc                    proc     = {} ;
+			Job                             job      = {} ;                // if proc==Download
+			Req                             req      = {} ;                // if proc==Download
+			::string                        jn       = {} ;                // if proc==Download : entry, if proc==Upload : job dir
+			JobInfo                         job_info = {} ;                // if proc==Upload
+			::vector<DirCache::EntryTarget> targets  = {} ;                // if proc==Upload
+			::vector<FileSig>               sigs     = {} ;                // if proc==Upload   : sig of targets when checked in engine thread, content is rejected if modified
+		} ;
+		struct Downloaded {                                                // result of a download, targets are staged in repo until job is actually downloaded
+			bool                            ok       = false ;
+			JobInfo                         job_info = {}    ;
+			::vector<DirCache::EntryTarget> targets  = {}    ;
+			::vector_s                      staged   = {}    ;             // for each target, staged file if reg
+		} ;
+		// services
+		virtual void config(Config::Cache const&) ;
+		//
+		virtual Match      match   ( Job , Req                                                   ) ;
+		virtual JobDigest  download( Job , Id        const& , JobReason const& , Disk::NfsGuard& ) ;
+		virtual bool/*ok*/ upload  ( Job , JobDigest const& ,                    Disk::NfsGuard& ) ;
+		virtual void       forget  ( Req , Job={}                                                ) ;
+		virtual void       flush   (                                                             ) ;
+	private :
+		void _start_threads() ;
+		void _match_send_thread_func(::stop_token) ;
+		void _match_recv_thread_func(::stop_token) ;
+		void _transfer_thread_func  (::stop_token) ;
+		void _do_download(Transfer&&) ;
+		void _do_upload  (Transfer&&) ;
+		void _unlnk_staged(Downloaded const&) ;
+		// data
+		::string       repo         ;
+		::string       service      ;
+		::string       _staging_dir ;                                      // where downloaded contents are received, within repo so they can be moved in place
+		AutoCloseFd    _fd          ;                                      // for download and upload, only accessed by transfer thread
+		AutoCloseFd    _match_fd    ;                                      // for match, requests are pipelined
+		::atomic<bool> _match_lost  = false ;                              // if true, connection for match is lost and all matches miss
+		//
+		ThreadQueue<MatchEntry>             _match_queue      ;
+		ThreadQueue<::vector<MatchEntry>>   _match_sent       ;            // batches sent and waiting for their reply, in order
+		ThreadQueue<Transfer>               _transfer_queue   ;
+		Mutex<MutexLvl::Cache>              _match_mutex      ;
+		::map<::pair<Job,Req>,MatchTree >   _match_results    ;            // protected by _match_mutex, filled by recv thread    , consumed by engine thread
+		::map<::pair<Job,Req>,Downloaded>   _download_results ;            // protected by _match_mutex, filled by transfer thread, consumed by engine thread
+		::vector<::jthread>                 _match_threads    ;            // ensure threads are last so other fields are constructed when they start
+		::jthread                           _transfer_thread  ;            // .
+	} ;
+
+}
@@ -4,66 +4,95 @@
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
 // cache format :
-//	- Lru contains
-//		- prev : more recently used entry. For most  recently used, contains head. For head, contains least recently used entry.
-//		- next : less recently used entry. For least recently used, contanis head. For head, contains most  recently used entry.
-//		- sz   : size of the entry. For head, total size of the cache.
 //	- global info :
-//		- LMAKE/lru : head
+//		- LMAKE/lru       : an mmapped index holding the lru list, as a doubly linked list of LruEntry's, with the overall cache size in its header
+//		- LMAKE/lru_names : the names of the entries referenced by the index
+//		- the lru list is manipulated in O(1) under the global lock (on the cache dir), and only for the time necessary to do so
 //	- job_dir : <job>/<repo_crc> where :
 //		- <job> is made after its name with suffixes replaced by readable suffixes and rule idx by rule crc
 //		- <repo_crc> is computed after the repo as indicated in config.repo
+//	- each job has a match tree in <job>/match merging the deps of all its repo variants (cf. MatchTree), updated upon upload and eviction
 //	- each job has :
-//		- lru info  in <job_dir>/lru
-//		- meta-data in <job_dir>/data (the content of job.ancillary_file() with dep crc's instead of dep dates)
+//		- lru idx   in <job_dir>/lru (the index of its LruEntry in LMAKE/lru)
+//		- meta-data in <job_dir>/data (the job info of the job with dep crc's instead of dep dates)
 //		- deps crcs in <job_dir>/deps (in same order as in meta-data)
+//		- blobs     in <job_dir>/blobs (the codec used to store entry, then for each target, the blob it is a hard link to, or empty if it is a private copy)
 //		- data in <job_dir>/<target_id>
 //			- target_id is the index of target as seen in meta-data
 //			- may be a regular file or a link
+//	- blobs : LMAKE/blobs/<key[0:2]>/<key[2:]>[-x][.<codec>] where :
+//		- <key> is the target crc or its 128 bits digest if config.blob_key is xxh128 and -x is added for executable files
+//		- <codec> is the codec used to compress blob, if any
+//		- blobs are shared between all entries that have a target with this content, entry targets are hard links to them
+//		- a blob whose link count drops to 1 is no more referenced and is removed
+//	- compression : if config.compress is set, meta-data and regular targets (entry data and blobs) are stored compressed
+//		- deps and match tree are not compressed as they are small and read at each match
+//		- size accounting is based on compressed sizes
+//	- size accounting : lru sz is the sum of entry sizes (meta-data) plus the size of all blobs
+//	- LMAKE/tmp : contents streamed to lcache_server and entries being uploaded are staged there (compressed) before being moved into place
+//	- locking :
+//		- the global lock protects the lru index and blobs
+//		- each entry is protected by a lock on its dir : downloads hold it shared while copying data, so that hits on different entries do not serialize
+//		- eviction only tries to lock entries and spares those that are being downloaded
+
+#include <linux/fs.h>  // FICLONE
+#include <sys/ioctl.h>
 
 #include "dir_cache.hh"
 
+#if HAS_ZLIB
+	#include <zlib.h>
+#endif
+#if HAS_ZSTD
+	#include <zstd.h>
+#endif
+
 using namespace Disk ;
 
 namespace Caches {
 
-	// START_OF_VERSIONING
-
-	struct Lru {
-		::string     prev = DirCache::Head ;
-		::string     next = DirCache::Head ;
-		DirCache::Sz sz   = 0              ; // size of entry, or overall size for head
-	} ;
-
 	void DirCache::chk(ssize_t delta_sz) const {
-		::ifstream head_stream   { _lru_file(Head) } ;
-		Lru        head          ;                     if (head_stream) deserialize(head_stream,head) ;
-		::uset_s   seen          ;
-		::string   expected_prev = Head              ;
-		size_t     total_sz      = 0                 ;
-		for( ::string entry=head.next ; entry!=Head ;) {
-			auto here = deserialize<Lru>(IFStream(_lru_file(entry))) ;
+		LruHdr const& hdr           = lru.hdr() ;
+		::uset_s      seen          ;
+		LruIdx        expected_prev = 0         ;
+		size_t        total_sz      = 0         ;
+		for( LruIdx idx=hdr.first ; idx ;) {
+			LruEntry const& here  = lru.at(idx)                     ;
+			::string        entry { names.str_view(here.name) }     ;
 			//
-			SWEAR(seen.insert(entry).second,entry) ;
-			SWEAR(here.prev==expected_prev ,entry) ;
+			SWEAR(seen.insert(entry).second        ,entry) ;
+			SWEAR(here.prev==expected_prev         ,entry) ;
+			SWEAR(_lru_idx(entry)==idx             ,entry) ;
 			total_sz      += here.sz ;
-			expected_prev  = entry   ;
+			expected_prev  = idx     ;
 			//
-			entry          = here.next ;
+			idx = here.next ;
 		}
-		SWEAR(head.prev==expected_prev    ,Head                     ) ;
-		SWEAR(head.sz  ==total_sz+delta_sz,head.sz,total_sz,delta_sz) ;
+		::string blobs_dir = to_string(AdminDir,"/blobs") ;
+		for( ::string const& b : walk(dir_fd,blobs_dir,blobs_dir) ) total_sz += FileInfo(dir_fd,b).sz ;
+		SWEAR(hdr.last==expected_prev    ,hdr.last                ) ;
+		SWEAR(hdr.sz  ==total_sz+delta_sz,hdr.sz,total_sz,delta_sz) ;
 	}
 
-	// END_OF_VERSIONING
+	static bool _has_codec(DirCacheCodec codec) {
+		switch (codec) {
+			case DirCacheCodec::None : return true     ;
+			case DirCacheCodec::Zlib : return HAS_ZLIB ;
+			case DirCacheCodec::Zstd : return HAS_ZSTD ;
+		DF}
+	}
 
 	void DirCache::config(Config::Cache const& config) {
 		::map_ss dct = mk_map(config.dct) ;
 		//
 		Hash::Xxh repo_hash ;
 		if (dct.contains("repo")) repo_hash.update(dct.at("repo")) ; else throw "repo not found"s ;
-		if (dct.contains("dir" )) dir =            dct.at("dir" )  ; else throw "dir not found"s  ;
-		repo   = "repo-"+::string(repo_hash.digest()) ;
+		repo = "repo-"+::string(repo_hash.digest()) ;
+		config_dir(dct) ;
+	}
+
+	void DirCache::config_dir(::map_ss const& dct) {
+		if (dct.contains("dir")) dir = dct.at("dir") ; else throw "dir not found"s ;
 		//
 		try                     { chk_version(true/*may_init*/,to_string(dir,'/',AdminDir)) ;       }
 		catch (::string const&) { throw to_string("cache version mismatch, running without ",dir) ; }
@@ -71,6 +100,18 @@ namespace Caches {
 		dir_fd = open_read(dir)                               ; dir_fd.no_std() ;       // avoid poluting standard descriptors
 		if (!dir_fd) throw to_string("cannot configure cache ",dir," : no directory") ;
 		sz = from_string_with_units<size_t>(strip(read_content(to_string(dir,'/',AdminDir,"/size")))) ;
+		//
+		if (dct.contains("compress")) {
+			::string const& c = dct.at("compress") ;
+			if (!can_mk_enum<Codec>(c)) throw to_string("unknown compression ",c," for cache ",dir) ;
+			codec = mk_enum<Codec>(c) ;
+			if (!_has_codec(codec)) throw to_string(c," compression is not supported for cache ",dir) ;
+		}
+		if (dct.contains("blob_key")) {
+			::string const& k = dct.at("blob_key") ;
+			if (!can_mk_enum<BlobKey>(k)) throw to_string("unknown blob key ",k," for cache ",dir) ;
+			blob_key = mk_enum<BlobKey>(k) ;
+		}
 	}
 
 	// START_OF_VERSIONING
@@ -94,47 +135,269 @@ namespace Caches {
 		return res ;
 	}
 	static ::string _unique_name( Job job , ::string const& repo ) { return to_string(_unique_name(job),'/',repo) ; }
+	::string DirCache::s_job_dir(Job job) { return _unique_name(job) ; }
+	static ::string _blob_name( ::string const& key , bool exe , DirCacheCodec codec ) {
+		::string res = to_string(AdminDir,"/blobs/",key.substr(0,2),'/',key.substr(2),exe?"-x":"") ;
+		if (codec!=DirCacheCodec::None) append_to_string(res,'.',snake(codec)) ;
+		return res ;
+	}
 	// END_OF_VERSIONING
 
+	DirCache::Sz DirCache::_unlnk_entry( ::string const& entry , bool keep_dir ) {
+		::vector_s blobs        ;
+		::ifstream blobs_stream { to_string(dir,'/',entry,"/blobs") } ; if (blobs_stream) { deserialize<Codec>(blobs_stream) ; deserialize(blobs_stream,blobs) ; } // old entries have no blobs file, all their targets are private copies
+		Sz         res          = 0                                     ;
+		if (keep_dir) unlnk_inside(dir_fd,entry                 ) ;
+		else          unlnk       (dir_fd,entry,true/*dir_ok*/) ;
+		for( ::string const& b : blobs ) {
+			if (!b) continue ;
+			struct ::stat st ;
+			if (::fstatat(dir_fd,b.c_str(),&st,AT_SYMLINK_NOFOLLOW)!=0) continue ;                                     // blob was already collected through another target of this entry
+			if (st.st_nlink>1                                         ) continue ;                                     // still referenced by another entry
+			unlnk(dir_fd,b) ;
+			res += st.st_size ;
+		}
+		return res ;
+	}
+
+	void DirCache::_lru_refresh() {
+		if (!lru.base) {
+			lru  .init( to_string(dir,'/',AdminDir,"/lru"      ) , true/*writable*/ ) ;
+			names.init( to_string(dir,'/',AdminDir,"/lru_names") , true/*writable*/ ) ;
+		} else {
+			lru  .refresh() ;
+			names.refresh() ;
+		}
+	}
+
+	DirCache::LruIdx DirCache::_lru_idx(::string const& entry) const {
+		LruIdx     res           = 0                    ;
+		::ifstream idx_stream    { _lru_file(entry) }   ; if (!idx_stream) return 0 ;
+		try                      { deserialize(idx_stream,res) ; } catch (...) { return 0 ; }
+		if ( !res || res>=lru.size()                           ) return 0 ;                  // file may be stale if we crashed in the middle of an upload
+		if ( names.str_view(lru.at(res).name)!=entry           ) return 0 ;                  // .
+		return res ;
+	}
+
+	void DirCache::_lru_unlnk(LruIdx idx) {
+		LruHdr  & hdr  = lru.hdr()   ;
+		LruEntry& here = lru.at(idx) ;
+		if (here.prev) lru.at(here.prev).next = here.next ; else hdr.first = here.next ;
+		if (here.next) lru.at(here.next).prev = here.prev ; else hdr.last  = here.prev ;
+		here.prev = 0 ;
+		here.next = 0 ;
+	}
+
+	DirCache::Sz DirCache::_lru_remove(LruIdx idx) {
+		if (!idx) return 0 ;                                                                 // nothing to remove
+		_lru_unlnk(idx) ;
+		LruEntry const& here = lru.at(idx) ;
+		Sz              res  = here.sz     ;
+		names.pop(here.name) ;
+		lru  .pop(idx      ) ;
+		return res ;
+	}
+
+	void DirCache::_lru_first(LruIdx idx) {
+		SWEAR(idx) ;
+		LruHdr& hdr = lru.hdr() ;
+		if (hdr.first==idx) return ;                                                         // fast path
+		_lru_unlnk(idx) ;
+		LruEntry& here = lru.at(idx) ;
+		here.next = hdr.first ;
+		if (hdr.first) lru.at(hdr.first).prev = idx ; else hdr.last = idx ;
+		hdr.first = idx ;
+	}
+
+	void DirCache::_lru_insert( ::string const& entry , Sz sz_ ) {
+		LruIdx idx = lru.emplace(LruEntry{ .sz=sz_ , .name=names.emplace(entry) }) ;
+		serialize(OFStream(_lru_file(entry)),idx) ;
+		LruHdr  & hdr  = lru.hdr()   ;
+		LruEntry& here = lru.at(idx) ;
+		here.next = hdr.first ;
+		if (hdr.first) lru.at(hdr.first).prev = idx ; else hdr.last = idx ;
+		hdr.first = idx ;
+	}
+
 	void DirCache::_mk_room( Sz old_sz , Sz new_sz ) {
 		if (new_sz>sz) throw to_string("cannot store entry of size ",new_sz," in cache of size ",sz) ;
 		//
-		::string   head_file     = _lru_file(Head) ;
-		::ifstream head_stream   { head_file }     ;
-		Lru        head          ;                   if (head_stream) deserialize(head_stream,head) ;
-		bool       some_removed  = false           ;
-		::string   expected_next = Head            ;                        // for assertion only
-		//
-		SWEAR( head.sz>=old_sz , head.sz , old_sz ) ;                       // total size contains old_sz
-		head.sz -= old_sz ;
-		while (head.sz+new_sz>sz) {
-			SWEAR(head.prev!=Head) ;                                        // else this would mean an empty cache and we know an empty cache can accept new_sz
-			auto here = deserialize<Lru>(IFStream(_lru_file(head.prev))) ;
-			SWEAR( here.next==expected_next , here.next , expected_next ) ;
-			SWEAR( head.sz  >=here.sz       , head.sz   , here.sz       ) ; // total size contains this entry
-			unlnk(dir_fd,head.prev,true/*dir_ok*/) ;
-			expected_next  = head.prev         ;
-			head.sz       -= here.sz           ;
-			head.prev      = ::move(here.prev) ;
-			some_removed   = true              ;
-		}
-		head.sz += new_sz ;
-		SWEAR( head.sz<=sz , head.sz , sz ) ;
-		//
-		if (some_removed) {
-			if (head.prev==Head) {
-				head.next = Head ;
-			} else {
-				::string last_file = _lru_file(head.prev)                  ;
-				auto     last      = deserialize<Lru>(IFStream(last_file)) ;
-				last.next = Head ;
-				serialize(OFStream(last_file),last) ;
+		LruHdr& hdr = lru.hdr() ;
+		SWEAR( hdr.sz>=old_sz , hdr.sz , old_sz ) ;                                          // total size contains old_sz
+		hdr.sz -= old_sz ;
+		if (hdr.sz+new_sz>sz) {
+			Sz goal = ::max( sz-(sz>>EvictBatchLog) , new_sz ) ;                             // evict by batches so that next uploads find room
+			for( LruIdx idx=hdr.last ; idx && hdr.sz+new_sz>goal ;) {
+				LruEntry const& here  = lru.at(idx)                 ;
+				LruIdx          prev  = here.prev                   ;
+				::string        entry { names.str_view(here.name) } ;
+				AutoCloseFd     efd   = open_read(dir_fd,entry)     ;
+				if ( +efd && ::flock(efd,LOCK_EX|LOCK_NB)!=0 ) {                             // entry is being downloaded, spare it
+					idx = prev ;
+					continue ;
+				}
+				Sz freed = _lru_remove(idx) + _unlnk_entry(entry,false/*keep_dir*/) ;
+				_update_match_tree( dir_name(entry) , base_name(entry) ) ;                   // prune evicted variant from its job match tree
+				SWEAR( hdr.sz>=freed , hdr.sz , freed ) ;                                    // total size contains this entry and the blobs only it referenced
+				hdr.sz -= freed ;
+				idx     = prev  ;
+			}
+			if (hdr.sz+new_sz>sz) {
+				hdr.sz += old_sz ;                                                           // leave accounting as we found it
+				throw to_string("cannot make room for entry of size ",new_sz," as cache is busy") ;
 			}
 		}
-		serialize( OFStream(dir_guard(head_file)) , head ) ;
+		hdr.sz += new_sz ;
+	}
+
+	//
+	// compression
+	//
+
+	// data flows by chunks from in to out so that large files need not be held in memory
+	using CodecIn  = ::function<size_t(char*      ,size_t)> ;                                                     // returns 0 at eof
+	using CodecOut = ::function<void  (char const*,size_t)> ;
+	static constexpr size_t CodecBufSz = 1<<16 ;
+
+	static CodecIn _fd_in(Fd fd) {
+		return [=](char* buf,size_t sz)->size_t {
+			ssize_t cnt = ::read(fd,buf,sz) ;
+			if (cnt<0) throw "cannot read"s ;
+			return cnt ;
+		} ;
+	}
+	static CodecOut _fd_out(Fd fd) {
+		return [=](char const* buf,size_t sz)->void {
+			for( size_t pos=0 ; pos<sz ;) {
+				ssize_t cnt = ::write( fd , buf+pos , sz-pos ) ;
+				if (cnt<=0) throw "cannot write"s ;
+				pos += cnt ;
+			}
+		} ;
+	}
+	static CodecIn _str_in(::string const& s) { // s must outlive result
+		return [&s,pos=size_t(0)](char* buf,size_t sz) mutable -> size_t {
+			size_t cnt = ::min( sz , s.size()-pos ) ;
+			::memcpy( buf , s.data()+pos , cnt ) ;
+			pos += cnt ;
+			return cnt ;
+		} ;
+	}
+	static CodecOut _str_out(::string& s) {
+		return [&](char const* buf,size_t sz)->void { s.append(buf,sz) ; } ;
+	}
+
+	static void _compress( DirCacheCodec codec , CodecOut const& out , CodecIn const& in ) {
+		if (!_has_codec(codec)) throw to_string(snake(codec)," compression is not supported") ;                // entry may have been stored by a repo with a different config
+		::string ibuf ( CodecBufSz , 0 ) ;
+		::string obuf ( CodecBufSz , 0 ) ;
+		switch (codec) {
+			#if HAS_ZLIB
+				case DirCacheCodec::Zlib : {
+					z_stream zs = {} ;
+					if (::deflateInit(&zs,Z_BEST_SPEED)!=Z_OK) throw "cannot init zlib"s ;
+					try {
+						for( int flush=Z_NO_FLUSH ; flush!=Z_FINISH ;) {
+							size_t cnt = in(ibuf.data(),CodecBufSz) ;
+							flush       = cnt ? Z_NO_FLUSH : Z_FINISH ;
+							zs.next_in  = reinterpret_cast<Bytef*>(ibuf.data()) ;
+							zs.avail_in = cnt                                   ;
+							do {
+								zs.next_out  = reinterpret_cast<Bytef*>(obuf.data()) ;
+								zs.avail_out = CodecBufSz                            ;
+								if (::deflate(&zs,flush)==Z_STREAM_ERROR) throw "cannot compress"s ;
+								out( obuf.data() , CodecBufSz-zs.avail_out ) ;
+							} while (zs.avail_out==0) ;
+						}
+					} catch (::string const&) { ::deflateEnd(&zs) ; throw ; }
+					::deflateEnd(&zs) ;
+				} break ;
+			#endif
+			#if HAS_ZSTD
+				case DirCacheCodec::Zstd : {
+					ZSTD_CCtx* cctx = ::ZSTD_createCCtx() ;
+					if (!cctx) throw "cannot init zstd"s ;
+					::ZSTD_CCtx_setParameter( cctx , ZSTD_c_compressionLevel , 1/*fastest*/ ) ;
+					try {
+						for( bool last=false ; !last ;) {
+							size_t            cnt  = in(ibuf.data(),CodecBufSz)              ;
+							ZSTD_inBuffer     ib   { ibuf.data() , cnt , 0 }                 ;
+							ZSTD_EndDirective mode = cnt ? ZSTD_e_continue : ZSTD_e_end ;
+							last = !cnt ;
+							for( bool done=false ; !done ;) {
+								ZSTD_outBuffer ob  { obuf.data() , CodecBufSz , 0 }                  ;
+								size_t         rem = ::ZSTD_compressStream2( cctx , &ob , &ib , mode ) ;
+								if (::ZSTD_isError(rem)) throw to_string("cannot compress : ",::ZSTD_getErrorName(rem)) ;
+								out( obuf.data() , ob.pos ) ;
+								done = last ? rem==0 : ib.pos==ib.size ;
+							}
+						}
+					} catch (::string const&) { ::ZSTD_freeCCtx(cctx) ; throw ; }
+					::ZSTD_freeCCtx(cctx) ;
+				} break ;
+			#endif
+			case DirCacheCodec::None :
+				for( size_t cnt ; (cnt=in(ibuf.data(),CodecBufSz)) ;) out(ibuf.data(),cnt) ;
+			break ;
+		DF}
+	}
+
+	static void _decompress( DirCacheCodec codec , CodecOut const& out , CodecIn const& in ) {
+		if (!_has_codec(codec)) throw to_string(snake(codec)," compression is not supported") ;                // entry may have been stored by a repo with a different config
+		::string ibuf ( CodecBufSz , 0 ) ;
+		::string obuf ( CodecBufSz , 0 ) ;
+		switch (codec) {
+			#if HAS_ZLIB
+				case DirCacheCodec::Zlib : {
+					z_stream zs = {} ;
+					if (::inflateInit(&zs)!=Z_OK) throw "cannot init zlib"s ;
+					try {
+						int rc = Z_OK ;
+						while (rc!=Z_STREAM_END) {
+							size_t cnt = in(ibuf.data(),CodecBufSz) ;
+							if (!cnt) throw "truncated compressed data"s ;
+							zs.next_in  = reinterpret_cast<Bytef*>(ibuf.data()) ;
+							zs.avail_in = cnt                                   ;
+							do {
+								zs.next_out  = reinterpret_cast<Bytef*>(obuf.data()) ;
+								zs.avail_out = CodecBufSz                            ;
+								rc = ::inflate(&zs,Z_NO_FLUSH) ;
+								if ( rc!=Z_OK && rc!=Z_STREAM_END && rc!=Z_BUF_ERROR ) throw "corrupted compressed data"s ;
+								out( obuf.data() , CodecBufSz-zs.avail_out ) ;
+							} while ( zs.avail_out==0 && rc!=Z_STREAM_END ) ;
+						}
+					} catch (::string const&) { ::inflateEnd(&zs) ; throw ; }
+					::inflateEnd(&zs) ;
+				} break ;
+			#endif
+			#if HAS_ZSTD
+				case DirCacheCodec::Zstd : {
+					ZSTD_DCtx* dctx = ::ZSTD_createDCtx() ;
+					if (!dctx) throw "cannot init zstd"s ;
+					try {
+						size_t rem = 1 ;                                                                               // 0 when a frame is complete
+						for( size_t cnt ; (cnt=in(ibuf.data(),CodecBufSz)) ;) {
+							ZSTD_inBuffer ib { ibuf.data() , cnt , 0 } ;
+							while (ib.pos<ib.size) {
+								ZSTD_outBuffer ob { obuf.data() , CodecBufSz , 0 } ;
+								rem = ::ZSTD_decompressStream( dctx , &ob , &ib ) ;
+								if (::ZSTD_isError(rem)) throw to_string("corrupted compressed data : ",::ZSTD_getErrorName(rem)) ;
+								out( obuf.data() , ob.pos ) ;
+							}
+						}
+						if (rem) throw "truncated compressed data"s ;
+					} catch (::string const&) { ::ZSTD_freeDCtx(dctx) ; throw ; }
+					::ZSTD_freeDCtx(dctx) ;
+				} break ;
+			#endif
+			case DirCacheCodec::None :
+				for( size_t cnt ; (cnt=in(ibuf.data(),CodecBufSz)) ;) out(ibuf.data(),cnt) ;
+			break ;
+		DF}
 	}
 
-	static void _copy( Fd src_at , ::string const& src_file , Fd dst_at , ::string const& dst_file , bool unlnk_dst , bool mk_read_only ) {
+	// codec is used to compress when copying to cache and to decompress when copying from cache
+	static void _copy( Fd src_at , ::string const& src_file , Fd dst_at , ::string const& dst_file , bool unlnk_dst , bool mk_read_only , DirCacheCodec codec , bool compress ) {
 		FileTag tag = FileInfo(src_at,src_file).tag() ;
 		if (unlnk_dst) unlnk(dst_at,dst_file)                                         ;
 		else           SWEAR( !is_target(dst_at,dst_file) , '@',dst_at,':',dst_file ) ;
@@ -142,8 +405,16 @@ namespace Caches {
 			case FileTag::None : break ;
 			case FileTag::Reg  :
 			case FileTag::Exe  : {
-				FileMap     fm  { src_at , src_file } ;
 				AutoCloseFd wfd = open_write( dst_at , dst_file , false/*append*/ , tag==FileTag::Exe , mk_read_only ) ;
+				AutoCloseFd rfd = open_read ( src_at , src_file                                                       ) ;
+				if (codec!=DirCacheCodec::None) {                                                                         // stream through codec, directly from/to destination
+					if (!rfd) throw to_string("cannot open ",src_file) ;
+					if (compress) _compress  ( codec , _fd_out(wfd) , _fd_in(rfd) ) ;
+					else          _decompress( codec , _fd_out(wfd) , _fd_in(rfd) ) ;
+					break ;
+				}
+				if ( +rfd && ::ioctl(wfd,FICLONE,int(rfd))==0 ) break ;                                                   // reflink when file system supports it : no data is copied
+				FileMap fm { src_at , src_file } ;                                                                        // else (e.g. across file systems), copy data
 				for( size_t pos=0 ; pos<fm.sz ;) {
 					ssize_t cnt = ::write( wfd , fm.data+pos , fm.sz-pos ) ;
 					if (cnt<=0) throw ""s ;
@@ -159,99 +430,276 @@ namespace Caches {
 			break ;
 		DF}
 	}
-	static void _copy(             ::string const& src_file , Fd dst_at , ::string const& dst_file , bool ud , bool ro ) { _copy( Fd::Cwd , src_file , dst_at  , dst_file , ud , ro ) ; }
-	static void _copy( Fd src_at , ::string const& src_file ,             ::string const& dst_file , bool ud , bool ro ) { _copy( src_at  , src_file , Fd::Cwd , dst_file , ud , ro ) ; }
+	static void _copy(             ::string const& src_file , Fd dst_at , ::string const& dst_file , bool ud , bool ro , DirCacheCodec c , bool z ) { _copy( Fd::Cwd , src_file , dst_at  , dst_file , ud , ro , c , z ) ; }
+	static void _copy( Fd src_at , ::string const& src_file ,             ::string const& dst_file , bool ud , bool ro , DirCacheCodec c , bool z ) { _copy( src_at  , src_file , Fd::Cwd , dst_file , ud , ro , c , z ) ; }
 
-	DirCache::Sz DirCache::_lru_remove(::string const& entry) {
-		SWEAR(entry!=Head) ;
-		//
-		::ifstream here_stream { _lru_file(entry) }            ; if (!here_stream) return 0 ; // nothing to remove
-		auto       here        = deserialize<Lru>(here_stream) ;
-		if (here.prev==here.next) {
-			::string pn_file = _lru_file(here.prev)                ;
-			auto     pn      = deserialize<Lru>(IFStream(pn_file)) ;
-			//
-			pn.next = here.next ;
-			pn.prev = here.prev ;
-			//
-			serialize(OFStream(pn_file),pn) ;
-		} else {
-			::string   prev_file   = _lru_file(here.prev)                  ;
-			::string   next_file   = _lru_file(here.next)                  ;
-			auto       prev        = deserialize<Lru>(IFStream(prev_file)) ;
-			auto       next        = deserialize<Lru>(IFStream(next_file)) ;
-			//
-			prev.next = here.next ;
-			next.prev = here.prev ;
-			//
-			serialize(OFStream(prev_file),prev) ;
-			serialize(OFStream(next_file),next) ;
+	//
+	// streaming
+	//
+
+	static constexpr uint32_t ChunkEnd   = 0           ;
+	static constexpr uint32_t ChunkAbort = uint32_t(-1) ;
+
+	static void _sock_write( Fd sock , void const* data , size_t sz ) {
+		for( size_t pos=0 ; pos<sz ;) {
+			ssize_t cnt = ::write( sock , static_cast<char const*>(data)+pos , sz-pos ) ;
+			if (cnt<=0) throw to_string("cannot send over ",sock) ;
+			pos += cnt ;
+		}
+	}
+	static void _sock_read( Fd sock , void* data , size_t sz ) {
+		for( size_t pos=0 ; pos<sz ;) {
+			ssize_t cnt = ::read( sock , static_cast<char*>(data)+pos , sz-pos ) ;
+			if (cnt<=0) throw to_string("cannot receive over ",sock) ;
+			pos += cnt ;
 		}
-		return here.sz ;
 	}
 
-	void DirCache::_lru_first( ::string const& entry , Sz sz_ ) {
-		SWEAR(entry!=Head) ;
-		//
-		::string head_file  = _lru_file(Head)                        ;
-		auto     head       = deserialize<Lru>(IFStream(head_file))  ;
-		::string here_file  = _lru_file(entry)                       ;
-		Lru      here       { .next=head.next , .sz=sz_ }            ;
-		if (head.next==Head) {
-			head.next = entry ;
-			head.prev = entry ;
-		} else {
-			::string first_file = _lru_file(head.next)                   ;
-			auto     first      = deserialize<Lru>(IFStream(first_file)) ;
-			head .next = entry ;
-			first.prev = entry ;
-			serialize(OFStream(first_file),first) ;
+	void DirCache::s_send_content( Fd sock , Fd src , Codec codec ) {
+		_decompress( codec , [&](char const* buf,size_t sz)->void {
+			if (!sz) return ;                                                                              // an empty chunk would be seen as the end marker
+			uint32_t len = sz ;
+			_sock_write( sock , &len , sizeof(len) ) ;
+			_sock_write( sock , buf  , sz          ) ;
+		} , _fd_in(src) ) ;
+	}
+
+	void DirCache::s_send_end( Fd sock , bool ok ) {
+		uint32_t mrkr = ok ? ChunkEnd : ChunkAbort ;
+		_sock_write( sock , &mrkr , sizeof(mrkr) ) ;
+	}
+
+	bool/*ok*/ DirCache::s_recv_content( Fd sock , Fd dst , Codec codec , Hash::Xxh* xxh ) {
+		::string chunk ;
+		size_t   pos   = 0     ;
+		bool     done  = false ;
+		bool     ok    = false ;
+		_compress( codec , _fd_out(dst) , [&](char* buf,size_t sz)->size_t {
+			if (pos==chunk.size()) {
+				if (done) return 0 ;
+				uint32_t len ; _sock_read( sock , &len , sizeof(len) ) ;
+				if ( len==ChunkEnd || len==ChunkAbort ) { done = true ; ok = len==ChunkEnd ; return 0 ; }
+				if ( len>CodecBufSz                   ) throw "protocol error"s ;                            // sender never sends larger chunks
+				chunk.resize(len) ; _sock_read( sock , chunk.data() , len ) ;
+				pos = 0 ;
+				if (xxh) xxh->update( chunk.data() , len ) ;
+			}
+			size_t cnt = ::min( sz , chunk.size()-pos ) ;
+			::memcpy( buf , chunk.data()+pos , cnt ) ;
+			pos += cnt ;
+			return cnt ;
+		} ) ;
+		return ok ;
+	}
+
+	// children are always created after their parent, so that a reverse scan sees children before their parent
+	static void _insert_match_tree( DirCache::MatchTree& tree , ::string const& repo , ::vmap_s<DepDigest> const& deps ) {
+		if (!tree) tree.emplace_back() ;                                                                        // root
+		uint32_t n = 0 ;
+		for( auto const& [dn,dd] : deps ) {
+			::vector<DirCache::MatchEdge>& edges = tree[n].edges                                                                                          ;
+			auto                           lo    = ::lower_bound( edges.begin() , edges.end() , dn , [](DirCache::MatchEdge const& e,::string const& d)->bool { return e.dep<d ; } ) ;
+			auto                           hi    = lo                                                                                                     ;
+			for(; hi!=edges.end() && hi->dep==dn ; hi++ ) if (hi->dd==dd) break ;
+			if ( hi!=edges.end() && hi->dep==dn ) { n = hi->child ; continue ; }
+			uint32_t child = tree.size() ;
+			edges.insert( hi , { .dep=dn , .dd=dd , .child=child } ) ;                                          // keep edges sorted by dep
+			tree.emplace_back() ;                                                                               // /!\ edges is invalidated
+			n = child ;
+		}
+		tree[n].hits.push_back(repo) ;
+	}
+
+	// remove branches that lead to no hit and compact tree
+	static void _prune_match_tree(DirCache::MatchTree& tree) {
+		::vector<bool> live ( tree.size() , false ) ;
+		for( uint32_t n=tree.size() ; n-->0 ;) {
+			DirCache::MatchNode& mn = tree[n] ;
+			::erase_if( mn.edges , [&](DirCache::MatchEdge const& e)->bool { return !live[e.child] ; } ) ;
+			live[n] = +mn.hits || +mn.edges ;
+		}
+		::vector<uint32_t>  idxs ( tree.size() , 0 ) ;
+		DirCache::MatchTree res  ;
+		for( uint32_t n=0 ; n<tree.size() ; n++ ) {
+			if ( n && !live[n] ) continue ;                                                                     // always keep root
+			idxs[n] = res.size() ;
+			res.push_back(::move(tree[n])) ;
+		}
+		for( DirCache::MatchNode& mn : res ) for( DirCache::MatchEdge& me : mn.edges ) me.child = idxs[me.child] ;
+		tree = ::move(res) ;
+	}
+
+	void DirCache::_write_match_tree( ::string const& job_dir , MatchTree const& tree ) const {
+		// write atomically so that match threads need no lock to read it
+		::string tree_file = to_string(dir,'/',job_dir,"/match") ;
+		serialize(OFStream(tree_file+".tmp"),tree) ;
+		if (::rename((tree_file+".tmp").c_str(),tree_file.c_str())!=0) throw to_string("cannot create match tree ",tree_file) ;
+	}
+
+	// full build from the deps of all variants, only necessary for caches created before match trees were maintained
+	DirCache::MatchTree DirCache::_mk_match_tree(::string const& job_dir) const {
+		MatchTree tree { 1 } ;                                                                                  // root
+		for( ::string const& r : lst_dir(AutoCloseFd(open_read(dir_fd,job_dir))) ) {
+			::vmap_s<DepDigest> deps ;
+			try         { deps = deserialize<::vmap_s<DepDigest>>(IFStream(to_string(dir,'/',job_dir,'/',r,"/deps"))) ; }
+			catch (...) { continue ;                                                                          } // not a complete entry
+			_insert_match_tree(tree,r,deps) ;
+		}
+		_write_match_tree(job_dir,tree) ;
+		return tree ;
+	}
+
+	// incremental update : old variant repo is removed and new one (if any) is inserted
+	void DirCache::_update_match_tree( ::string const& job_dir , ::string const& repo_ , ::vmap_s<DepDigest> const* deps ) const {
+		MatchTree tree ;
+		try         { tree = deserialize<MatchTree>(IFStream(to_string(dir,'/',job_dir,"/match"))) ; }
+		catch (...) { if (deps) _mk_match_tree(job_dir) ; return ;                                  } // no tree yet, build it from scratch (new variant is already on disk)
+		for( MatchNode& mn : tree ) ::erase( mn.hits , repo_ ) ;
+		if (deps) _insert_match_tree(tree,repo_,*deps) ;
+		_prune_match_tree(tree) ;
+		_write_match_tree(job_dir,tree) ;
+	}
+
+	void DirCache::_match_thread_func(::stop_token stop) {
+		t_thread_key = 'K' ;
+		Trace trace("DirCache::_match_thread_func") ;
+		for(;;) {
+			auto [popped,entry] = _match_queue.pop(stop) ;
+			if (!popped) break ;
+			trace("match",entry.job,entry.req,entry.jn) ;
+			MatchTree tree = read_match_tree(entry.jn) ;
+			{	Lock lock { _match_mutex } ;
+				_match_results[{entry.job,entry.req}] = ::move(tree) ;
+			}
+			g_engine_queue.emplace(entry.job,entry.req) ;                                                       // wake up job, which will call match again and find results
 		}
-		serialize(OFStream(head_file),head ) ;
-		serialize(OFStream(here_file),here ) ;
+		trace("done") ;
 	}
 
+	DirCache::MatchTree DirCache::read_match_tree(::string const& job_dir) const {
+		AutoCloseFd dfd = open_read(dir_fd,job_dir) ; if (!dfd) return {} ;                                    // job was never cached, fast path
+		MatchTree   res ;
+		try {
+			try {
+				res = deserialize<MatchTree>(IFStream(to_string(dir,'/',job_dir,"/match"))) ;
+			} catch (...) {                                                                                     // cache was created before match trees were maintained, build it once
+				AutoCloseFd lfd  = open_read(dir_fd,".") ;                                                      // use our own open file description so that lock excludes other threads
+				LockedFd    lock { lfd , true/*exclusive*/ } ;
+				try         { res = deserialize<MatchTree>(IFStream(to_string(dir,'/',job_dir,"/match"))) ; } // another thread may have built it in between
+				catch (...) { res = _mk_match_tree(job_dir) ;                                           }
+			}
+			for( MatchNode& mn : res ) ::erase_if( mn.hits , [&](::string const& r)->bool { return !is_target(dfd,to_string(r,"/data")) ; } ) ; // variant may have been evicted by a crashed repo
+		} catch (...) {                                                                                         // if tree cannot be built, it is as if it was empty
+			res = {} ;
+		}
+		return res ;
+	}
+
+	// matching is split in 2 parts :
+	// - reading match tree from disk, which is done in match threads, and then an EngineClosureCache is posted to the engine loop
+	// - walking the tree against current state, which requires the store and hence is done in engine thread when the job calls match again
 	Cache::Match DirCache::match( Job job , Req req ) {
 		Trace trace("DirCache::match",job,req) ;
-		::string     jn       = _unique_name(job)             ;
-		::uset<Node> new_deps ;
-		AutoCloseFd  dfd      =  open_read(dir_fd,jn)         ;
-		LockedFd     lock     { dfd    , false/*exclusive*/ } ;
-		bool         found    = false                         ;
+		MatchTree tree  ;
+		bool      ready = false ;
+		{	Lock lock { _match_mutex } ;
+			if ( auto it=_match_results.find({job,req}) ; it!=_match_results.end() ) {
+				tree  = ::move(it->second) ;
+				ready = true               ;
+				_match_results.erase(it) ;
+			}
+		}
+		if (!ready) {
+			if (!_match_threads)                                                                                // start lazily so caches that never match (e.g. in cache daemon) need no threads
+				for( uint8_t i=0 ; i<NMatchThreads ; i++ ) _match_threads.emplace_back( [this](::stop_token stop)->void { _match_thread_func(stop) ; } ) ;
+			_match_queue.emplace( MatchEntry{ .job=job , .req=req , .jn=_unique_name(job) } ) ;
+			trace("delayed") ;
+			return { .completed=false } ;
+		}
+		return s_match(tree,req) ;
+	}
+
+	void DirCache::forget( Req req , Job job ) {
+		Lock lock { _match_mutex } ;
+		if (+job) _match_results.erase({job,req}) ;
+		else      ::erase_if( _match_results , [&](auto const& jr_t)->bool { return jr_t.first.second==req ; } ) ;
+	}
+
+	Cache::Match DirCache::s_match( MatchTree const& tree , Req req ) {
+		Trace trace("DirCache::s_match",req,tree.size()) ;
+		if (!tree) {
+			trace("miss") ;
+			return { .completed=true , .hit=No } ;
+		}
 		//
-		try {
-			for( ::string const& r : lst_dir(dfd) ) {
-				::uset<Node> nds      ;
-				auto         deps     = deserialize<::vmap_s<DepDigest>>(IFStream(to_string(dir,'/',jn,'/',r,"/deps"))) ;
-				bool         critical = false ;
-				//
-				for( auto const& [dn,dd] : deps ) {
-					if ( critical && !dd.parallel ) break ;           // if a critical dep needs reconstruction, do not proceed past parallel deps
-					Node d{dn} ;
-					if (!d->done(req,NodeGoal::Status)) {
-						nds.insert(d) ;
-						critical |= dd.dflags[Dflag::Critical] ;      // note critical flag to stop processing once parallel deps are exhausted
-						if (!nds) trace("not_done",dn) ;
-					} else if (!d->up_to_date(dd)) {
-						trace("diff",dn) ;
-						goto Miss ;
-					}
-				}
-				if (!nds) {
-					trace("hit",r) ;
-					return { .completed=true , .hit=Yes , .id{r} } ;  // hit
-				}
-				if (!found) {
-					found    = true        ;
-					new_deps = ::move(nds) ;                          // do as if new_deps contains the whole world
-				} else {
-					for( auto it=new_deps.begin() ; it!=new_deps.end() ;)
-						if (nds.contains(*it))                it++  ;
-						else                   new_deps.erase(it++) ; // /!\ be careful with erasing while iterating : increment it before erasing is done at it before increment
-				}
-			Miss : ;                                                  // missed for this entry, try next one
+		::uset<Node> new_deps ;
+		bool         found    = false ;
+		::string     hit      ;
+		auto record = [&](::uset<Node> const& nds)->void {                                                      // record a variant that could match once nds are done
+			if (!found) {
+				found    = true ;
+				new_deps = nds  ;                                                                               // do as if new_deps contains the whole world
+			} else {
+				for( auto it=new_deps.begin() ; it!=new_deps.end() ;)
+					if (nds.contains(*it))                it++  ;
+					else                   new_deps.erase(it++) ;                                               // /!\ be careful with erasing while iterating : increment it before erasing is done at it before increment
+			}
+		} ;
+		// walk tree depth first, nds contains the deps that are not done on the path from root
+		// iterate rather than recurse as trees may be very deep, and maintain a single nds, undoing insertions when backtracking
+		struct Frame {
+			uint32_t        node     = 0       ;
+			size_t          edge     = 0       ;                                                            // next edge to explore
+			bool            critical = false   ;
+			bool            stopped  = false   ;
+			::string const* dn       = nullptr ;                                                            // dep name of last explored edge, resolved once for all edges sharing it
+			Node            d        = {}      ;                                                            // resolved dn, resolved only if necessary
+			bool            dd       = false   ;                                                            // d is done
+			Node            added    = {}      ;                                                            // dep inserted in nds when entering this node, to be removed when leaving it
+		} ;
+		::uset<Node>    nds   ;
+		::vector<Frame> stack ;
+		auto enter = [&]( uint32_t n , bool critical , Node added )->bool/*hit*/ {
+			stack.push_back({ .node=n , .critical=critical , .added=added }) ;
+			for( ::string const& r : tree[n].hits ) {
+				if (!nds) { hit = r ; return true ; }
+				record(nds) ;
+			}
+			return false ;
+		} ;
+		bool is_hit = enter(0/*root*/,false/*critical*/,{}) ;
+		while ( !is_hit && +stack ) {
+			Frame&           f  = stack.back() ;
+			MatchNode const& mn = tree[f.node] ;
+			if (f.edge>=mn.edges.size()) {
+				if (+f.added) nds.erase(f.added) ;
+				stack.pop_back() ;
+				continue ;
+			}
+			MatchEdge const& me = mn.edges[f.edge++] ;
+			if ( !f.dn || *f.dn!=me.dep ) { f.dn = &me.dep ; f.d = {} ; }
+			if ( f.critical && !me.dd.parallel ) {                                                          // if a critical dep needs reconstruction, do not proceed past parallel deps
+				if (!f.stopped) record(nds) ;
+				f.stopped = true ;
+				continue ;
+			}
+			if (!f.d) {
+				f.d  = Node(me.dep)                  ;
+				f.dd = f.d->done(req,NodeGoal::Status) ;
+				if (!f.dd) trace("not_done",me.dep) ;
+			}
+			if (f.dd) {
+				if (!f.d->up_to_date(me.dd)) { trace("diff",me.dep) ; continue ; }
+				is_hit = enter( me.child , f.critical , {} ) ;                                              // /!\ f is invalidated
+			} else {
+				Node added = nds.insert(f.d).second ? f.d : Node() ;
+				is_hit = enter( me.child , f.critical||me.dd.dflags[Dflag::Critical] , added ) ;            // note critical flag to stop processing once parallel deps are exhausted, /!\ f is invalidated
 			}
-		} catch (::string const&) {}                                  // if directory does not exist, it is as it was empty
+		}
+		if (is_hit) {
+			trace("hit",hit) ;
+			return { .completed=true , .hit=Yes , .id{hit} } ;
+		}
 		if (!found) {
 			trace("miss") ;
 			return { .completed=true , .hit=No } ;
@@ -266,38 +714,53 @@ namespace Caches {
 		return { .completed=true , .hit=Maybe , .new_deps{::mk_vector(new_deps)} } ;
 	}
 
+	JobInfo DirCache::_download( ::string const& jn , GetTarget const& get_target ) {
+		Trace trace("DirCache::_download",jn) ;
+		AutoCloseFd dfd = open_read(dir_fd,jn) ;
+		JobInfo     job_info ;
+		{	LockedFd   lock         { dfd , false/*exclusive*/ }       ;                        // because we read the data , shared is ok
+			Codec      entry_codec  = Codec::None                      ;                        // entry was stored with the codec in force at upload time
+			::ifstream blobs_stream { to_string(dir,'/',jn,"/blobs") } ; if (blobs_stream) deserialize(blobs_stream,entry_codec) ; // old entries have no blobs file and are not compressed
+			if (entry_codec==Codec::None) {
+				job_info = { to_string(dir,'/',jn,"/data") } ;
+			} else {
+				::string jis ;
+				_decompress( entry_codec , _str_out(jis) , _fd_in(AutoCloseFd(open_read(dfd,"data"))) ) ;
+				IStringStream is { jis } ;
+				deserialize(is,job_info.start) ;
+				deserialize(is,job_info.end  ) ;
+			}
+			::vmap_s<TargetDigest> const& targets = job_info.end.end.digest.targets ;
+			for( NodeIdx ti=0 ; ti<targets.size() ; ti++ ) get_target( targets[ti].first , dfd , to_string(ti) , entry_codec ) ;
+		}
+		// ensure we take a single lock at a time to avoid deadlocks
+		// upload is the only one to take several locks
+		{	LockedFd lock2 { dir_fd , true /*exclusive*/ } ;                                    // because we manipulate LRU, need exclusive, but this is O(1)
+			_lru_refresh() ;
+			LruIdx idx = _lru_idx(jn) ;
+			if (+idx) _lru_first(idx) ;                                                         // entry may have been evicted since we copied it, it does not matter
+			trace("done",idx) ;
+		}
+		return job_info ;
+	}
+
 	JobDigest DirCache::download( Job job , Id const& id , JobReason const& reason , NfsGuard& nfs_guard ) {
-		::string    jn     = _unique_name(job,id) ;
-		AutoCloseFd dfd    = open_read(dir_fd,jn) ;
-		::vector_s  copied ;
+		::string   jn     = _unique_name(job,id) ;
+		::vector_s copied ;
 		Trace trace("DirCache::download",job,id,jn) ;
 		try {
-			JobInfo job_info ;
-			{	LockedFd lock { dfd , false/*exclusive*/ } ;                                        // because we read the data , shared is ok
-				job_info = { to_string(dir,'/',jn,"/data") } ;
-				// update some info
-				job_info.start.pre_start.job       = +job   ;                                       // id is not stored in cache
-				job_info.start.submit_attrs.reason = reason ;
-				//
-				for( NodeIdx ti=0 ; ti<job_info.end.end.digest.targets.size() ; ti++ ) {
-					auto&           entry = job_info.end.end.digest.targets[ti] ;
-					::string const& tn    = entry.first                         ;
-					copied.push_back(tn) ;
-					nfs_guard.change(tn) ;
-					_copy( dfd , to_string(ti) , tn , true/*unlnk_dst*/ , false/*mk_read_only*/ ) ;
-					entry.second.sig = FileSig(tn) ;                                                // target digest is not stored in cache
-				}
-				job_info.end.end.digest.end_date = New ;                                            // date must be after files are copied
-				copied.push_back(job->ancillary_file()) ;
-				job_info.write(dir_guard(copied.back())) ;
-			}
-			// ensure we take a single lock at a time to avoid deadlocks
-			// upload is the only one to take several locks
-			{	LockedFd lock2 { dir_fd , true /*exclusive*/ } ;                                    // because we manipulate LRU, need exclusive
-				Sz sz_ = _lru_remove(jn) ;
-				_lru_first(jn,sz_) ;
-				trace("done",sz_) ;
-			}
+			JobInfo job_info = _download( jn , [&]( ::string const& tn , Fd dfd , ::string const& t , Codec c )->void {
+				copied.push_back(tn) ;
+				nfs_guard.change(tn) ;
+				_copy( dfd , t , tn , true/*unlnk_dst*/ , false/*mk_read_only*/ , c , false/*compress*/ ) ;
+			} ) ;
+			// update some info
+			job_info.start.pre_start.job       = +job   ;                                           // id is not stored in cache
+			job_info.start.submit_attrs.reason = reason ;
+			for( auto& [tn,td] : job_info.end.end.digest.targets ) td.sig = FileSig(tn) ;          // target digest is not stored in cache
+			job_info.end.end.digest.end_date = New ;                                                // date must be after files are copied
+			job->write_job_info(job_info) ;
+			trace("done") ;
 			return job_info.end.end.digest ;
 		} catch(::string const& e) {
 			for( ::string const& f : copied ) unlnk(f) ;                                            // clean up partial job
@@ -306,15 +769,39 @@ namespace Caches {
 		}
 	}
 
-	bool/*ok*/ DirCache::upload( Job job , JobDigest const& digest , NfsGuard& nfs_guard ) {
-		::string jn = _unique_name(job,repo) ;
-		Trace trace("DirCache::upload",job,jn) ;
-		//
-		JobInfo job_info = job->job_info() ;
-		if (!job_info.end.end.proc) {                                     // we need a full report to cache job
-			trace("no_ancillary_file") ;
-			return false/*ok*/ ;
+	JobInfo DirCache::get_entry( ::string const& jn , ::vector<EntryTarget>& targets , ::vector<AutoCloseFd>& fds , Codec& codec_ ) {
+		return _download( jn , [&]( ::string const& , Fd dfd , ::string const& t , Codec c )->void {
+			EntryTarget& et = targets.emplace_back() ;
+			AutoCloseFd& fd = fds    .emplace_back() ;
+			codec_ = c                      ;                                                              // all targets of an entry share the same codec
+			et.tag = FileInfo(dfd,t).tag() ;
+			switch (et.tag) {
+				case FileTag::None :                                                                        break ;
+				case FileTag::Reg  :
+				case FileTag::Exe  : fd = open_read(dfd,t) ; if (!fd) throw to_string("cannot open ",t) ; break ; // fd keeps content alive, even if entry is evicted
+				case FileTag::Lnk  : et.content = read_lnk(dfd,t) ;                                         break ;
+			DF}
+		} ) ;
+	}
+
+	::string DirCache::recv_target( Fd sock , bool exe , ::string& xxh ) {
+		static ::atomic<uint64_t> s_seq = 0 ;
+		::string  staged = to_string(dir,'/',AdminDir,"/tmp/",s_seq++) ;                                   // a single server runs for a given cache dir
+		Hash::Xxh h      { FileTag::Reg }                               ;                                  // hash raw content, as when computed from file
+		bool      ok     ;
+		dir_guard(dir_fd,staged) ;
+		{	AutoCloseFd wfd = open_write( dir_fd , staged , false/*append*/ , exe , true/*read_only*/ ) ;
+			if (!wfd) throw to_string("cannot create ",staged) ;
+			ok = s_recv_content( sock , wfd , codec , &h ) ;
 		}
+		if (!ok) { unlnk(dir_fd,staged) ; return {} ; }
+		xxh = ::string(h.digest128()) ;
+		return staged ;
+	}
+
+	bool/*ok*/ DirCache::s_upload_info( Job job , JobInfo& job_info ) {
+		job_info = job->job_info() ;
+		if (!job_info.end.end.proc) return false/*ok*/ ;                  // we need a full report to cache job
 		// remove useless info
 		job_info.start.pre_start.seq_id    = 0  ;                         // no seq_id   since no execution
 		job_info.start.start    .small_id  = 0  ;                         // no small_id since no execution
@@ -330,43 +817,193 @@ namespace Caches {
 		job_info.end.end.digest.end_date = {} ;
 		// check deps
 		for( auto const& [dn,dd] : job_info.end.end.digest.deps ) if (!dd.is_crc) return false/*ok*/ ;
+		return true/*ok*/ ;
+	}
+
+	static bool _is_blob(TargetDigest const& td) { return td.crc.valid() && td.crc.is_reg() && td.crc!=Crc::Empty ; } // only store actual content as blobs
+
+	bool/*ok*/ DirCache::upload( Job job , JobDigest const& digest , NfsGuard& nfs_guard ) {
+		Trace trace("DirCache::upload",job) ;
+		//
+		JobInfo job_info ;
+		if (!s_upload_info(job,job_info)) {
+			trace("not_cachable") ;
+			return false/*ok*/ ;
+		}
+		::vector<FileTag> tags ; tags.reserve(digest.targets.size()) ;
+		::vector_s        keys ; keys.reserve(digest.targets.size()) ;
+		for( auto const& [tn,td] : digest.targets ) {
+			FileInfo fi { nfs_guard.access(tn) } ;
+			if ( _is_blob(td) && fi.sig()!=td.sig ) {                                         // crc would not be the content key
+				trace("modified",tn) ;
+				return false/*ok*/ ;
+			}
+			tags.push_back(fi.tag()) ;
+			try {
+				if      (!_is_blob(td)            ) keys.emplace_back(                          ) ;
+				else if (blob_key==BlobKey::Xxh128) keys.push_back   (::string(Hash::Crc128(tn))) ;
+				else                                keys.push_back   (::string(td.crc          )) ;
+			} catch (::string const& e) {
+				trace("cannot_hash",tn,e) ;
+				return false/*ok*/ ;
+			}
+			if ( _is_blob(td) && blob_key==BlobKey::Xxh128 && FileSig(tn)!=td.sig ) {         // target may have been modified while being hashed
+				trace("modified_while_hashing",tn) ;
+				return false/*ok*/ ;
+			}
+		}
+		return _upload( s_job_dir(job) , repo , job_info , digest.targets , tags , keys , [&]( NodeIdx ti , Fd dfd , ::string const& t )->void {
+			auto const& [tn,td] = digest.targets[ti] ;
+			_copy( tn , dfd , t , false/*unlnk_dst*/ , true/*mk_read_only*/ , codec , true/*compress*/ ) ;
+			if ( _is_blob(td) && FileSig(tn)!=td.sig ) throw to_string("modified while copying ",tn) ; // stored content would not match its key
+		} ) ;
+	}
+
+	// staged contents are moved into entry, those that are not (because their blob already exists) are left to caller
+	bool/*ok*/ DirCache::put_entry( ::string const& job_dir , ::string const& repo_ , JobInfo const& job_info , ::vector<EntryTarget> const& targets , ::vector_s const& staged , ::vector_s const& xxhs ) {
+		::vmap_s<TargetDigest> const& tds  = job_info.end.end.digest.targets ;
+		::vector<FileTag>             tags ; tags.reserve(targets.size()) ;
+		::vector_s                    keys ; keys.reserve(targets.size()) ;
+		if (targets.size()!=tds.size()) return false/*ok*/ ;
+		SWEAR( staged.size()==targets.size() && xxhs.size()==targets.size() , staged.size() , xxhs.size() , targets.size() ) ;
+		for( NodeIdx ti=0 ; ti<targets.size() ; ti++ ) {
+			EntryTarget  const& et = targets[ti]        ;
+			TargetDigest const& td = tds    [ti].second ;
+			tags.push_back(et.tag) ;
+			if      (!_is_blob(td)            ) keys.emplace_back(                 ) ;
+			else if (blob_key==BlobKey::Xxh128) keys.push_back   (xxhs[ti]         ) ;
+			else                                keys.push_back   (::string(td.crc)) ;
+		}
+		return _upload( job_dir , repo_ , job_info , tds , tags , keys , [&]( NodeIdx ti , Fd dfd , ::string const& t )->void {
+			EntryTarget const& et = targets[ti] ;
+			switch (et.tag) {
+				case FileTag::None : break ;
+				case FileTag::Reg  :
+				case FileTag::Exe  :
+					if (::renameat( dir_fd , staged[ti].c_str() , dfd , t.c_str() )!=0) throw to_string("cannot move ",staged[ti]) ;
+				break ;
+				case FileTag::Lnk : lnk( dfd , t , et.content ) ; break ;
+			DF}
+		} ) ;
+	}
+
+	bool/*ok*/ DirCache::_upload( ::string const& job_dir , ::string const& repo_ , JobInfo const& job_info , ::vmap_s<TargetDigest> const& targets , ::vector<FileTag> const& tags , ::vector_s const& keys , PutTarget const& put_target ) {
+		static ::atomic<uint64_t> s_seq = 0 ;
+		::string jn = to_string(job_dir,'/',repo_) ;
+		Trace trace("DirCache::_upload",jn) ;
+		SWEAR( tags.size()==targets.size() , tags.size() , targets.size() ) ;
+		SWEAR( keys.size()==targets.size() , keys.size() , targets.size() ) ;
+		//
+		// entry is first prepared in a private dir, without lock as compressing may be long
+		// targets are copied before making room as their stored size is only known once compressed
+		::string    staging    = to_string(AdminDir,"/tmp/",host(),'-',::getpid(),'-',s_seq++) ;   // several repos may upload to the same cache dir
+		::vector_s  blobs      ; blobs    .reserve(targets.size()) ;                               // for each target, the blob it is stored into, if any
+		::vector_s  new_blobs  ; new_blobs.reserve(targets.size()) ;                               // for each target, the blob it must create, if any
+		Sz          meta_sz    = 0                                 ;                               // size of entry, including private copies of targets
+		::uset_s    seen_blobs ;
+		mkdir(dir_fd,staging) ;
+		AutoCloseFd sfd = open_read(dir_fd,staging) ;
+		try {
+			// store meta-data
+			::string data_file  = to_string(dir,'/',staging,"/data" ) ;
+			::string deps_file  = to_string(dir,'/',staging,"/deps" ) ;
+			::string blobs_file = to_string(dir,'/',staging,"/blobs") ;
+			//
+			if (codec==Codec::None) {
+				job_info.write(data_file) ;
+			} else {
+				::string jis = serialize(job_info.start) + serialize(job_info.end) ;                 // same content as job_info.write
+				_compress( codec , _fd_out(AutoCloseFd(open_write(data_file))) , _str_in(jis) ) ;
+			}
+			serialize(OFStream(deps_file),job_info.end.end.digest.deps) ;                            // store deps in a compact format so that matching is fast
+			//
+			for( NodeIdx ti=0 ; ti<targets.size() ; ti++ ) {
+				::string t  = to_string(ti) ;
+				::string b  ;
+				::string nb ;
+				if (+keys[ti]) {
+					b = _blob_name(keys[ti],tags[ti]==FileTag::Exe,codec) ;
+					if      (!seen_blobs.insert(b).second                   ) {}                     // blob is created by a previous target of this job
+					else if (::linkat(dir_fd,b.c_str(),sfd,t.c_str(),0)==0) {}                     // blob exists, share it, this also holds it against _mk_room
+					else                                                      { put_target(ti,sfd,t) ; nb = b ; }
+				} else {
+					put_target(ti,sfd,t) ;
+					meta_sz += FileInfo(sfd,t).sz ;
+				}
+				blobs    .push_back(::move(b )) ;
+				new_blobs.push_back(::move(nb)) ;
+			}
+			{	OFStream blobs_stream { blobs_file } ;
+				serialize(blobs_stream,codec) ;
+				serialize(blobs_stream,blobs) ;
+			}
+			//
+			meta_sz += FileInfo(data_file ).sz ;
+			meta_sz += FileInfo(deps_file ).sz ;
+			meta_sz += FileInfo(blobs_file).sz ;
+		} catch (::string const& e) {
+			trace("failed_staging",e) ;
+			unlnk(dir_fd,staging,true/*dir_ok*/) ;
+			return false/*ok*/ ;
+		}
 		//
 		mkdir(dir_fd,jn) ;
 		AutoCloseFd dfd = open_read(dir_fd,jn) ;
 		//
 		// upload is the only one to take several locks and it starts with the global lock
 		// this way, we are sure to avoid deadlocks
-		LockedFd lock2{ dir_fd , true/*exclusive*/ } ;                    // because we manipulate LRU and because we take several locks, need exclusive
-		LockedFd lock { dfd    , true/*exclusive*/ } ;                    // because we write the data , need exclusive
+		// under locks, staged entry is merely moved into place, which is O(1) per file
+		LockedFd lock2{ dir_fd , true/*exclusive*/ } ;                                             // because we manipulate LRU and because we take several locks, need exclusive
+		LockedFd lock { dfd    , true/*exclusive*/ } ;                                             // because we write the data , need exclusive
 		//
-		Sz old_sz = _lru_remove(jn) ;
-		Sz new_sz = 0               ;
-		unlnk_inside(dfd) ;
+		_lru_refresh() ;
+		Sz old_sz = _lru_remove(_lru_idx(jn)) + _unlnk_entry(jn,true/*keep_dir*/) ;               // old blobs only referenced by old entry are freed
+		Sz new_sz = meta_sz                                                       ;               // meta_sz + size of blobs we create
 		//
 		bool made_room = false ;
 		try {
-			// store meta-data
-			::string data_file = to_string(dir,'/',jn,"/data") ;
-			::string deps_file = to_string(dir,'/',jn,"/deps") ;
-			//
-			job_info.write(data_file) ;
-			serialize(OFStream(deps_file),job_info.end.end.digest.deps) ; // store deps in a compact format so that matching is fast
-			//
-			/**/                                       new_sz += FileInfo(data_file           ).sz ;
-			/**/                                       new_sz += FileInfo(deps_file           ).sz ;
-			for( auto const& [tn,_] : digest.targets ) new_sz += FileInfo(nfs_guard.access(tn)).sz ;
+			for( NodeIdx ti=0 ; ti<targets.size() ; ti++ ) {
+				::string t = to_string(ti) ;
+				if (!new_blobs[ti]) continue ;
+				if (is_target(dir_fd,new_blobs[ti])) {                                             // blob has been created by a concurrent upload while we were staging, share it
+					unlnk(sfd,t) ;
+					if (::linkat(dir_fd,new_blobs[ti].c_str(),sfd,t.c_str(),0)!=0) throw to_string("cannot link to blob ",new_blobs[ti]) ;
+					new_blobs[ti] = {} ;
+				} else {
+					new_sz += FileInfo(sfd,t).sz ;
+				}
+			}
 			_mk_room(old_sz,new_sz) ;
 			made_room = true ;
-			for( NodeIdx ti=0 ; ti<digest.targets.size() ; ti++ )
-				_copy( digest.targets[ti].first , dfd , to_string(ti) , false/*unlnk_dst*/ , true/*mk_read_only*/ ) ;
+			for( ::string const& f : {"data"s,"deps"s,"blobs"s} )
+				if (::renameat( sfd , f.c_str() , dfd , f.c_str() )!=0) throw to_string("cannot move ",staging,'/',f) ;
+			for( NodeIdx ti=0 ; ti<targets.size() ; ti++ ) {
+				::string t = to_string(ti) ;
+				if (!is_target(sfd,t)                                ) continue ;                  // target has no content or shares a blob with a previous target
+				if (::renameat( sfd , t.c_str() , dfd , t.c_str() )!=0) throw to_string("cannot move ",staging,'/',t) ;
+			}
+			for( NodeIdx ti=0 ; ti<targets.size() ; ti++ ) {
+				::string t = to_string(ti) ;
+				if (!blobs[ti]) continue ;
+				if (!new_blobs[ti]) {
+					if ( !is_target(dfd,t) && ::linkat(dir_fd,blobs[ti].c_str(),dfd,t.c_str(),0)!=0 ) throw to_string("cannot link to blob ",blobs[ti]) ;
+					continue ;
+				}
+				dir_guard(dir_fd,new_blobs[ti]) ;
+				if (::linkat(dfd,t.c_str(),dir_fd,new_blobs[ti].c_str(),0)!=0) throw to_string("cannot create blob ",new_blobs[ti]) ;
+			}
 		} catch (::string const& e) {
 			trace("failed",e) ;
-			unlnk_inside(dfd) ;                                           // clean up in case of partial execution
-			_mk_room( made_room?new_sz:old_sz , 0 ) ;                     // finally, we did not populate the entry
+			unlnk(dir_fd,staging,true/*dir_ok*/) ;                                                 // staged links would hold blobs
+			_unlnk_entry(jn,true/*keep_dir*/) ;                                                    // clean up in case of partial execution, this frees blobs we created
+			_mk_room( made_room?new_sz:old_sz , 0 ) ;                                              // finally, we did not populate the entry
+			_update_match_tree( job_dir , repo_ ) ;                                                // old entry has been removed
 			return false/*ok*/ ;
 		}
-		_lru_first(jn,new_sz) ;
-		trace("done",new_sz) ;
+		unlnk(dir_fd,staging,true/*dir_ok*/) ;                                                     // staging dir is empty by now
+		_lru_insert(jn,meta_sz) ;
+		_update_match_tree( job_dir , repo_ , &job_info.end.end.digest.deps ) ;
+		trace("done",meta_sz,new_sz) ;
 		return true/*ok*/ ;
 	}
 
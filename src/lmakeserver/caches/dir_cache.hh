@@ -3,33 +3,128 @@
 // This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
+#pragma once
+
 #include "core.hh"
 
 #include <grp.h>
 
+// START_OF_VERSIONING
+ENUM( DirCacheCodec // how regular files and meta-data are stored in cache
+,	None
+,	Zlib
+,	Zstd
+)
+// END_OF_VERSIONING
+
+ENUM( DirCacheBlobKey // how blobs are named after their content
+,	Crc               // target crc as computed by job
+,	Xxh128            // 128 bits digest computed upon upload, so that collisions can be excluded even in very large caches
+)
+
 namespace Caches {
 
 	struct DirCache : Cache {     // PER_CACHE : inherit from Cache and provide implementation
-		using Sz = Disk::DiskSz ;
-		static constexpr char Head[] = ADMIN_DIR ;
+		using Sz      = Disk::DiskSz    ;
+		using Codec   = DirCacheCodec   ;
+		using BlobKey = DirCacheBlobKey ;
+		// START_OF_VERSIONING
+		using LruIdx = uint32_t ;
+		struct LruHdr {
+			LruIdx first = 0 ;        // most  recently used entry, 0 if cache is empty
+			LruIdx last  = 0 ;        // least recently used entry, 0 if cache is empty
+			Sz     sz    = 0 ;        // overall size of cache
+		} ;
+		struct LruEntry {
+			LruIdx prev = 0 ;         // more recently used entry, 0 for most  recently used entry
+			LruIdx next = 0 ;         // less recently used entry, 0 for least recently used entry
+			Sz     sz   = 0 ;         // size of entry
+			LruIdx name = 0 ;         // entry name, as an index in NameFile
+		} ;
+		using LruFile  = Store::AllocFile < false/*AutoLock*/ , LruHdr , LruIdx , LruEntry                        > ; // cache is shared between repos : locking is done with the global lock
+		using NameFile = Store::VectorFile< false/*AutoLock*/ , void   , LruIdx , char , uint32_t , 16/*MinSz*/ > ;
+		static constexpr uint8_t EvictBatchLog = 4 ;                                                                     // when full, evict 1/16 of cache at once so next uploads need not evict
+		// match tree : all repo variants of a job are merged into a tree keyed on successive deps so that each dep is checked once
+		struct MatchEdge {
+			::string  dep   ;
+			DepDigest dd    ;
+			uint32_t  child = 0 ;                                                                                        // index of node reached when dep matches dd
+		} ;
+		struct MatchNode {
+			::vector<MatchEdge> edges ;                                                                                  // sorted by dep so that each dep name is resolved once
+			::vector_s          hits  ;                                                                                  // repo variants whose deps are all seen when reaching this node
+		} ;
+		using MatchTree = ::vector<MatchNode> ;                                                                          // root is at index 0
+		// END_OF_VERSIONING
+		static constexpr uint8_t NMatchThreads = 4 ;                                                                     // matching is mostly waiting for the file system
+		struct MatchEntry {
+			Job      job = {} ;
+			Req      req = {} ;
+			::string jn  = {} ;                                                                                          // computed in engine thread as it requires accessing the store
+		} ;
+		struct EntryTarget {                                                                                             // target description, when entries are transported rather than copied
+			FileTag  tag     = FileTag::None ;
+			::string content = {}            ;                                                                           // link target for links, regular file contents are streamed (cf s_send_content)
+		} ;
+		using GetTarget = ::function<void( ::string const& tn , Fd dfd , ::string const& t , Codec )> ;                 // retrieve target tn from file t in dfd, stored with codec
+		using PutTarget = ::function<void( NodeIdx ti         , Fd dfd , ::string const& t         )> ;                 // store target ti into file t in dfd, with cache codec
+		// statics
+		static ::string   s_job_dir    ( Job                           ) ;                                               // dir containing all repo variants of job
+		static Match      s_match      ( MatchTree const& , Req        ) ;                                               // walk tree against current state, must be called from engine thread
+		static bool/*ok*/ s_upload_info( Job , JobInfo&/*out*/         ) ;                                               // job info as stored in cache, false if job cannot be cached
+		// regular file contents are streamed over a socket as chunks, each preceded by its size, followed by an end or abort marker
+		// this way, neither side needs to hold whole files in memory
+		static void       s_send_content( Fd sock , Fd src , Codec=Codec::None                 ) ;                     // src is decompressed on the fly, s_send_end must follow
+		static void       s_send_end    ( Fd sock , bool ok=true                                ) ;
+		static bool/*ok*/ s_recv_content( Fd sock , Fd dst , Codec=Codec::None , Hash::Xxh* ={} ) ;                     // dst is compressed on the fly, xxh is fed with raw content
 		// services
 		virtual void config(Config::Cache const&) ;
+		/**/    void config_dir(::map_ss const&) ;                                                                       // configure storage only, when repo is provided per request
 		//
 		virtual Match      match   ( Job , Req                                                   ) ;
 		virtual JobDigest  download( Job , Id        const& , JobReason const& , Disk::NfsGuard& ) ;
 		virtual bool/*ok*/ upload  ( Job , JobDigest const& ,                    Disk::NfsGuard& ) ;
+		virtual void       forget  ( Req , Job={}                                                ) ;
+		// entry level services, independent of the engine (used by cache daemon)
+		// these are not thread safe as the cache dir lock does not exclude threads
+		MatchTree  read_match_tree( ::string const& job_dir                                                            ) const ;
+		JobInfo    get_entry      ( ::string const& jn , ::vector<EntryTarget>&/*out*/ , ::vector<AutoCloseFd>&/*out*/ , Codec&/*out*/ ) ; // reg targets are opened, compressed with codec
+		::string   recv_target    ( Fd sock , bool exe , ::string&/*out*/ xxh                                          ) ;        // stage streamed content, "" if aborted
+		bool/*ok*/ put_entry      ( ::string const& job_dir , ::string const& repo , JobInfo const& , ::vector<EntryTarget> const& , ::vector_s const& staged , ::vector_s const& xxhs ) ;
 		//
-		void chk(ssize_t delta_sz=0) const ;
+		void chk(ssize_t delta_sz=0) const ;                                                                             // must be called with global lock held
 	private :
-		::string _lru_file  ( ::string const& entry             ) const { return to_string(dir,'/',entry,"/lru") ; }
-		Sz       _lru_remove( ::string const& entry             ) ;
-		void     _lru_first ( ::string const& entry , Sz sz     ) ;
-		void     _mk_room   ( Sz old_sz             , Sz new_sz ) ;
+		JobInfo    _download( ::string const& jn , GetTarget const& ) ;
+		bool/*ok*/ _upload  ( ::string const& job_dir , ::string const& repo , JobInfo const& , ::vmap_s<TargetDigest> const& , ::vector<FileTag> const& tags , ::vector_s const& keys , PutTarget const& ) ;
+		// all _lru_* functions must be called with global lock held
+		::string _lru_file    ( ::string const& entry                 ) const { return to_string(dir,'/',entry,"/lru") ; } // contains the index of entry in lru
+		void     _lru_refresh (                                       ) ;                                              // other repos may have modified index since last time
+		LruIdx   _lru_idx     ( ::string const& entry                 ) const ;                                        // 0 if entry is not recorded
+		Sz       _lru_remove  ( LruIdx                                ) ;
+		void     _lru_unlnk   ( LruIdx                                ) ;
+		void     _lru_first   ( LruIdx                                ) ;
+		void     _lru_insert  ( ::string const& entry , Sz sz         ) ;
+		void     _mk_room     ( Sz old_sz             , Sz new_sz     ) ;
+		void     _match_thread_func(::stop_token) ;
+		// all *_match_tree functions must be called with global lock held
+		MatchTree _mk_match_tree    ( ::string const& job_dir                                                             ) const ;
+		void      _update_match_tree( ::string const& job_dir , ::string const& repo , ::vmap_s<DepDigest> const* deps={} ) const ; // remove variant repo and insert it with deps if provided
+		void      _write_match_tree ( ::string const& job_dir , MatchTree const&                                          ) const ;
+		Sz       _unlnk_entry ( ::string const& entry , bool keep_dir ) ;                                              // return size of blobs that are no more referenced and hence have been removed
 		// data
 		::string repo   ;
 		::string dir    ;
 		Fd       dir_fd ;
 		Sz       sz     = 0 ;
+		Codec    codec    = {} ;                                  // codec used for new entries, entries record their own codec
+		BlobKey  blob_key = {} ;                                  // how new blobs are named, entries record the blob each target is linked to
+		LruFile  lru    ;
+		NameFile names  ;
+		//
+		ThreadQueue<MatchEntry>                  _match_queue   ;
+		Mutex<MutexLvl::Cache>                   _match_mutex   ;
+		::map<::pair<Job,Req>,MatchTree>         _match_results ; // protected by _match_mutex, filled by match threads, consumed by engine thread
+		::vector<::jthread>                      _match_threads ; // ensure _match_threads is last so other fields are constructed when they start
 	} ;
 
 }
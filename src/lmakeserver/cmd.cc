@@ -597,14 +597,28 @@ R"({
 		}
 	} ;
 
+	static BitMap<JobInfoKind> _job_info_kinds(ReqKey key) { // only read what is necessary, {} means no info
+		switch (key) {
+			case ReqKey::Cmd        :
+			case ReqKey::Env        :
+			case ReqKey::ExecScript : return { JobInfoKind::Start , JobInfoKind::End } ;
+			case ReqKey::Info       : return ~BitMap<JobInfoKind>()                     ;
+			case ReqKey::Stderr     : return { JobInfoKind::Start , JobInfoKind::Out } ;
+			case ReqKey::Stdout     : return   JobInfoKind::Out                         ;
+			case ReqKey::Targets    : return   JobInfoKind::End                         ;
+			default                 : return {}                                         ;
+		}
+	}
+
 	static void _show_job( Fd fd , ReqOptions const& ro , Job job , DepDepth lvl=0 ) {
 		Trace trace("show_job",ro.key,job) ;
-		Rule             rule         = job->rule                  ;
-		JobInfo          job_info     = job->job_info()            ;
-		bool             has_start    = +job_info.start.start.proc ;
-		bool             has_end      = +job_info.end  .end  .proc ;
-		bool             verbose      = ro.flags[ReqFlag::Verbose] ;
-		JobDigest const& digest       = job_info.end.end.digest    ;
+		Rule                rule      = job->rule                                 ;
+		BitMap<JobInfoKind> kinds     = _job_info_kinds(ro.key)                   ;
+		JobInfo             job_info  = +kinds ? job->job_info(kinds) : JobInfo() ;
+		bool                has_start = +job_info.start.start.proc                ;
+		bool                has_end   = +job_info.end  .end  .proc                ;
+		bool                verbose   = ro.flags[ReqFlag::Verbose]                ;
+		JobDigest const&    digest    = job_info.end.end.digest                   ;
 		switch (ro.key) {
 			case ReqKey::Cmd        :
 			case ReqKey::Env        :
@@ -727,6 +741,7 @@ R"({
 								if (+start.cwd_s                  ) push_entry( "cwd"         , cwd                                         ) ;
 								if ( start.autodep_env.auto_mkdir ) push_entry( "auto_mkdir"  , "true"                                      ) ;
 								if ( start.autodep_env.ignore_stat) push_entry( "ignore_stat" , "true"                                      ) ;
+								if ( start.autodep_env.shm_report ) push_entry( "shm_report"  , "true"                                      ) ;
 								/**/                                push_entry( "autodep"     , snake_str(start.method)                     ) ;
 								if (+start.timeout                ) push_entry( "timeout"     , start.timeout.short_str()                   ) ;
 								if (sa.tag!=BackendTag::Local     ) push_entry( "backend"     , snake_str(sa.tag)                           ) ;
@@ -924,20 +939,8 @@ R"({
 					}
 					if (prio!=-Infinity) _send_job( fd , ro , always?Yes:Maybe , false/*hide*/ , job ) ; // actual job is output last as this is what user views first
 				} break ;
-				case ReqKey::InvDeps :
-					for( Job j : Persistent::job_lst() )
-						for( Dep const& d : j->deps ) if (d==target) {
-							_send_job( fd , ro , No , false/*hide*/ , j , lvl ) ;
-							break ;
-						}
-				break ;
-				case ReqKey::InvTargets :
-					for( Job j : Persistent::job_lst() )
-						for( Target const& t : j->targets ) if (t==target) {
-							_send_job( fd , ro , No , false/*hide*/ , j , lvl ) ;
-							break ;
-						}
-				break ;
+				case ReqKey::InvDeps    : for( Job j : Persistent::inv_jobs(false/*target*/,target) ) _send_job( fd , ro , No , false/*hide*/ , j , lvl ) ; break ;
+				case ReqKey::InvTargets : for( Job j : Persistent::inv_jobs(true /*target*/,target) ) _send_job( fd , ro , No , false/*hide*/ , j , lvl ) ; break ;
 			DF}
 		}
 		if (porcelaine) audit( fd , ro , "}" , true/*as_is*/ ) ;
@@ -37,12 +37,22 @@ namespace Codec {
 		return                            os <<','<< cc.file <<','<< cc.ctx << ',' << cc.txt <<','<< cc.reqs <<')' ;
 	}
 
+	static ::string _entries_file() { return to_string(CodecPfx,"/entries") ; } // writing CodecPfx+"/entries"s triggers a warning with -O3, probably a gcc bug
+
 	void Closure::s_init() {
 		static QueueThread<Closure> s_queue{'D',Codec::codec_thread_func} ;
 		g_codec_queue = &s_queue ;
 		//
 		Persistent::val_file .init(to_string(CodecPfx,"/vals" ),writable) ; // writing CodecPfx+"/vals"s triggers a warning with -O3, probably a gcc bug
 		Persistent::code_file.init(to_string(CodecPfx,"/codes"),writable) ; // .
+		//
+		try         { s_tab = deserialize<::umap_s<Entry>>(IFStream(_entries_file())) ; }
+		catch (...) { s_tab.clear() ;                                                   } // no info, files will be fully analyzed when first accessed
+		for( auto& [_,e] : s_tab ) e.sample_date = {} ;                                   // files must be sampled again
+	}
+
+	void Closure::_s_save() {
+		if (writable) serialize( OFStream(_entries_file()) , s_tab ) ;
 	}
 
 	void _create_node( ::string const& file , Node node , Buildable buildable , ::string const& txt ) {
@@ -69,6 +79,11 @@ namespace Codec {
 		return res ;
 	}
 
+	// crc of a sequence of lines, starting from Crc::Empty, it can be extended as lines are appended
+	static Crc _fold_crc( Crc crc , ::string_view line ) {
+		return Xxh(+crc).update(line.data(),line.size()).digest() ;
+	}
+
 	static bool _buildable_ok( ::string const& file , Node node ) {
 		switch (node->buildable) {
 			case Buildable::No      :
@@ -131,6 +146,9 @@ namespace Codec {
 		}
 		trace(STR(is_canonic)) ;
 		//
+		Entry& entry = s_tab.at(file) ;
+		entry.sz  = 0          ;
+		entry.crc = Crc::Empty ;
 		if (!is_canonic) {                                                                          // if already canonic, nothing to do
 			// disambiguate in case the same code is used for the several values
 			OFStream                          os         { file } ;
@@ -163,19 +181,95 @@ namespace Codec {
 					codes.insert(new_code) ;
 				}
 				for( auto const& [code,val] : d_entry ) {
-					os << _codec_line(ctx,code,val,true/*with_nl*/) ;
+					::string line = _codec_line(ctx,code,val,false/*with_nl*/) ;
+					os << line << '\n' ;
+					entry.sz  += line.size()+1               ;
+					entry.crc  = _fold_crc(entry.crc,line) ;
 					process_node(ctx,code,val) ;
 				}
 			}
+			os.close() ;
+			entry.phys_date = file_date(file) ;                                                     // we have rewritten the file but not its semantic
 			for( ReqIdx r : reqs ) Req(r)->audit_node(Color::Note,"refresh",Node(file)) ;
 		} else {                                                                                    // file needs no update, but we must record file content into nodes
 			for( auto const& [ctx,e_entry] : encode_tab )
 				for( auto const& [val,code] : e_entry ) process_node(ctx,code,val) ;
+			for( ::string const& line : lines ) {
+				entry.sz  += line.size()+1               ;
+				entry.crc  = _fold_crc(entry.crc,line) ;
+			}
 		}
 		// wrap up
-		Ddate log_date = s_tab.at(file).log_date ;
+		Ddate log_date = entry.log_date ;
 		for( Node n : nodes ) n->log_date() = log_date ;
-		trace("done",nodes.size()/2) ;
+		trace("done",nodes.size()/2,entry.sz,entry.crc) ;
+	}
+
+	bool/*done*/ Closure::_s_append( ::string const& file ) {
+		Entry& entry = s_tab.at(file) ;
+		if (!entry.crc) return false/*done*/ ;                                                     // recorded content is unknown
+		::string content ;
+		try                     { content = read_content(file) ; }
+		catch (::string const&) { return false/*done*/ ;          }
+		Trace trace("_s_append",file,entry.sz,content.size()) ;
+		if ( content.size()<entry.sz                          ) { trace("truncated" ) ; return false/*done*/ ; }
+		if ( content.size()>entry.sz && content.back()!='\n' ) { trace("incomplete") ; return false/*done*/ ; }
+		// check recorded lines are still there
+		::string_view cv  = content    ;
+		Crc           crc = Crc::Empty ;
+		size_t        pos = 0          ;
+		while (pos<entry.sz) {
+			size_t end = cv.find('\n',pos) ;
+			if (end>=entry.sz) { trace("modified") ; return false/*done*/ ; }
+			crc = _fold_crc(crc,cv.substr(pos,end-pos)) ;
+			pos = end+1 ;
+		}
+		if (crc!=entry.crc) { trace("modified",crc,entry.crc) ; return false/*done*/ ; }
+		// analyze appended lines, they must all be new associations
+		struct Assoc {
+			Node     decode_node ;
+			::string val         ;
+			Node     encode_node ;
+			::string code        ;
+		} ;
+		::vector<Assoc>  assocs    ;
+		::set<::pair_ss> new_codes ;                                                                // (ctx,code) seen in appended lines
+		::set<::pair_ss> new_vals  ;                                                                // (ctx,val ) seen in appended lines
+		while (pos<content.size()) {
+			size_t   end  = cv.find('\n',pos)       ;                                               // cannot be Npos as content ends with a \n
+			::string line { cv.substr(pos,end-pos) } ;
+			::string ctx  ;
+			::string code ;
+			::string val  ;
+			size_t   lpos = 0 ;
+			pos = end+1                ;
+			crc = _fold_crc(crc,line) ;
+			/**/                                                 if (line[lpos]!=' ') { trace("bad_format",line) ; return false/*done*/ ; } // let full analysis clean up file
+			tie(ctx ,lpos) = parse_printable<' '>(line,lpos+1) ; if (line[lpos]!=' ') { trace("bad_format",line) ; return false/*done*/ ; } // .
+			tie(code,lpos) = parse_printable<' '>(line,lpos+1) ; if (line[lpos]!=' ') { trace("bad_format",line) ; return false/*done*/ ; } // .
+			tie(val ,lpos) = parse_printable     (line,lpos+1) ; if (line[lpos]!=0  ) { trace("bad_format",line) ; return false/*done*/ ; } // .
+			if (line!=_codec_line(ctx,code,val,false/*with_nl*/)) { trace("non_canonic",line) ; return false/*done*/ ; }
+			//
+			Node dn { mk_decode_node(file,ctx,code) , true/*no_dir*/ } ;
+			Node en { mk_encode_node(file,ctx,val ) , true/*no_dir*/ } ;
+			bool d_ok = _buildable_ok(file,dn) ;
+			bool e_ok = _buildable_ok(file,en) ;
+			if ( d_ok && e_ok && dn->codec_val().str_view()==val ) continue ;                        // duplicate of a recorded association
+			if ( d_ok || e_ok                                    ) { trace("clash",line) ; return false/*done*/ ; }
+			if ( !new_codes.emplace(ctx,code).second             ) { trace("clash",line) ; return false/*done*/ ; }
+			if ( !new_vals .emplace(ctx,val ).second             ) { trace("clash",line) ; return false/*done*/ ; }
+			assocs.push_back({ dn , ::move(val) , en , ::move(code) }) ;
+		}
+		// record new associations, recorded ones are not modified, so log_date is kept
+		for( Assoc& a : assocs ) {
+			_create_pair( file , a.decode_node , a.val , a.encode_node , a.code ) ;
+			a.decode_node->log_date() = entry.log_date ;
+			a.encode_node->log_date() = entry.log_date ;
+		}
+		entry.sz  = content.size() ;
+		entry.crc = crc            ;
+		trace("done",assocs.size()) ;
+		return true/*done*/ ;
 	}
 
 	bool/*ok*/ Closure::s_refresh( ::string const& file , NodeIdx ni , ::vector<ReqIdx> const& reqs ) {
@@ -205,9 +299,12 @@ namespace Codec {
 			if ( inserted && node->buildable==Buildable::Decode ) entry.phys_date = entry.log_date  = node->log_date() ; // initialize from known info
 		}
 		if (phys_date==entry.phys_date) return true/*ok*/ ;                                                              // file has not changed, nothing to do
-		entry.log_date = phys_date ;
-		//
-		_s_canonicalize(file,reqs) ;
+		entry.phys_date = phys_date ;
+		if (!_s_append(file)) {                                                                                          // file was not merely appended new associations
+			entry.log_date = phys_date ;
+			_s_canonicalize(file,reqs) ;
+		}
+		_s_save() ;
 		return true/*ok*/ ;
 	}
 
@@ -253,13 +350,19 @@ namespace Codec {
 		return { JobMngtProc::Encode , {}/*seq_id*/ , {}/*fd*/ , "crc clash" , {} , No } ;             // this is a true full crc clash, seq_id and fd will be filled in later
 	NewCode :
 		trace("new_code",code) ;
-		OFStream(file,::ios::app) << _codec_line(ctx,code,txt,true/*with_nl*/) ;
-		Entry& entry = s_tab.at(file) ;
-		Pdate  now   { New }          ;
+		Entry&   entry = s_tab.at(file)                                ;
+		::string line  = _codec_line(ctx,code,txt,false/*with_nl*/) ;
+		if ( +entry.crc && FileInfo(file).sz!=entry.sz ) entry.crc = {} ;                              // file has been modified behind us, recorded content is no more known
+		OFStream(file,::ios::app) << line << '\n' ;
+		if (+entry.crc) {
+			entry.sz  += line.size()+1               ;
+			entry.crc  = _fold_crc(entry.crc,line) ;
+		}
 		_create_pair( file , decode_node , txt , encode_node , code ) ;
 		decode_node->log_date() = entry.log_date  ;
 		encode_node->log_date() = entry.log_date  ;
 		entry.phys_date         = file_date(file) ;                                                    // we have touched the file but not the semantic, update phys_date but not log_date
+		_s_save() ;
 		//
 		trace("found",code) ;
 		return { JobMngtProc::Encode , {}/*seq_id*/ , {}/*fd*/ , code , encode_node->crc , Yes } ;
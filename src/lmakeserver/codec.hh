@@ -25,9 +25,12 @@ namespace Codec {
 			// log_date is the semantic date, i.e. :
 			// - all decode & encode nodes for this file have this common date
 			// - when file physical date was this date, it was canonic
-			Time::Pdate sample_date ; // date at which file has been sampled on disk
+			// sz and crc describe the content recorded in nodes so that lines appended to it can be recorded without reading the whole file again
+			Time::Pdate sample_date ;      // date at which file has been sampled on disk
 			Time::Ddate log_date    ;
-			Time::Ddate phys_date   ; // actual file date on disk
+			Time::Ddate phys_date   ;      // actual file date on disk
+			size_t      sz          = 0  ; // size of the prefix of the file whose lines are recorded in nodes
+			Hash::Crc   crc         = {} ; // lines of this prefix folded with _fold_crc, Unknown if prefix is unknown
 		} ;
 		// statics
 		static void s_init    () ;
@@ -35,7 +38,9 @@ namespace Codec {
 		//
 		static bool/*ok*/ s_refresh( ::string const& file , NodeIdx , ::vector<ReqIdx> const& ) ;
 	private :
-		static void _s_canonicalize( ::string const& file ,           ::vector<ReqIdx> const& ) ;
+		static void         _s_canonicalize( ::string const& file , ::vector<ReqIdx> const& ) ;
+		static bool/*done*/ _s_append      ( ::string const& file                           ) ; // record lines appended to file if they do not conflict with recorded ones
+		static void         _s_save        (                                                ) ; // s_tab is persistent so that appended lines are recognized across server runs
 		// static data
 	public :
 		static ::umap_s<Entry> s_tab ;
@@ -83,7 +83,6 @@ namespace Engine {
 	::ostream& operator<<( ::ostream& os , Config const& sc ) {
 		os << "Config("
 			/**/ << sc.db_version.major <<'.'<< sc.db_version.minor
-			<<','<< sc.hash_algo
 			<<','<< sc.lnk_support
 		;
 		if (sc.max_dep_depth       )                  os <<",MD" << sc.max_dep_depth          ;
@@ -129,7 +128,6 @@ namespace Engine {
 		::vector_s fields = {{}} ;
 		try {
 			fields[0] = "disk_date_precision" ; if (py_map.contains(fields[0])) date_prec             = Time::Delay               (py_map[fields[0]].as_a<Float>())           ;
-			fields[0] = "hash_algo"           ; if (py_map.contains(fields[0])) hash_algo             = mk_enum<Algo>             (py_map[fields[0]].as_a<Str  >())           ;
 			fields[0] = "local_admin_dir"     ; if (py_map.contains(fields[0])) user_local_admin_dir  =                           (py_map[fields[0]].as_a<Str  >())           ;
 			fields[0] = "heartbeat"           ; if (py_map.contains(fields[0])) heartbeat             = +py_map[fields[0]] ? Delay(py_map[fields[0]].as_a<Float>()) : Delay() ;
 			fields[0] = "heartbeat_tick"      ; if (py_map.contains(fields[0])) heartbeat_tick        = +py_map[fields[0]] ? Delay(py_map[fields[0]].as_a<Float>()) : Delay() ;
@@ -140,6 +138,7 @@ namespace Engine {
 			fields[0] = "reliable_dirs"       ; if (py_map.contains(fields[0])) reliable_dirs         =                           +py_map[fields[0]]                          ;
 			fields[0] = "rules_module"        ; if (py_map.contains(fields[0])) rules_module          =                            py_map[fields[0]].as_a<Str  >()            ;
 			fields[0] = "sources_module"      ; if (py_map.contains(fields[0])) srcs_module           =                            py_map[fields[0]].as_a<Str  >()            ;
+			fields[0] = "watch_sources"       ; if (py_map.contains(fields[0])) watch_srcs            =                           +py_map[fields[0]]                          ;
 			fields[0] = "remote_admin_dir"    ; if (py_map.contains(fields[0])) user_remote_admin_dir =                            py_map[fields[0]].as_a<Str  >()            ;
 			fields[0] = "remote_tmp_dir"      ; if (py_map.contains(fields[0])) user_remote_tmp_dir   =                            py_map[fields[0]].as_a<Str  >()            ;
 			//
@@ -272,7 +271,6 @@ namespace Engine {
 		//
 		res << "clean :\n" ;
 		/**/                       res << "\tdb_version      : " << db_version.major<<'.'<<db_version.minor <<'\n' ;
-		if (hash_algo!=Algo::Xxh ) res << "\thash_algo       : " << snake(hash_algo  )                      <<'\n' ;
 		/**/                       res << "\tlink_support    : " << snake(lnk_support)                      <<'\n' ;
 		/**/                       res << "\tkey             : " << key                                     <<'\n' ;
 		if (+user_local_admin_dir) res << "\tlocal_admin_dir : " << user_local_admin_dir                    <<'\n' ;
@@ -289,6 +287,7 @@ namespace Engine {
 		else                             res << "\tpath_max            : " <<        "<unlimited>"       <<'\n' ;
 		if (+rules_module              ) res << "\trules_module        : " <<        rules_module        <<'\n' ;
 		if (+srcs_module               ) res << "\tsources_module      : " <<        srcs_module         <<'\n' ;
+		if (watch_srcs                 ) res << "\twatch_sources       : " <<        watch_srcs          <<'\n' ;
 		//
 		if (+caches) {
 			res << "\tcaches :\n" ;
@@ -428,6 +427,10 @@ namespace Engine {
 		return                             os << ')' ;
 	}
 
+	::ostream& operator<<( ::ostream& os , EngineClosureCache const& ecc ) {
+		return os << "Cache(" << ecc.job <<','<< ecc.req <<')' ;
+	}
+
 	::ostream& operator<<( ::ostream& os , EngineClosure const& ec ) {
 		/**/                                    os << "EngineClosure(" << ec.kind <<',' ;
 		switch (ec.kind) {
@@ -435,6 +438,7 @@ namespace Engine {
 			case EngineClosure::Kind::Req     : os << ec.ecr  ; break ;
 			case EngineClosure::Kind::Job     : os << ec.ecj  ; break ;
 			case EngineClosure::Kind::JobMngt : os << ec.ecjm ; break ;
+			case EngineClosure::Kind::Cache   : os << ec.ecc  ; break ;
 		DF}
 		return                                  os << ')' ;
 	}
@@ -12,6 +12,7 @@
 ENUM( CacheTag // PER_CACHE : add a tag for each cache method
 ,	None
 ,	Dir
+,	Daemon
 )
 
 ENUM( Color
@@ -37,11 +38,13 @@ ENUM( EngineClosureKind
 ,	Req
 ,	Job
 ,	JobMngt
+,	Cache
 )
 
 ENUM( GlobalProc
 ,	None
 ,	Int
+,	SrcWatch // src watcher has pending events
 ,	Wakeup
 )
 
@@ -95,7 +98,7 @@ namespace Engine {
 		size_t major = 0 ;
 		size_t minor = 0 ;
 	} ;
-	constexpr Version Version::Db = {1,0} ;
+	constexpr Version Version::Db = {1,4} ;
 
 	// changing these values require restarting from a clean base
 	struct ConfigClean {
@@ -103,7 +106,6 @@ namespace Engine {
 		bool operator==(ConfigClean const&) const = default ;
 		// data
 		Version    db_version           ;                    // must always stay first so it is always understood, by default, db version does not match
-		Algo       hash_algo            = Algo::Xxh        ;
 		LnkSupport lnk_support          = LnkSupport::Full ;
 		::string   user_local_admin_dir ;
 		::string   key                  ;                    // random key to differentiate repo from other repos
@@ -148,6 +150,7 @@ namespace Engine {
 		::string       rules_module   ;
 		::string       srcs_module    ;
 		TraceConfig    trace          ;
+		bool           watch_srcs     = false ;                                      // if true, srcs are watched with inotify when server is alive to avoid probing them
 		::map_s<Cache> caches         ;
 	} ;
 
@@ -295,6 +298,12 @@ namespace Engine {
 		::string            txt      = {} ; // proc==LiveOut
 	} ;
 
+	struct EngineClosureCache {
+		friend ::ostream& operator<<( ::ostream& , EngineClosureCache const& ) ;
+		Job job = {} ;                      // job whose cache match was delayed and is now ready to be retried
+		Req req = {} ;                      // .
+	} ;
+
 	struct EngineClosure {
 		friend ::ostream& operator<<( ::ostream& , EngineClosure const& ) ;
 		//
@@ -303,6 +312,7 @@ namespace Engine {
 		using ECR  = EngineClosureReq     ;
 		using ECJ  = EngineClosureJob     ;
 		using ECJM = EngineClosureJobMngt ;
+		using ECC  = EngineClosureCache   ;
 		//
 		using GP  = GlobalProc  ;
 		using RP  = ReqProc     ;
@@ -342,6 +352,8 @@ namespace Engine {
 		EngineClosure( JMP p , JE&& je , Fd fd_ , ::vmap_s<DepDigest>&& dds ) : kind{K::JobMngt} , ecjm{.proc=p,.job_exec=::move(je),.fd{fd_},.deps{::move(dds)}} {
 			SWEAR( p==JMP::DepVerbose || p==JMP::ChkDeps ) ;
 		}
+		// Cache
+		EngineClosure( J j , R r ) : kind{K::Cache} , ecc{.job=j,.req=r} {}
 		//
 		EngineClosure(EngineClosure&& ec) : kind(ec.kind) {
 			switch (ec.kind) {
@@ -349,6 +361,7 @@ namespace Engine {
 				case K::Req     : new(&ecr ) ECR {::move(ec.ecr )} ; break ;
 				case K::Job     : new(&ecj ) ECJ {::move(ec.ecj )} ; break ;
 				case K::JobMngt : new(&ecjm) ECJM{::move(ec.ecjm)} ; break ;
+				case K::Cache   : new(&ecc ) ECC {::move(ec.ecc )} ; break ;
 			DF}
 		}
 		~EngineClosure() {
@@ -357,6 +370,7 @@ namespace Engine {
 				case K::Req     : ecr .~ECR () ; break ;
 				case K::Job     : ecj .~ECJ () ; break ;
 				case K::JobMngt : ecjm.~ECJM() ; break ;
+				case K::Cache   : ecc .~ECC () ; break ;
 			DF}
 		}
 		EngineClosure& operator=(EngineClosure const& ec) = delete ;
@@ -368,6 +382,7 @@ namespace Engine {
 			ECR  ecr  ;
 			ECJ  ecj  ;
 			ECJM ecjm ;
+			ECC  ecc  ;
 		} ;
 	} ;
 
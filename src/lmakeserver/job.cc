@@ -408,7 +408,7 @@ namespace Engine {
 					}
 					//
 					if (target->is_src_anti()) {                                       // source may have been modified
-						if (!crc.valid()) crc = Crc(tn,g_config.hash_algo) ;           // force crc computation if updating a source
+						if (!crc.valid()) crc = Crc(tn) ;                               // force crc computation if updating a source
 						//
 						/**/                           if (td.extra_tflags[ExtraTflag::SourceOk]) goto SourceOk ;
 						for( Req req : running_reqs_ ) if (req->options.flags[ReqFlag::SourceOk]) goto SourceOk ;
@@ -440,9 +440,9 @@ namespace Engine {
 				}
 			}
 			::sort(targets) ;                                                          // ease search in targets
-			//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-			(*this)->targets.assign(targets) ;
-			//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+			//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+			(*this)->assign_targets(targets) ;
+			//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 		}
 		//
 		// handle deps
@@ -477,9 +477,9 @@ namespace Engine {
 				deps.push_back(dep) ;
 				trace("dep",dep) ;
 			}
-			//vvvvvvvvvvvvvvvvvvvvvvvv
-			(*this)->deps.assign(deps) ;
-			//^^^^^^^^^^^^^^^^^^^^^^^^
+			//vvvvvvvvvvvvvvvvvvvvvvvvvv
+			(*this)->assign_deps(deps) ;
+			//^^^^^^^^^^^^^^^^^^^^^^^^^^
 		}
 		//
 		// wrap up
@@ -551,14 +551,14 @@ namespace Engine {
 		bool update_deps = seen_dep_date && full_ok                                  ; // if full_ok, all deps have been resolved and we can update the record for a more reliable info
 		bool update_msg  = all_done && (+err_reason||+local_msg||+severe_msg)        ; // if recorded local_msg was incomplete, update it
 		if ( update_deps || update_msg ) {
-			JobInfo ji      = (*this)->job_info() ;
-			bool    updated = false               ;
+			JobInfoEnd jie     = (*this)->job_info({JobInfoKind::End,JobInfoKind::Out}).end ; // start section is not modified
+			bool       updated = false                                                    ;
 			if (update_msg) {
-				append_line_to_string( ji.end.end.msg , +err_reason ? reason_str(err_reason)+'\n' : local_msg , severe_msg ) ;
+				append_line_to_string( jie.end.msg , +err_reason ? reason_str(err_reason)+'\n' : local_msg , severe_msg ) ;
 				updated = true ;
 			}
 			if (update_deps) {
-				::vmap_s<DepDigest>& dds = ji.end.end.digest.deps ;
+				::vmap_s<DepDigest>& dds = jie.end.digest.deps ;
 				NodeIdx              di  = 0                      ;
 				for( Dep const& d : (*this)->deps ) {
 					DepDigest& dd = dds[di].second ;
@@ -570,7 +570,7 @@ namespace Engine {
 				}
 				SWEAR(di==dds.size()) ;                                                // deps must be coherent between ancillary file and internal info
 			}
-			if (updated) (*this)->write_job_info(ji) ;
+			if (updated) (*this)->write_job_info(jie) ;
 		}
 		// as soon as job is done for a req, it is meaningful and justifies to be cached, in practice all reqs agree most of the time
 		if ( full_ok && +cache_none_attrs.key ) {                                      // cache only successful results
@@ -640,6 +640,35 @@ namespace Engine {
 		targets.assign(ts) ;
 	}
 
+	void JobData::assign_targets(::vector<Target> const& ts) {
+		::uset<Node> old_targets = inv_nodes(true/*target*/) ;
+		targets.assign(ts) ;
+		inv_update(true/*target*/,old_targets) ;
+	}
+
+	void JobData::assign_deps(::vector<Dep> const& ds) {
+		::uset<Node> old_deps = inv_nodes(false/*target*/) ;
+		deps.assign(ds) ;
+		inv_update(false/*target*/,old_deps) ;
+	}
+
+	::uset<Node> JobData::inv_nodes(bool target) const {
+		::uset<Node> res ;
+		if (target) for( Target     t : targets ) res.insert(t) ;
+		else        for( Dep const& d : deps    ) res.insert(d) ;
+		return res ;
+	}
+
+	// reverse index is exact : links to lost nodes are removed (and reused) and links to new nodes are added
+	void JobData::inv_update( bool target , ::uset<Node> const& old_nodes ) const {
+		Job          j         = idx()             ;
+		::uset<Node> new_nodes = inv_nodes(target) ;
+		::uset<Node> del_nodes ;
+		for( Node n : old_nodes ) if (!new_nodes.contains(n)) del_nodes.insert(n) ;
+		/**/                                                  Persistent::inv_del(target,del_nodes,j) ;
+		for( Node n : new_nodes ) if (!old_nodes.contains(n)) Persistent::inv_add(target,n        ,j) ;
+	}
+
 	void JobData::_set_pressure_raw(ReqInfo& ri , CoarseDelay pressure ) const {
 		Trace trace("set_pressure",idx(),ri,pressure) ;
 		Req         req          = ri.req                               ;
@@ -777,7 +806,9 @@ namespace Engine {
 							static_deps.push_back(*it) ;
 							static_deps.back().accesses = {} ;
 						}
+						::uset<Node> old_deps = inv_nodes(false/*target*/) ;
 						deps.replace_tail(iter,static_deps) ;
+						inv_update(false/*target*/,old_deps) ;
 						seen_all = !static_deps ;
 					}
 					stamped_seen_waiting = proto_seen_waiting ;
@@ -944,8 +975,8 @@ namespace Engine {
 		if ( auto it = req->missing_audits.find(idx()) ; it!=req->missing_audits.end() && !req.zombie() ) {
 			JobAudit const& ja = it->second ;
 			trace("report_missing",ja) ;
-			JobInfo         ji     = job_info()               ;
-			::string const& stderr = ji.end.end.digest.stderr ;
+			JobInfo         ji     = job_info(JobInfoKind::Out) ;
+			::string const& stderr = ji.end.end.digest.stderr   ;
 			//
 			if (ja.report!=JobReport::Hit) {                                                    // if not Hit, then job was rerun and ja.report is the report that would have been done w/o rerun
 				SWEAR(req->stats.ended(JobReport::Rerun)>0) ;
@@ -1046,7 +1077,7 @@ namespace Engine {
 					SpecialStep ss = SpecialStep::Idle ;
 					if (!( t->crc.valid() && FileSig(nfs_guard.access(tn))==t->date().sig )) {
 						FileSig sig  ;
-						Crc   crc { sig , tn , g_config.hash_algo } ;
+						Crc   crc { sig , tn } ;
 						modified |= crc.match(t->crc) ? No : t->crc.valid() ? Yes : Maybe ;
 						Trace trace( "frozen" , t->crc ,"->", crc , t->date() ,"->", sig ) ;
 						//vvvvvvvvvvvvvvvvvvvvvvvvvv
@@ -1103,7 +1134,13 @@ namespace Engine {
 		if (+cache_none_attrs.key) {
 			Cache*       cache       = Cache::s_tab.at(cache_none_attrs.key) ;
 			Cache::Match cache_match = cache->match(idx(),req)               ;
-			if (!cache_match.completed) FAIL("delayed cache not yet implemented") ;
+			if (!cache_match.completed) {
+				ri.inc_wait() ;                                                                               // cache posts an EngineClosureCache when ready, which wakes us up
+				req->n_cache_waits++ ;                                                                      // req must not end before
+				if (rule->n_submits) ri.n_submits-- ;                                                       // job is submitted again upon wakeup, this is not a new submission
+				trace("cache_delayed",ri) ;
+				return true/*maybe_new_deps*/ ;
+			}
 			switch (cache_match.hit) {
 				case Yes :
 					try {
@@ -1111,7 +1148,7 @@ namespace Engine {
 						//
 						vmap<Node,FileAction> fas     = pre_actions(match).first ;
 						::vmap_s<FileAction>  actions ; for( auto [t,a] : fas ) actions.emplace_back( t->name() , a ) ;
-						::pair_s<bool/*ok*/>  dfa_msg = do_file_actions( ::move(actions) , nfs_guard , g_config.hash_algo ) ;
+						::pair_s<bool/*ok*/>  dfa_msg = do_file_actions( ::move(actions) , nfs_guard ) ;
 						//
 						if ( +dfa_msg.first || !dfa_msg.second ) {
 							run_status = RunStatus::Err ;
@@ -1122,7 +1159,7 @@ namespace Engine {
 						}
 						//
 						JobDigest digest = cache->download(idx(),cache_match.id,reason,nfs_guard) ;
-						JobExec  je      { idx() , FileSig(ancillary_file()) , New }      ;                   // job starts and ends, no host
+						JobExec  je      { idx() , New , New }                            ;                   // job starts and ends, no host
 						if (ri.live_out) je.live_out(ri,digest.stdout) ;
 						ri.step(Step::Hit) ;
 						trace("hit_result") ;
@@ -1241,11 +1278,15 @@ namespace Engine {
 		if (deps_) {
 			::vector<Dep> static_deps ;
 			for( Dep const& d : deps )  if (d.dflags[Dflag::Static]) static_deps.push_back(d) ;
-			deps.assign(static_deps) ;
+			assign_deps(static_deps) ;
 		}
 		if (!rule->is_special()) {
 			exec_gen = 0 ;
-			if (targets_) _reset_targets() ;
+			if (targets_) {
+				::uset<Node> old_targets = inv_nodes(true/*target*/) ;
+				_reset_targets() ;
+				inv_update(true/*target*/,old_targets) ;
+			}
 		}
 		trace("summary",deps) ;
 		return true ;
@@ -1262,6 +1303,13 @@ namespace Engine {
 		return res ;
 	}
 
+	JobInfo JobData::job_info(BitMap<JobInfoKind> kinds) const {
+		return Persistent::_job_info_file.read(+idx(),kinds) ;
+	}
+	SigDate JobData::write_job_info(JobInfo      const& ji ) const { return Persistent::_job_info_file.write(+idx(),ji ) ; }
+	SigDate JobData::write_job_info(JobInfoStart const& jis) const { return Persistent::_job_info_file.write(+idx(),jis) ; }
+	SigDate JobData::write_job_info(JobInfoEnd   const& jie) const { return Persistent::_job_info_file.write(+idx(),jie) ; }
+
 	::string JobData::ancillary_file(AncillaryTag tag) const {
 		::string str        = to_string('0',+idx()) ;                                              // ensure size is even as we group by 100
 		bool     skip_first = str.size()&0x1        ;                                              // need initial 0 if required to have an even size
@@ -1269,7 +1317,6 @@ namespace Engine {
 		::string res        ;
 		switch (tag) {
 			case AncillaryTag::Backend : res = PrivateAdminDir          + "/backend"s ; break ;
-			case AncillaryTag::Data    : res = g_config.local_admin_dir + "/job_data" ; break ;
 			case AncillaryTag::Dbg     : res = AdminDir                 + "/debug"s   ; break ;
 			case AncillaryTag::KeepTmp : res = AdminDir                 + "/tmp"s     ; break ;
 		DF}
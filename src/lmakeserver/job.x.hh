@@ -9,7 +9,6 @@
 
 ENUM( AncillaryTag
 ,	Backend
-,	Data
 ,	Dbg
 ,	KeepTmp
 )
@@ -311,12 +310,14 @@ namespace Engine {
 		//
 		Tflags tflags(Node target) const ;
 		//
-		void     end_exec      (                               ) const ;            // thread-safe
-		::string ancillary_file(AncillaryTag=AncillaryTag::Data) const ;
-		JobInfo  job_info      (                               ) const { return  {                ancillary_file() } ; }
-		void     write_job_info(JobInfo const& ji              ) const { ji.write(Disk::dir_guard(ancillary_file())) ; }
-		::string special_stderr(Node                           ) const ;
-		::string special_stderr(                               ) const ;            // cannot declare a default value for incomplete type Node
+		void          end_exec      (                            ) const ;          // thread-safe
+		::string      ancillary_file(AncillaryTag                ) const ;
+		JobInfo       job_info      (BitMap<JobInfoKind> ={}     ) const ;          // thread-safe, {} means all sections
+		Disk::SigDate write_job_info(JobInfo      const&         ) const ;          // thread-safe, return date at which info is recorded
+		Disk::SigDate write_job_info(JobInfoStart const&         ) const ;          // .
+		Disk::SigDate write_job_info(JobInfoEnd   const&         ) const ;          // .
+		::string      special_stderr(Node                        ) const ;
+		::string      special_stderr(                            ) const ;          // cannot declare a default value for incomplete type Node
 		//
 		void              invalidate_old() ;
 		Rule::SimpleMatch simple_match  () const ;                                  // thread-safe
@@ -337,6 +338,11 @@ namespace Engine {
 		//
 		bool/*ok*/ forget( bool targets , bool deps ) ;
 		//
+		void         assign_targets( ::vector<Target> const&                        ) ;       // maintain reverse index while assigning targets
+		void         assign_deps   ( ::vector<Dep   > const&                        ) ;       // .                                          deps
+		::uset<Node> inv_nodes     ( bool target                                    ) const ; // targets/deps as recorded in reverse index
+		void         inv_update    ( bool target , ::uset<Node> const& old_nodes={} ) const ; // update reverse index after targets/deps went from old_nodes to current ones
+		//
 		void add_watcher( ReqInfo& ri , Node watcher , NodeReqInfo& wri , CoarseDelay pressure ) ;
 		//
 		void audit_end_special( Req , SpecialStep , Bool3 modified , Node ) const ; // modified=Maybe means file is new
@@ -255,6 +255,7 @@ bool/*interrupted*/ engine_loop() {
 			//vvvvvvvvvvvvvvvvv
 			Backend::s_launch() ;                                                  // we are going to wait, tell backend as it may have retained jobs to process them with as mauuch info as possible
 			//^^^^^^^^^^^^^^^^^
+			while ( !g_engine_queue && NodeData::s_prefetch_step() ) ;             // use idle time to find srcs to prefetch, a step is short enough not to delay events
 		}
 		if ( Pdate now=New ; empty || now>next_stats_date ) {
 			for( auto const& [r,_] : fd_tab ) if (+r->audit_fd) r->audit_stats() ; // refresh title
@@ -271,6 +272,10 @@ bool/*interrupted*/ engine_loop() {
 						Backend::s_kill_all() ;
 						//       ^^^^^^^^^^^^
 						return true ;
+					case GlobalProc::SrcWatch :
+						trace("src_watch") ;
+						NodeData::s_refresh_src_watcher(false/*refresh_point*/) ;
+					break ;
 					case GlobalProc::Wakeup :
 						trace("wakeup") ;
 					break ;
@@ -386,6 +391,20 @@ bool/*interrupted*/ engine_loop() {
 					} break ;
 				DF}
 			} break ;
+			case EngineClosureKind::Cache : {
+				EngineClosureCache& ecc = closure.ecc ;
+				trace("cache",ecc.job,ecc.req) ;
+				SWEAR(ecc.req->n_cache_waits) ;
+				ecc.req->n_cache_waits-- ;
+				JobIdx n_cache_waits = ecc.req->n_cache_waits ;
+				//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
+				ecc.job->wakeup(ecc.job->req_info(ecc.req)) ;      // cache match is ready, retry submission
+				//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
+				// job may not have called match again (e.g. if killed), result must not be used by a later req with same index
+				// but if job waits again (e.g. for a download), the next result may already be there
+				if (ecc.req->n_cache_waits==n_cache_waits) for( auto const& [_,c] : Cache::s_tab ) c->forget(ecc.req,ecc.job) ;
+				ecc.req.chk_end() ;
+			} break ;
 		DF}
 	}
 	trace("done") ;
@@ -459,6 +478,7 @@ int main( int argc , char** argv ) {
 	//                 vvvvvvvvvvvvv
 	bool interrupted = engine_loop() ;
 	//                 ^^^^^^^^^^^^^
+	Cache::s_flush() ;
 	unlnk(g_config.remote_tmp_dir,true/*dir_ok*/) ;                                     // cleanup
 	//
 	trace("done",STR(interrupted),Pdate(New)) ;
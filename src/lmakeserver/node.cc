@@ -5,6 +5,9 @@
 
 #include "core.hh"
 
+#include <poll.h>
+#include <sys/inotify.h>
+
 namespace Engine {
 	using namespace Disk ;
 	using namespace Time ;
@@ -33,10 +36,310 @@ namespace Engine {
 		return  os << ')'  ;
 	}
 
+	//
+	// SrcPrefetch
+	//
+
+	// stat & crc of srcs are computed by a pool of threads so that the engine thread mostly finds them ready when it refreshes them
+	// only a hint : if an entry is not ready (or not prefetched at all), the engine thread does the job itself as usual
+	// srcs are found by walking last known deps from req targets, which requires the store and is done by engine thread in small steps when it is idle
+	struct SrcPrefetch {
+		static constexpr size_t StepSz = 1000 ;                                   // max number of nodes visited in a single step, so that engine thread is never held for long
+		struct Item {
+			Node     node    ;
+			::string name    ;
+			FileSig  sig     ;                                                    // sig for which crc is known, no need to recompute it if file still matches
+			size_t   epoch   = 0 ;
+		} ;
+		struct Entry {
+			FileInfo fi       ;
+			Crc      crc      ;                                                   // Unknown if not computed
+			size_t   gen      = 0     ;                                           // src watcher gen when entry was queued, probe is done afterwards
+			size_t   n_events = 0     ;                                           // number of events seen by src watcher on dir when entry was queued
+			bool     ready    = false ;
+		} ;
+		void _thread_func(::stop_token) ;
+		// cxtors & casts
+		SrcPrefetch() {
+			size_t n_threads = ::min( size_t(::thread::hardware_concurrency()) , size_t(8) ) ;
+			for( size_t t=0 ; t<::max(n_threads,size_t(1)) ; t++ ) _threads.emplace_back( [this](::stop_token stop)->void { _thread_func(stop) ; } ) ;
+		}
+		// services, called by engine thread
+		void queue( Node n , ::string&& name , FileSig const& sig , size_t gen , size_t n_events ) {
+			{	Lock lock { _mutex } ;
+				Entry& e = _entries[n] ; e = {} ; e.gen = gen ; e.n_events = n_events ;
+			}
+			_queue.emplace( Item{ .node=n , .name=::move(name) , .sig=sig , .epoch=_epoch } ) ;
+		}
+		bool/*found*/ get( Node n , FileInfo&/*out*/ fi , Crc&/*out*/ crc , size_t&/*out*/ gen , size_t&/*out*/ n_events ) { // each entry is used at most once
+			Lock lock { _mutex } ;
+			auto it = _entries.find(n) ; if (it==_entries.end()) return false ;
+			Entry e = it->second ;
+			_entries.erase(it) ;                                                  // if not ready, prefetching thread will find no entry to fill
+			if (!e.ready) return false ;
+			fi       = e.fi       ;
+			crc      = e.crc      ;
+			gen      = e.gen      ;
+			n_events = e.n_events ;
+			return true ;
+		}
+		void restart() {                                                          // forget prefetched data, but keep nodes still to visit
+			Lock lock { _mutex } ;
+			_epoch++ ;
+			_entries.clear() ;
+			seen = { todo.begin() , todo.end() } ;
+		}
+		void clear() {                                                            // forget everything, items already queued are ignored, no need to wait for threads
+			Lock lock { _mutex } ;
+			_epoch++ ;
+			_entries.clear() ;
+			todo    .clear() ;
+			seen    .clear() ;
+		}
+		// data
+		::deque<Node> todo ;                                                      // accessed by engine thread only, nodes to visit
+		::uset <Node> seen ;                                                      // .                              nodes already visited
+	private :
+		Mutex<MutexLvl::SrcPrefetch> _mutex   ;
+		::umap<Node,Entry>           _entries ;                                   // protected by _mutex
+		::atomic<size_t>             _epoch   = 1 ;                               // incremented by clear, items queued before are ignored
+		ThreadQueue<Item>            _queue   ;
+		::vector<::jthread>          _threads ;                                   // ensure _threads is last so other fields are constructed when they start
+	} ;
+
+	void SrcPrefetch::_thread_func(::stop_token stop) {
+		t_thread_key = 'P' ;
+		Trace trace("SrcPrefetch::_thread_func") ;
+		NfsGuard nfs_guard { g_config.reliable_dirs } ;
+		for(;;) {
+			auto [popped,item] = _queue.pop(stop) ;
+			if (!popped             ) break    ;
+			if (item.epoch!=_epoch  ) continue ;                                  // prefetch has been cleared since item was queued
+			FileInfo fi  = FileInfo(nfs_guard.access(item.name)) ;
+			Crc      crc ;
+			if ( +fi && FileSig(fi)!=item.sig ) {
+				FileSig sig ;
+				try {
+					Crc c = Crc(sig/*out*/,item.name) ;
+					if ( sig==FileSig(fi) && c!=Crc::Reg && c!=Crc::Lnk ) crc = c ;   // file must be stable and as stat'ed
+				} catch (::string const&) {}                                          // crc is left Unknown
+			}
+			Lock lock { _mutex } ;
+			if (item.epoch!=_epoch) continue ;
+			auto it = _entries.find(item.node) ; if (it==_entries.end()) continue ; // engine thread has already refreshed node by itself
+			it->second.fi    = fi   ;
+			it->second.crc   = crc  ;
+			it->second.ready = true ;
+		}
+	}
+
+	static ::unique_ptr<SrcPrefetch> _g_src_prefetch ;
+
+	//
+	// SrcWatcher
+	//
+
+	// when config.watch_srcs is set, srcs found as recorded are marked clean and dirs leading to them are watched with inotify
+	// events are drained by a thread as they come so that the kernel queue does not overflow during long builds, and folded in by the engine thread
+	// a req start is a refresh point : pending events are folded in and dirs watched before it become reliable, clean srcs need not be probed
+	// only modifications made through the local kernel are seen, so srcs must not be modified from other hosts (e.g. through NFS)
+	struct SrcWatcher {
+		static constexpr uint32_t Mask   = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MODIFY | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO | IN_DONT_FOLLOW | IN_ONLYDIR ;
+		static constexpr size_t   MaxBuf = 1<<24 ;                                                 // if engine does not keep up, consider events are lost beyond this size
+		struct Dir {
+			::string          name     ;
+			size_t            gen      = 0 ;                                                       // dir is reliable once a refresh point has been passed after it started to be watched
+			size_t            n_events = 0 ;                                                       // events folded in, a probe made before the last one may miss a modification
+			::umap_s<FileSig> clean    ;                                                           // files known to be as recorded, with the recorded sig
+		} ;
+		static void _s_thread_func( ::stop_token , SrcWatcher* ) ;
+		// cxtors & casts
+		SrcWatcher() : fd{::inotify_init1(IN_NONBLOCK|IN_CLOEXEC)} {
+			if (+fd) _thread = ::jthread( _s_thread_func , this ) ;
+		}
+		// services
+		bool/*reliable*/ watch    ( ::string const& file , size_t probe_gen   ) ;                  // watch dirs leading to file, return true if they were watched before refresh point preceding probe
+		bool             is_clean ( ::string const& file , FileSig const& sig ) const ;
+		size_t           n_events ( ::string const& file                      ) const ;            // events folded in on dir of file, 0 if not watched
+		void             set_clean( ::string const& file , FileSig const& sig ) ;                  // file must be reliably watched
+		void             refresh  ( bool refresh_point                        ) ;                  // fold in pending events
+	private :
+		void _read (                   ) ;                                                         // read available events into _buf, _mutex must be locked
+		void _drop (::string const& dir) ;                                                         // stop watching dir and all dirs below it
+		void _reset(                   ) ;
+		// data
+	public :
+		AutoCloseFd     fd   ;
+		size_t          gen  = 1 ;
+		::umap<int,Dir> dirs ;                                                                     // indexed by watch descriptor, accessed by engine thread only
+		::map_s<int>    wds  ;                                                                     // indexed by dir name, ordered so that sub-dirs are contiguous
+	private :
+		Mutex<MutexLvl::SrcWatcher> _mutex    ;                                                    // protects _buf and _overflow
+		::string                    _buf      ;                                                    // events read but not yet folded in
+		bool                        _overflow = false ;
+		::atomic<bool>              _posted   = false ;                                            // a fold request is in the engine queue
+		::jthread                   _thread   ;                                                    // ensure thread is last so other fields are constructed when it starts
+	} ;
+
+	void SrcWatcher::_s_thread_func( ::stop_token stop , SrcWatcher* self ) {
+		t_thread_key = 'W' ;
+		Trace trace("SrcWatcher::_s_thread_func") ;
+		struct ::pollfd pfd { .fd=self->fd , .events=POLLIN , .revents=0 } ;
+		while (!stop.stop_requested()) {
+			if (::poll(&pfd,1,100/*ms*/)<=0) continue ;                                            // timeout allows to check stop
+			bool post ;
+			{	Lock lock { self->_mutex } ;
+				self->_read() ;
+				post = ( +self->_buf || self->_overflow ) && !self->_posted.exchange(true) ;
+			}
+			if (post) g_engine_queue.emplace(GlobalProc::SrcWatch) ;                               // only post once until engine has folded events in
+		}
+	}
+
+	void SrcWatcher::_read() {
+		alignas(struct inotify_event) char buf[4096] ;
+		for(;;) {
+			ssize_t cnt = ::read(fd,buf,sizeof(buf)) ;
+			if (cnt<=0) break ;                                                                    // EAGAIN : no more pending events
+			if (_buf.size()+cnt>MaxBuf) { _overflow = true ; _buf.clear() ; continue ; }
+			_buf.append(buf,cnt) ;
+		}
+	}
+
+	bool/*reliable*/ SrcWatcher::watch( ::string const& file , size_t probe_gen ) {
+		if ( !fd || !is_lcl(file) ) return false ;
+		::vector_s to_watch ;                                                                      // dirs not watched yet, deepest first
+		for( ::string d=dir_name(file) ;; d=dir_name(d) ) {
+			auto it = wds.find(d) ;
+			if (it!=wds.end()) {                                                                   // dirs above are watched as they are dropped with dirs below
+				if (!to_watch) return dirs.at(it->second).gen<probe_gen ;
+				break ;
+			}
+			to_watch.push_back(d) ;
+			if (!d) break ;
+		}
+		for( auto it=to_watch.rbegin() ; it!=to_watch.rend() ; it++ ) {                            // watch top-down so that a watched dir always has its dirs above watched
+			int wd = ::inotify_add_watch( fd , +*it?it->c_str():"." , Mask ) ;
+			if ( wd<0 || dirs.contains(wd) ) break ;                                               // e.g. too many watches, file will be probed
+			dirs.try_emplace( wd , Dir{*it,gen,0/*n_events*/,{}} ) ;
+			wds [*it] = wd ;
+		}
+		return false ;
+	}
+
+	bool SrcWatcher::is_clean( ::string const& file , FileSig const& sig ) const {
+		auto it = wds.find(dir_name(file)) ; if (it==wds.end()) return false ;
+		Dir const& d   = dirs.at(it->second)         ;
+		auto       it2 = d.clean.find(base_name(file)) ;
+		return it2!=d.clean.end() && it2->second==sig ;
+	}
+
+	size_t SrcWatcher::n_events(::string const& file) const {
+		auto it = wds.find(dir_name(file)) ; if (it==wds.end()) return 0 ;                         // if dir is watched later, it is not reliable for probes made before
+		return dirs.at(it->second).n_events ;
+	}
+
+	void SrcWatcher::set_clean( ::string const& file , FileSig const& sig ) {
+		dirs.at(wds.at(dir_name(file))).clean[base_name(file)] = sig ;
+	}
+
+	// prefetched probes may predate watches set since last refresh point, so only a refresh point can make dirs reliable
+	void SrcWatcher::refresh(bool refresh_point) {
+		::string buf      ;
+		bool     overflow ;
+		_posted = false ;                                                                          // before reading so that events coming afterwards are posted again
+		{	Lock lock { _mutex } ;
+			_read() ;                                                                              // events generated up to now must be seen, even if thread has not read them yet
+			buf      = ::move(_buf)             ; _buf.clear() ;
+			overflow = ::exchange(_overflow,false) ;
+		}
+		Trace trace("SrcWatcher::refresh",STR(refresh_point),gen,dirs.size(),buf.size(),STR(overflow)) ;
+		if (refresh_point) gen++ ;
+		if (overflow     ) _reset() ;
+		for( size_t ofs=0 ; ofs<buf.size() ; ) {
+			struct inotify_event event ; ::memcpy( &event , buf.data()+ofs , sizeof(event) ) ;     // buf may not be aligned
+			::string name = event.len ? ::string(buf.data()+ofs+sizeof(event)) : ""s ;             // name is null terminated (and padded) when present
+			ofs += sizeof(event)+event.len ;
+			trace("event",event.wd,event.mask,name) ;
+			if (event.mask&IN_Q_OVERFLOW) { trace("overflow") ; _reset() ; continue ; }            // events have been lost, forget all
+			auto it = dirs.find(event.wd) ; if (it==dirs.end()) continue ;                         // dir has already been dropped
+			if (event.mask&(IN_DELETE_SELF|IN_MOVE_SELF|IN_IGNORED)) { _drop(::string(it->second.name)) ; continue ; } // copy name as entry is erased
+			it->second.n_events++ ;                                                                // file may not be clean yet, but a pending probe of it may be stale
+			it->second.clean.erase(name) ;
+			if (event.mask&(IN_CREATE|IN_DELETE|IN_MOVED_FROM|IN_MOVED_TO)) _drop( +it->second.name ? it->second.name+'/'+name : name ) ; // name may be a dir
+		}
+	}
+
+	void SrcWatcher::_drop(::string const& dir) {
+		if (!dir) { _reset() ; return ; }                                                          // all dirs are below top-level
+		::string dir_s = dir+'/' ;
+		auto drop1 = [&](::map_s<int>::iterator it)->::map_s<int>::iterator {
+			::inotify_rm_watch(fd,it->second) ;
+			dirs.erase(it->second) ;
+			return wds.erase(it) ;
+		} ;
+		if ( auto it=wds.find(dir) ; it!=wds.end() ) drop1(it) ;
+		for( auto it=wds.lower_bound(dir_s) ; it!=wds.end() && it->first.starts_with(dir_s) ;) it = drop1(it) ;
+	}
+
+	void SrcWatcher::_reset() {
+		for( auto const& [wd,_] : dirs ) ::inotify_rm_watch(fd,wd) ;
+		dirs.clear() ;
+		wds .clear() ;
+	}
+
+	static ::unique_ptr<SrcWatcher> _g_src_watcher ;
+
 	//
 	// NodeData
 	//
 
+	void NodeData::s_prefetch_srcs(::vector<Node> const& roots) {
+		if (!_g_src_prefetch) _g_src_prefetch = ::make_unique<SrcPrefetch>() ;                      // threads are started once and kept for the server lifetime
+		else                  _g_src_prefetch->restart() ;                                         // data prefetched before req start may be stale for it, srcs must be probed anew
+		for( Node n : roots ) if (_g_src_prefetch->seen.insert(n).second) _g_src_prefetch->todo.push_back(n) ;
+		s_prefetch_step() ;                                                                         // srcs closest to roots are needed first, queue them right away
+	}
+
+	bool/*more*/ NodeData::s_prefetch_step() {
+		if ( !_g_src_prefetch || _g_src_prefetch->todo.empty() ) return false ;
+		SrcPrefetch& pf       = *_g_src_prefetch                         ;
+		SrcWatcher*  sw       = _g_src_watcher.get()                     ;
+		size_t       gen      = sw ? sw->gen : 0                         ;
+		size_t       n_nodes  = 0                                        ;
+		size_t       n_queued = 0                                        ;
+		Trace trace("s_prefetch_step",pf.todo.size()) ;
+		for(; !pf.todo.empty() && n_nodes<SrcPrefetch::StepSz ; n_nodes++ ) {                      // breadth first, so that srcs are prefetched roughly in the order they are needed
+			Node n = pf.todo.front() ; pf.todo.pop_front() ;
+			switch (n->buildable) {
+				case Buildable::DynSrc :
+				case Buildable::Src    :
+				case Buildable::SubSrc :
+				{	if (!n->is_plain()) break ;
+					::string name = n->name() ;
+					if ( sw && n->crc.valid() && n->crc.exists() && sw->is_clean(name,n->date().sig) ) break ; // no need to probe
+					size_t n_events = sw ? sw->n_events(name) : 0 ;
+					pf.queue( n , ::move(name) , n->crc.valid()?n->date().sig:FileSig() , gen , n_events ) ;
+					n_queued++ ;
+				} break ;
+				default :
+					if (n->has_actual_job()) for( Dep const& d : n->actual_job()->deps ) if (pf.seen.insert(d).second) pf.todo.push_back(d) ;
+			}
+		}
+		trace("done",n_nodes,n_queued,pf.todo.size()) ;
+		return !pf.todo.empty() ;
+	}
+
+	void NodeData::s_refresh_src_watcher(bool refresh_point) {
+		if (!g_config.watch_srcs) return ;
+		if (!_g_src_watcher) _g_src_watcher = ::make_unique<SrcWatcher>() ;
+		_g_src_watcher->refresh(refresh_point) ;
+	}
+
+	void NodeData::s_stop_prefetch() {
+		if (_g_src_prefetch) _g_src_prefetch->clear() ;                                            // threads are kept, they merely skip items that are no more useful
+	}
+
 	::ostream& operator<<( ::ostream& os , NodeData const& nd ) {
 		/**/                    os <<'('<< nd.crc ;
 		if (nd.is_plain()) {
@@ -94,15 +397,34 @@ namespace Engine {
 		for( Job j : conform_job_tgts(ri) ) j->set_pressure(j->req_info(ri.req),ri.pressure) ; // go through current analysis level as this is where we may have deps we are waiting for
 	}
 
-	bool/*modified*/ NodeData::refresh_src_anti( bool report_no_file , ::vector<Req> const& reqs_ , ::string const& name_ ) { // reqss_ are for reporting only
-		bool        prev_ok   = crc.valid() && crc.exists() ;
-		bool        frozen    = idx().frozen()              ;
-		const char* msg       = frozen ? "frozen" : "src"   ;
-		NfsGuard    nfs_guard { g_config.reliable_dirs }    ;
-		FileInfo    fi        { nfs_guard.access(name_) }   ;
-		FileSig     sig       { fi  }                       ;
-		Trace trace("refresh_src_anti",STR(report_no_file),reqs_,sig) ;
+	bool/*modified*/ NodeData::refresh_src_anti( bool report_no_file , ::vector<Req> const& reqs_ , ::string const& name_ , bool lazy ) { // reqss_ are for reporting only
+		bool        prev_ok = crc.valid() && crc.exists() ;
+		bool        frozen  = idx().frozen()              ;
+		const char* msg     = frozen ? "frozen" : "src"   ;
 		if (frozen) for( Req r : reqs_  ) r->frozen_nodes.emplace(idx(),r->frozen_nodes.size()) ;
+		if ( lazy && _g_src_watcher && prev_ok && _g_src_watcher->is_clean(name_,date().sig) ) {
+			Trace trace("refresh_src_anti","clean",STR(report_no_file),reqs_) ;
+			return false/*updated*/ ;                                                                   // file has not been touched since it was found as recorded
+		}
+		FileInfo fi     ;
+		Crc      pf_crc ;                                                                               // crc computed by prefetch, if any
+		size_t   pf_gen      = 0     ;                                                                  // src watcher gen when prefetch was queued
+		size_t   pf_n_events = 0     ;                                                                  // events seen on dir when prefetch was queued
+		bool     pf          = false ;
+		if ( _g_src_prefetch && _g_src_prefetch->get(idx(),fi/*out*/,pf_crc/*out*/,pf_gen/*out*/,pf_n_events/*out*/) ) pf = lazy ; // consume entry in all cases so a stale one is never used once node has been refreshed
+		auto set_clean = [&]()->void {
+			if (!( lazy && _g_src_watcher && crc.valid() && crc.exists() )                     ) return ;
+			if (!_g_src_watcher->watch(name_,pf?pf_gen:_g_src_watcher->gen)                    ) return ;
+			if ( pf && _g_src_watcher->n_events(name_)!=pf_n_events                            ) return ; // file may have been modified after it was probed
+			_g_src_watcher->set_clean(name_,date().sig) ;
+		} ;
+		if (!pf) {
+			NfsGuard nfs_guard { g_config.reliable_dirs } ;
+			fi     = FileInfo(nfs_guard.access(name_)) ;
+			pf_crc = {}                                ;
+		}
+		FileSig sig { fi } ;
+		Trace trace("refresh_src_anti",STR(report_no_file),reqs_,sig,STR(pf)) ;
 		if (!fi) {
 			if (report_no_file) for( Req r : reqs_  ) r->audit_job( Color::Err , "missing" , msg , name_ ) ;
 			if (crc==Crc::None) return false/*updated*/ ;
@@ -110,13 +432,17 @@ namespace Engine {
 			refresh(Crc::None) ;
 			//^^^^^^^^^^^^^^^^
 		} else {
-			if ( crc.valid() && sig==date().sig ) return false/*updated*/ ;
-			Crc crc_ = Crc::Reg ;
-			while ( crc_==Crc::Reg || crc_==Crc::Lnk ) crc_ = Crc(sig,name_,g_config.hash_algo) ;                             // ensure file is stable when computing crc
+			if ( crc.valid() && sig==date().sig ) { set_clean() ; return false/*updated*/ ; }
+			Crc crc_ = pf_crc ;
+			if (crc_==Crc::Unknown) {
+				crc_ = Crc::Reg ;
+				while ( crc_==Crc::Reg || crc_==Crc::Lnk ) crc_ = Crc(sig,name_) ;                         // ensure file is stable when computing crc
+			}
 			Accesses mismatch = crc.diff_accesses(crc_) ;
 			//vvvvvvvvvvvvvvvvvvv
 			refresh( crc_ , sig ) ;
 			//^^^^^^^^^^^^^^^^^^^
+			set_clean() ;
 			const char* step = !prev_ok ? "new" : +mismatch ? "changed" : "steady" ;
 			Color       c    = frozen ? Color::Warning : Color::HiddenOk           ;
 			for( Req r : reqs() ) { ReqInfo      & ri  = req_info  (r) ; if (fi.date>r->start_ddate              ) ri.overwritten |= mismatch ;             }
@@ -409,7 +735,7 @@ namespace Engine {
 				goto NoSrc ;
 		DF}
 	Src :
-		{	bool modified = refresh_src_anti( status()!=NodeStatus::None , {req} , lazy_name() ) ;
+		{	bool modified = refresh_src_anti( status()!=NodeStatus::None , {req} , lazy_name() , true/*lazy*/ ) ;
 			if (crc     !=Crc::None       ) status(NodeStatus::Src) ;                                   // overwrite status if it was pre-set to None
 			if (status()==NodeStatus::None) goto NoSrc           ;                                      // if status was pre-set to None, it means we accept NoSrc
 			if (modified                  ) goto ActuallyDoneDsk ;                                      // sources are always done on disk, as it is by probing it that we are done
@@ -689,7 +1015,7 @@ namespace Engine {
 			nd.date() = FileSig(ndn) ;
 		} else {
 			FileSig sig ;
-			Crc     crc { sig , ndn , g_config.hash_algo } ;
+			Crc     crc { sig , ndn } ;
 			if (!nd.crc.match(crc)) return {m,false/*refreshed*/} ; // real modif
 			nd.date() = sig ;
 		}
@@ -289,6 +289,11 @@ namespace Engine {
 		//
 		static constexpr RuleIdx MaxRuleIdx = Node::MaxRuleIdx ;
 		static constexpr RuleIdx NoIdx      = Node::NoIdx      ;
+		// statics
+		static void         s_prefetch_srcs      (::vector<Node> const& roots) ;                                      // stat & crc srcs reachable from roots through last known deps in the background
+		static bool/*more*/ s_prefetch_step      (                           ) ;                                      // walk a little further to find srcs to prefetch, return true if walk is not over
+		static void         s_stop_prefetch      (                           ) ;
+		static void         s_refresh_src_watcher(bool refresh_point         ) ;                                      // fold in pending src watcher events, if config.watch_srcs
 		// cxtors & casts
 		NodeData(                                          ) = delete ;                                               // if necessary, we must take care of the union
 		NodeData( Name n , bool no_dir , bool locked=false ) : DataBase{n} {
@@ -353,7 +358,7 @@ namespace Engine {
 		Manual manual_refresh( Req            r                )       { return manual_refresh(r,FileSig(name())) ; }
 		Manual manual_refresh( JobData const& j                )       { return manual_refresh(j,FileSig(name())) ; }
 		//
-		bool/*modified*/ refresh_src_anti( bool report_no_file , ::vector<Req> const& , ::string const& name ) ;      // Req's are for reporting only
+		bool/*modified*/ refresh_src_anti( bool report_no_file , ::vector<Req> const& , ::string const& name , bool lazy=false ) ; // Req's are for reporting only, if lazy, prefetch & watcher may be used
 		//
 		void full_refresh( bool report_no_file , ::vector<Req> const& reqs , ::string const& name ) {
 			set_buildable() ;
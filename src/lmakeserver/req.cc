@@ -70,6 +70,10 @@ namespace Engine {
 		//
 		Job::ReqInfo& jri = data.job->req_info(*this) ;
 		jri.live_out = (*this)->options.flags[ReqFlag::LiveOut] ;
+		{	::vector<Node> roots ; for( Node d : data.job->deps ) roots.push_back(d) ;
+			NodeData::s_refresh_src_watcher(true ) ;                                                 // must precede prefetch so that prefetched info are more recent than watcher info
+			NodeData::s_prefetch_srcs      (roots) ;                                                 // srcs are likely to be refreshed, prepare them in the background
+		}
 		//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
 		data.job->make(jri,JobMakeAction::Status,{}/*JobReason*/,No/*speculate*/) ;
 		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
@@ -95,6 +99,7 @@ namespace Engine {
 		SWEAR((*this)->is_open()) ;
 		SWEAR(!(*this)->n_running()) ;
 		if ((*this)->has_backend) Backend::s_close_req(+*this) ;
+		for( auto const& [_,c] : Cache::s_tab ) c->forget(*this) ;                  // req index may be reused, delayed match results must not survive
 		// erase req from sorted vectors by physically shifting reqs that are after
 		Idx n_reqs = s_n_reqs() ;
 		for( Idx i=(*this)->idx_by_start ; i<n_reqs-1 ; i++ ) {
@@ -102,6 +107,7 @@ namespace Engine {
 			s_reqs_by_start[i]->idx_by_start = i                    ;
 		}
 		s_reqs_by_start.pop_back() ;
+		if (!s_reqs_by_start) NodeData::s_stop_prefetch() ;                          // no more use for prefetched srcs
 		{	Lock lock{s_reqs_mutex} ;
 			for( Idx i=(*this)->idx_by_eta ; i<n_reqs-1 ; i++ ) {
 				_s_reqs_by_eta[i]             = _s_reqs_by_eta[i+1] ;
@@ -248,7 +254,7 @@ namespace Engine {
 		//
 		if ( !seen_stderr && job->run_status==RunStatus::Ok && !job->rule->is_special() ) { // show first stderr
 			Rule::SimpleMatch match          ;
-			JobInfo           job_info       = job->job_info()                                                ;
+			JobInfo           job_info       = job->job_info({JobInfoKind::Start,JobInfoKind::Out})           ;
 			EndNoneAttrs      end_none_attrs = job->rule->end_none_attrs.eval(job,match,job_info.start.rsrcs) ;
 			//
 			if (!job_info.end.end.proc) (*this)->audit_info( Color::Note , "no stderr available" , lvl+1 ) ;
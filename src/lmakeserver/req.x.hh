@@ -232,7 +232,7 @@ namespace Engine {
 		bool   operator+() const { return +job                                                ; }
 		bool   operator!() const { return !+*this                                             ; }
 		bool   is_open  () const { return idx_by_start!=Idx(-1)                               ; }
-		JobIdx n_running() const { return stats.cur(JobStep::Queued)+stats.cur(JobStep::Exec) ; }
+		JobIdx n_running() const { return stats.cur(JobStep::Queued)+stats.cur(JobStep::Exec)+n_cache_waits ; }
 		// services
 		void audit_summary(bool err) const ;
 		//
@@ -277,6 +277,7 @@ namespace Engine {
 		Pdate                eta            ;           // Estimated Time of Arrival
 		::umap<Rule,JobIdx > ete_n_rules    ;           // number of jobs participating to stats.ete with exec_time from rule
 		bool                 has_backend    = false   ;
+		JobIdx               n_cache_waits  = 0       ; // number of jobs waiting for a delayed cache match, they are not done but not running either
 		// summary
 		::vector<Node>        up_to_dates  ;            // asked nodes already done when starting
 		::umap<Job ,JobIdx  > frozen_jobs  ;            // frozen     jobs                                   (value is just for summary ordering purpose)
@@ -1197,6 +1197,7 @@ namespace Engine {
 			if (+interpreter    ) do_field( "interpreter" , interpreter                ) ;
 			if ( sca.auto_mkdir ) do_field( "auto_mkdir"  , to_string(sca.auto_mkdir ) ) ;
 			if ( sca.ignore_stat) do_field( "ignore_stat" , to_string(sca.ignore_stat) ) ;
+			if ( sca.shm_report ) do_field( "shm_report"  , to_string(sca.shm_report ) ) ;
 			if (+sca.chroot     ) do_field( "chroot"      ,           sca.chroot       ) ;
 			if (+sca.tmp        ) do_field( "tmp"         ,           sca.tmp          ) ;
 			if ( sca.use_script ) do_field( "use_script"  , to_string(sca.use_script ) ) ;
@@ -231,15 +231,18 @@ namespace Engine {
 			Attrs::acquire_from_dct( chroot      , py_dct , "chroot"      ) ;
 			Attrs::acquire_env     ( env         , py_dct , "env"         ) ;
 			Attrs::acquire_from_dct( ignore_stat , py_dct , "ignore_stat" ) ;
+			Attrs::acquire_from_dct( shm_report  , py_dct , "shm_report"  ) ;
 			Attrs::acquire_from_dct( tmp         , py_dct , "tmp"         ) ;
 			Attrs::acquire_from_dct( use_script  , py_dct , "use_script"  ) ;
 			::sort(env) ;                                                                                                                                // stabilize cmd crc
 		}
 		void chk(AutodepMethod method) {                                                                                                                 // PER_AUTODEP_METHOD : handle case
 			switch (method) {
-				case AutodepMethod::None    :                                                                                                            // cannot map if not spying
-				case AutodepMethod::Ptrace  : if (+tmp         ) throw to_string("cannot map tmp directory from ",tmp," with autodep=",method) ; break ; // cannot alloc mem in traced child ...
-				case AutodepMethod::LdAudit : if (!HAS_LD_AUDIT) throw to_string(method," is not supported on this system")                    ; break ; // ... to hold mapped path
+				case AutodepMethod::None         :                                                                                                       // cannot map if not spying
+				case AutodepMethod::Ptrace       : if (+tmp              ) throw to_string("cannot map tmp directory from ",tmp," with autodep=",method) ; break ; // cannot alloc mem in traced child ...
+				case AutodepMethod::LdAudit      : if (!HAS_LD_AUDIT     ) throw to_string(method," is not supported on this system")                    ; break ; // ... to hold mapped path
+				case AutodepMethod::SeccompNotif : if (!HAS_SECCOMP_NOTIF) throw to_string(method," is not supported on this system")                    ;
+				/**/                               if (+tmp              ) throw to_string("cannot map tmp directory from ",tmp," with autodep=",method) ; break ; // cannot alter syscall args
 				default : ;
 			}
 		}
@@ -248,6 +251,7 @@ namespace Engine {
 		::vector_s    interpreter ;
 		bool          auto_mkdir  = false ;
 		bool          ignore_stat = false ;
+		bool          shm_report  = false ;
 		::string      chroot      ;
 		::vmap_ss     env         ;
 		::string      tmp         ;
@@ -435,6 +439,7 @@ namespace Engine {
 		using Base::spec            ;
 		using Base::_s_eval         ;
 		using Base::append_dbg_info ;
+		static constexpr size_t EvalCacheSz = 1024 ; // cache is cleared when full, which is enough to adapt to the rare cases where attribute depends on job specific variables
 		// statics
 		static bool s_is_dynamic(Py::Tuple const&) ;
 		// cxtors & casts
@@ -471,13 +476,15 @@ namespace Engine {
 			return parse_fstr( fstr , {} , const_cast<Rule::SimpleMatch&>(m) , rsrcs ) ;                                                           // cannot lazy evaluate w/o a job
 		}
 	protected :
-		Py::Ptr<Py::Object> _eval_code( Job , Rule::SimpleMatch      &   , ::vmap_ss const& rsrcs={} , ::vmap_s<DepDigest>* deps=nullptr ) const ;
+		Py::Ptr<Py::Object> _eval_code( Job , Rule::SimpleMatch      &   , ::vmap_ss const& rsrcs={} , ::vmap_s<DepDigest>* deps=nullptr , bool*/*out*/ accessed=nullptr ) const ;
 		Py::Ptr<Py::Object> _eval_code(       Rule::SimpleMatch const& m , ::vmap_ss const& rsrcs={} , ::vmap_s<DepDigest>* deps=nullptr ) const { // cannot lazy evaluate w/o a job
 			return _eval_code( {} , const_cast<Rule::SimpleMatch&>(m) , rsrcs , deps ) ;
 		}
 		// data
 	private :
-		mutable Mutex<MutexLvl::Rule> _glbs_mutex ; // ensure glbs is not used for several jobs simultaneously
+		mutable Mutex<MutexLvl::Rule>      _glbs_mutex       ; // ensure glbs is not used for several jobs simultaneously
+		mutable Mutex<MutexLvl::EvalCache> _eval_cache_mutex ;
+		mutable ::umap<Crc,T>              _eval_cache       ; // result of eval indexed by a crc of the context variables accessed by code, protected by _eval_cache_mutex
 	public :
 		Py::Ptr<Py::Dict> mutable glbs ;            // if is_dynamic <=> dict to use as globals when executing code, modified then restored during evaluation
 		Py::Ptr<Py::Code>         code ;            // if is_dynamic <=> python code object to execute with stems as locals and glbs as globals leading to a dict that can be used to build data
@@ -862,7 +869,7 @@ namespace Engine {
 		return res ;
 	}
 
-	template<class T> Py::Ptr<Py::Object> Dynamic<T>::_eval_code( Job job , Rule::SimpleMatch& match , ::vmap_ss const& rsrcs , ::vmap_s<DepDigest>* deps ) const {
+	template<class T> Py::Ptr<Py::Object> Dynamic<T>::_eval_code( Job job , Rule::SimpleMatch& match , ::vmap_ss const& rsrcs , ::vmap_s<DepDigest>* deps , bool* accessed ) const {
 		// functions defined in glbs use glbs as their global dict (which is stored in the code object of the functions), so glbs must be modified in place or the job-related values will not
 		// be seen by these functions, which is the whole purpose of such dynamic values
 		::vector_s to_del ;
@@ -887,18 +894,37 @@ namespace Engine {
 		//                                ^^^^^^^^^^^^^^^^^
 		catch (::string const& e) { err = e ; seen_err = true ; }
 		for( ::string const& key : to_del ) glbs->del_item(key) ;        // delete job-related info, just to avoid percolation to other jobs, even in case of error
+		if (accessed               ) *accessed = lock.accessed ;
 		if ( +lock.err || seen_err ) throw ::pair(lock.err/*msg*/,err) ;
 		return res ;
 	}
 
+	// result only depends on glbs, which are fixed, and on the context variables accessed by code, unless evaluation accesses files
+	// so memoize results keyed by these variables, which saves python evaluation (and acquiring the Gil) for the numerous jobs sharing the same values
 	template<class T> T Dynamic<T>::eval( Job job , Rule::SimpleMatch& match , ::vmap_ss const& rsrcs , ::vmap_s<DepDigest>* deps ) const {
-		T res = spec ;
-		if (is_dynamic) {
-			Py::Gil             gil    ;
-			Py::Ptr<Py::Object> py_obj = _eval_code( job , match , rsrcs , deps ) ;
+		if (!is_dynamic) return spec ;
+		Hash::Xxh h ;
+		eval_ctx( job , match , rsrcs
+		,	[&]( VarCmd vc , VarIdx i , ::string const& /*key*/ , ::string  const& val ) -> void { h.update(vc) ; h.update(i) ; h.update(val) ; }
+		,	[&]( VarCmd vc , VarIdx i , ::string const& /*key*/ , ::vmap_ss const& val ) -> void { h.update(vc) ; h.update(i) ; h.update(val) ; }
+		) ;
+		Crc key = h.digest() ;
+		{	Lock lock { _eval_cache_mutex } ;
+			if ( auto it=_eval_cache.find(key) ; it!=_eval_cache.end() ) return it->second ;
+		}
+		T      res      = spec                    ;
+		size_t n_deps   = deps ? deps->size() : 0 ;
+		bool   accessed = false                   ;
+		{	Py::Gil             gil    ;
+			Py::Ptr<Py::Object> py_obj = _eval_code( job , match , rsrcs , deps , &accessed ) ;
 			try                       { res.update(py_obj->template as_a<Py::Dict>()) ; }
 			catch (::string const& e) { throw ::pair_ss(e,{}) ;                         }
 		}
+		if ( !accessed && (!deps||deps->size()==n_deps) ) {                            // if files were accessed, result depends on them and deps must be recorded for each job
+			Lock lock { _eval_cache_mutex } ;
+			if (_eval_cache.size()>=EvalCacheSz) _eval_cache.clear() ;
+			_eval_cache.try_emplace(key,res) ;
+		}
 		return res ;
 	}
 
@@ -64,6 +64,10 @@ namespace Engine::Persistent {
 	SfxFile      _sfxs_file      ; // .
 	PfxFile      _pfxs_file      ; // .
 	NameFile     _name_file      ; // commons
+	NodeInvFile  _node_inv_file  ; // reverse index
+	JobInvFile   _job_inv_file   ; // .
+	InvFile      _inv_file       ; // .
+	JobInfoStore _job_info_file  ; // job infos
 	// in memory
 	::uset<Job >       _frozen_jobs  ;
 	::uset<Node>       _frozen_nodes ;
@@ -125,6 +129,12 @@ namespace Engine::Persistent {
 		_pfxs_file     .init( dir+"/pfxs"      , writable ) ;
 		// commons
 		_name_file     .init( dir+"/name"      , writable ) ;
+		// reverse index
+		_node_inv_file .init( dir+"/node_inv"  , writable ) ;
+		_job_inv_file  .init( dir+"/job_inv"   , writable ) ;
+		_inv_file      .init( dir+"/inv"       , writable ) ;
+		// job infos
+		_job_info_file .init( g_config.local_admin_dir+"/job_info" , writable ) ;
 		// misc
 		if (writable) {
 			g_seq_id = &_job_file.hdr().seq_id ;
@@ -170,6 +180,47 @@ namespace Engine::Persistent {
 		/**/                                  _sfxs_file     .chk(                    ) ; // .
 		for( PsfxIdx idx : _sfxs_file.lst() ) _pfxs_file     .chk(_sfxs_file.c_at(idx)) ; // .
 		/**/                                  _name_file     .chk(                    ) ; // commons
+		/**/                                  _node_inv_file .chk(                    ) ; // reverse index
+		/**/                                  _job_inv_file  .chk(                    ) ; // .
+		/**/                                  _inv_file      .chk(                    ) ; // .
+	}
+
+	//
+	// reverse index
+	//
+
+	void inv_add( bool target , Node n , Job j ) {
+		while (_node_inv_file.size()<=+n) _node_inv_file.emplace_back() ;
+		while (_job_inv_file .size()<=+j) _job_inv_file .emplace_back() ;
+		InvIdx& head     = target ? _node_inv_file.at(n).targets : _node_inv_file.at(n).deps ;
+		InvIdx& job_head = _job_inv_file.at(j).lnks                                          ;
+		InvIdx  l        = _inv_file.emplace(InvLnk{ .job=j , .node=n , .next=head , .job_next=job_head , .target=target }) ; // push front, cost does not depend on the number of jobs already referring to n
+		if (head) _inv_file.at(head).prev = l ;
+		head     = l ;
+		job_head = l ;
+	}
+
+	void inv_del( bool target , ::uset<Node> const& nodes , Job j ) {
+		if ( !nodes || +j>=_job_inv_file.size() ) return ;
+		for( InvIdx* jl = &_job_inv_file.at(j).lnks ; *jl ;) {                                                            // walk links of j rather than jobs referring to each node
+			InvIdx        l   = *jl               ;
+			InvLnk const& lnk = _inv_file.c_at(l) ;
+			if ( lnk.target!=target || !nodes.contains(lnk.node) ) { jl = &_inv_file.at(l).job_next ; continue ; }
+			NodeInvs& nis = _node_inv_file.at(lnk.node) ;
+			if (lnk.prev) _inv_file.at(lnk.prev).next = lnk.next ; else ( target ? nis.targets : nis.deps ) = lnk.next ;
+			if (lnk.next) _inv_file.at(lnk.next).prev = lnk.prev ;
+			*jl = lnk.job_next ;
+			_inv_file.pop(l) ;                                                                                            // freed link is reused by next inv_add
+		}
+	}
+
+	::vector<Job> inv_jobs( bool target , Node n ) {
+		::vector<Job> res ;
+		if (+n>=_node_inv_file.size()) return res ;
+		NodeInvs const& nis = _node_inv_file.c_at(n) ;
+		for( InvIdx l = target ? nis.targets : nis.deps ; l ; l = _inv_file.c_at(l).next ) res.push_back(_inv_file.c_at(l).job) ;
+		::sort(res) ;                                                        // links are in no particular order, provide a stable order
+		return res ;
 	}
 
 	static void _save_config() {
@@ -217,8 +268,9 @@ namespace Engine::Persistent {
 	void repair(::string const& from_dir) {
 		::vector<Rule>   rules    = rule_lst() ;
 		::umap<Crc,Rule> rule_tab ; for( Rule r : Rule::s_lst() ) rule_tab[r->cmd_crc] = r ; SWEAR(rule_tab.size()==rules.size()) ;
-		for( ::string const& jd : walk(from_dir,from_dir) ) {
-			{	JobInfo job_info { jd } ;
+		JobInfoStore     from     { from_dir , false/*writable*/ } ;
+		for( JobIdx ji=1 ; ji<from.size() ; ji++ ) {
+			{	JobInfo job_info = from.read(ji) ;
 				if (!job_info.end.end.proc) goto NextJob ;
 				// qualify report
 				if (job_info.start.pre_start.proc!=JobProc::Start) goto NextJob ;
@@ -251,8 +303,8 @@ namespace Engine::Persistent {
 				}
 				// set job
 				Job job { {rule,::move(job_info.start.stems)} } ;
-				job->targets.assign(targets) ;
-				job->deps   .assign(deps   ) ;
+				job->assign_targets(targets) ;
+				job->assign_deps   (deps   ) ;
 				job->status = job_info.end.end.digest.status ;
 				job->exec_ok(true) ;                                                    // pretend job just ran
 				// set target actual_job's
@@ -13,7 +13,7 @@
 #include "idxed.hh"
 
 //
-// There are 9 files :
+// There are 12 files :
 // - 1 name file associates a name with either a node or a job :
 //   - This is a prefix-tree to share as much prefixes as possible since names tend to share a lot of prefixes
 //   - For jobs, a suffix containing the rule and the positions of the stems is added.
@@ -37,6 +37,13 @@
 //     During the analysis process, rule-targets are transformed into job-target when possible (else they are dropped), so that the yet to analyse part which
 //     the node keeps is a suffix of the original list.
 //     For this reason, the file is stored as a suffix-tree (like a prefix-tree, but reversed).
+// - 3 files for the reverse index, i.e. the jobs referring to a node as a dep or a target :
+//   - A node-inv file, indexed by node, containing the heads of 2 doubly linked lists, one for deps and one for targets.
+//   - A job-inv file, indexed by job, containing the head of the list of the links of this job.
+//   - An inv file containing the links. A link is a job, a node, the previous and next links for this node and the next link for this job.
+//     Links are added when a job acquires a dep or target and removed when it loses it, so lists are exact and freed links are reused.
+//     Removing a link costs the number of links of its job, independently of the number of jobs referring to its node.
+// In addition, job infos (as shown by lshow -i, -e, etc.) are stored in a JobInfoStore (cf. rpc_job.hh), indexed by job.
 //
 
 #ifdef STRUCT_DECL
@@ -261,6 +268,24 @@ namespace Engine::Persistent {
 		Targets no_triggers ; // these nodes do not trigger rebuild
 	} ;
 
+	struct NodeInvs { // heads of lists of jobs referring to a node
+		InvIdx deps    = 0 ;
+		InvIdx targets = 0 ;
+	} ;
+
+	struct JobInvs {  // head of list of links of a job
+		InvIdx lnks = 0 ;
+	} ;
+
+	struct InvLnk {
+		Job    job      ;
+		Node   node     ;
+		InvIdx prev     = 0     ; // in list of jobs referring to node
+		InvIdx next     = 0     ; // .
+		InvIdx job_next = 0     ; // in list of links of job
+		bool   target   = false ;
+	} ;
+
 	//                                           autolock header     index             key       data         misc
 	// jobs
 	using JobFile      = Store::AllocFile       < false , JobHdr   , Job             ,           JobData                       > ;
@@ -277,6 +302,10 @@ namespace Engine::Persistent {
 	using PfxFile      = Store::MultiPrefixFile < false , void     , PsfxIdx         , char    , RuleTgts   , false/*Reverse*/ > ;
 	// commons
 	using NameFile     = Store::SinglePrefixFile< true  , void     , Name            , char    , JobNode                       > ; // for Job's & Node's
+	// reverse index
+	using NodeInvFile  = Store::StructFile      < false , void     , Node            ,           NodeInvs                      > ; // indexed by Node
+	using JobInvFile   = Store::StructFile      < false , void     , Job             ,           JobInvs                       > ; // indexed by Job
+	using InvFile      = Store::AllocFile       < false , void     , InvIdx          ,           InvLnk                        > ;
 
 	static constexpr char StartMrkr = 0x0 ; // used to indicate a single match suffix (i.e. a suffix which actually is an entire file name)
 
@@ -297,6 +326,10 @@ namespace Engine::Persistent {
 	extern SfxFile      _sfxs_file      ; // .
 	extern PfxFile      _pfxs_file      ; // .
 	extern NameFile     _name_file      ; // commons
+	extern NodeInvFile  _node_inv_file  ; // reverse index
+	extern JobInvFile   _job_inv_file   ; // .
+	extern InvFile      _inv_file       ; // .
+	extern JobInfoStore _job_info_file  ; // job infos
 	// in memory
 	extern ::uset<Job >       _frozen_jobs  ;
 	extern ::uset<Node>       _frozen_nodes ;
@@ -326,6 +359,10 @@ namespace Engine::Persistent {
 	JobFile ::Lst  job_lst () ;
 	::vector<Rule> rule_lst() ;
 	//
+	void          inv_add ( bool target , Node                , Job ) ; // record that job refers to node as a dep (target=false) or a target (target=true)
+	void          inv_del ( bool target , ::uset<Node> const& , Job ) ; // record that job no more refers to nodes, cost is the number of links of job
+	::vector<Job> inv_jobs( bool target , Node                      ) ; // jobs referring to node, sorted
+	//
 	void chk() ;
 	//
 
@@ -395,19 +432,26 @@ namespace Engine::Persistent {
 		*this = _job_file.emplace( Name() , ::forward<A>(args)... ) ;
 	}
 	template<class... A> JobBase::JobBase( ::pair_ss const& name_sfx , bool new_ , A&&... args ) { // jobs are only created in main thread, so no locking is necessary
-		Name name_ = _name_file.insert(name_sfx.first,name_sfx.second) ;
+		Name         name_ = _name_file.insert(name_sfx.first,name_sfx.second) ;
+		::uset<Node> old_targets ;
+		::uset<Node> old_deps    ;
 		*this = _name_file.c_at(+name_).job() ;
 		if (+*this) {
 			SWEAR( name_==(*this)->_full_name , name_ , (*this)->_full_name ) ;
 			if (!new_) return ;
+			old_targets = (*this)->inv_nodes(true /*target*/) ;
+			old_deps    = (*this)->inv_nodes(false/*target*/) ;
 			**this = JobData( name_ , ::forward<A>(args)...) ;
 		} else {
 			_name_file.at(+name_) = *this = _job_file.emplace( name_ , ::forward<A>(args)... ) ;
 		}
 		(*this)->_full_name = name_ ;
+		(*this)->inv_update(true /*target*/,old_targets) ;
+		(*this)->inv_update(false/*target*/,old_deps   ) ;
 	}
 	inline void JobBase::pop() {
 		if (!*this) return ;
+		for( bool t : {false,true} ) inv_del( t , (*this)->inv_nodes(t) , Job(+*this) ) ;
 		if (+(*this)->_full_name) (*this)->_full_name.pop() ;
 		_job_file.pop(+*this) ;
 		clear() ;
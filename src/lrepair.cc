@@ -32,7 +32,7 @@ int main( int argc , char* /*argv*/[] ) {
 	if (is_dir(backup_admin_dir)) {
 		if      (has_admin_dir                                    ) exit(Rc::Format,"backup already existing, consider : rm -r ",backup_admin_dir) ;
 	} else {
-		if      (!is_dir(PrivateAdminDir+"/local_admin/job_data"s)) exit(Rc::Fail  ,"nothing to repair"                                          ) ;
+		if      (!is_dir(PrivateAdminDir+"/local_admin/job_info"s)) exit(Rc::Fail  ,"nothing to repair"                                          ) ;
 		else if (::rename(AdminDir,backup_admin_dir.c_str())!=0   ) exit(Rc::System,"backup failed to ",backup_admin_dir                         ) ;
 	}
 	if ( AutoCloseFd fd=open_write(repair_mrkr) ; !fd ) exit(Rc::System,"cannot create ",repair_mrkr) ; // create marker
@@ -48,7 +48,7 @@ int main( int argc , char* /*argv*/[] ) {
 		if (+msg) ::cerr << ensure_nl(msg) ;
 	} catch (::string const& e) { exit(Rc::Format,e) ; }
 	//vvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvvv
-	Persistent::repair(to_string(backup_admin_dir,'/',PRIVATE_ADMIN_SUBDIR,"/local_admin/job_data")) ;
+	Persistent::repair(to_string(backup_admin_dir,'/',PRIVATE_ADMIN_SUBDIR,"/local_admin/job_info")) ;
 	//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 	unlnk(repair_mrkr) ;
 	::cout << "repo has been satisfactorily repaired" << endl ;
@@ -3,6 +3,8 @@
 // This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
 // This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
+#include <sys/mman.h> // mmap, munmap
+
 #include "disk.hh"
 #include "hash.hh"
 
@@ -32,7 +34,7 @@ static_assert(_chk_flags_tab(ExtraTflagChars)) ;
 	return                              os <<')'                      ;
 }
 
-::pair_s<bool/*ok*/> do_file_actions( ::vector_s* unlnks/*out*/ , ::vmap_s<FileAction>&& pre_actions , NfsGuard& nfs_guard , Algo ha ) {
+::pair_s<bool/*ok*/> do_file_actions( ::vector_s* unlnks/*out*/ , ::vmap_s<FileAction>&& pre_actions , NfsGuard& nfs_guard ) {
 	::uset_s keep_dirs ;
 	::string msg       ;
 	bool     ok        = true ;
@@ -45,7 +47,7 @@ static_assert(_chk_flags_tab(ExtraTflagChars)) ;
 				FileSig sig { nfs_guard.access(f) } ;
 				if (!sig) break ;                                                                                                    // file does not exist, nothing to do
 				bool done = true/*garbage*/ ;
-				if ( sig!=a.sig && (a.crc==Crc::None||!a.crc.valid()||!a.crc.match(Crc(f,ha))) ) {
+				if ( sig!=a.sig && (a.crc==Crc::None||!a.crc.valid()||!a.crc.match(Crc(f))) ) {
 					done = ::rename( f.c_str() , dir_guard(QuarantineDirS+f).c_str() )==0 ;
 					if (done) append_to_string(msg,"quarantined "         ,mk_file(f),'\n') ;
 					else      append_to_string(msg,"failed to quarantine ",mk_file(f),'\n') ;
@@ -160,6 +162,7 @@ static_assert(_chk_flags_tab(ExtraTflagChars)) ;
 			if (+jrr.date_prec     ) os <<',' << jrr.date_prec                    ;
 			/**/                     os <<',' << mk_printable(to_string(jrr.env)) ; // env may contain the non-printable EnvPassMrkr value
 			/**/                     os <<',' << jrr.interpreter                  ;
+			if (jrr.keep_conn      ) os <<',' << "keep_conn"                      ;
 			if (jrr.keep_tmp       ) os <<',' << "keep_tmp"                       ;
 			/**/                     os <<',' << jrr.kill_sigs                    ;
 			if (jrr.live_out       ) os <<',' << "live_out"                       ;
@@ -199,6 +202,15 @@ static_assert(_chk_flags_tab(ExtraTflagChars)) ;
 	return                             os <<')' ;
 }
 
+//
+// JobMuxRpcReq
+//
+
+::ostream& operator<<( ::ostream& os , JobMuxRpcReq const& jmrr ) {
+	if (jmrr.is_mngt) return os << "JobMuxRpcReq(" << jmrr.jmrr <<')' ;
+	else              return os << "JobMuxRpcReq(" << jmrr.jrr  <<')' ;
+}
+
 JobMngtRpcReq::JobMngtRpcReq( SI si , JI j , Fd fd_ , JobExecRpcReq&& jerr ) : seq_id{si} , job{j} , fd{fd_} {
 	SWEAR( jerr.sync || !fd , jerr,fd ) ;
 	switch (jerr.proc) {
@@ -276,6 +288,7 @@ AccessDigest& AccessDigest::operator|=(AccessDigest const& other) {
 	os << "JobExecRpcReply(" << jerr.proc ;
 	switch (jerr.proc) {
 		case JobExecProc::None       :                                     ; break ;
+		case JobExecProc::Ring       :
 		case JobExecProc::ChkDeps    : os <<','<< jerr.ok                  ; break ;
 		case JobExecProc::DepVerbose : os <<','<< jerr.dep_infos           ; break ;
 		case JobExecProc::Decode     :
@@ -319,6 +332,168 @@ void JobInfo::write(::string const& filename) const {
 	serialize(os,start) ;
 	serialize(os,end  ) ;
 }
+
+//
+// JobInfoStore
+//
+
+JobInfoStore::~JobInfoStore() {
+	if (_idx_map) ::munmap(_idx_map,_idx_sz) ;
+}
+
+void JobInfoStore::init( ::string const& dir , bool writable ) {
+	_dir      = dir      ;
+	_writable = writable ;
+	if (_writable) mkdir(_dir) ;
+	::string idx_file = _dir+"/idx" ;
+	_idx_fd = ::open( idx_file.c_str() , (_writable?O_RDWR|O_CREAT:O_RDONLY)|O_CLOEXEC , 0666 ) ;
+	if (!_idx_fd) {
+		if (_writable) throw to_string("cannot open ",idx_file) ;
+		return ;                                                                                      // no store, no info
+	}
+	size_t idx_sz = FileInfo(_idx_fd).sz ;
+	if ( !_writable && idx_sz<sizeof(Entry) ) return ;                                                // empty store
+	_map(::max( idx_sz , sizeof(Entry) )) ;                                                           // entry 0 holds header
+	size_t total_sz = 0 ;
+	for( ::string const& f : lst_dir(_dir) ) {
+		if ( f.empty() || f.find_first_not_of("0123456789")!=Npos ) continue ;                        // not a segment
+		uint32_t seg = from_string<uint32_t>(f) ;
+		_open_seg(seg) ;
+		total_sz += FileInfo(_seg_fds.at(seg)).sz ;
+	}
+	if (!_writable) return ;
+	if (!_hdr().seg) _hdr().seg = 1 ;                                                                 // brand new store
+	_open_seg(_hdr().seg) ;
+	_seg_pos = FileInfo(_seg_fds.at(_hdr().seg)).sz ;
+	if ( total_sz>SegSz && _hdr().live_sz*2<total_sz ) compact() ;                                    // garbage is more than half of store
+}
+
+void JobInfoStore::_map(size_t sz) {
+	if (_idx_map) ::munmap(_idx_map,_idx_sz) ;
+	if ( _writable && FileInfo(_idx_fd).sz<sz ) swear_prod( ::ftruncate(_idx_fd,sz)==0 , "cannot grow ",_dir,"/idx" ) ; // new entries are zero, i.e. no section
+	_idx_map = ::mmap( nullptr , sz , PROT_READ|(_writable?PROT_WRITE:0) , MAP_SHARED , _idx_fd , 0 ) ;
+	swear_prod( _idx_map!=MAP_FAILED , "cannot map ",_dir,"/idx" ) ;
+	_idx_sz = sz ;
+}
+
+void JobInfoStore::_open_seg(uint32_t seg) {
+	if (_seg_fds.contains(seg)) return ;
+	::string sn = _seg_name(seg) ;
+	AutoCloseFd fd = ::open( sn.c_str() , (_writable?O_RDWR|O_CREAT:O_RDONLY)|O_CLOEXEC , 0666 ) ;
+	if (!fd) throw to_string("cannot open ",sn) ;
+	_seg_fds.emplace(seg,::move(fd)) ;
+}
+
+::string JobInfoStore::_get(Loc loc) const {
+	::string res ( loc.sz , 0 ) ;
+	auto     it  = _seg_fds.find(loc.seg) ;
+	if (it==_seg_fds.end()) throw to_string("no segment ",loc.seg," in ",_dir) ;
+	for( size_t pos=0 ; pos<loc.sz ;) {
+		ssize_t cnt = ::pread( it->second , res.data()+pos , loc.sz-pos , loc.offset+pos ) ;
+		if (cnt<=0) throw to_string("cannot read segment ",loc.seg," in ",_dir) ;
+		pos += cnt ;
+	}
+	return res ;
+}
+
+JobInfoStore::Loc JobInfoStore::_put(::string const& data) {
+	SWEAR( data.size()<=::numeric_limits<uint32_t>::max() , data.size() ) ;
+	if ( _seg_pos && _seg_pos+data.size()>SegSz ) {                                                   // close current segment
+		_hdr().seg++ ;
+		_open_seg(_hdr().seg) ;
+		_seg_pos = 0 ;
+	}
+	Fd fd = _seg_fds.at(_hdr().seg) ;
+	for( size_t pos=0 ; pos<data.size() ;) {
+		ssize_t cnt = ::pwrite( fd , data.data()+pos , data.size()-pos , _seg_pos+pos ) ;
+		if (cnt<=0) throw to_string("cannot write segment ",_hdr().seg," in ",_dir) ;
+		pos += cnt ;
+	}
+	Loc res { .seg=_hdr().seg , .offset=uint32_t(_seg_pos) , .sz=uint32_t(data.size()) } ;
+	_seg_pos += data.size() ;
+	return res ;
+}
+
+void JobInfoStore::_set( JobIdx job , JobInfoKind kind , Loc loc ) {
+	if (job>=size()) _map(::max( (job+1)*sizeof(Entry) , 2*_idx_sz )) ;                               // ensure remaps are in log(n)
+	Loc& l = _entry(job)[+kind] ;
+	_hdr().live_sz -= l  .sz ;
+	_hdr().live_sz += loc.sz ;
+	l               = loc    ;                                                                        // data is written before it is made accessible
+}
+
+SigDate JobInfoStore::_write( JobIdx job , ::array<::string,N<JobInfoKind>> const& sections , BitMap<JobInfoKind> written , BitMap<JobInfoKind> forgotten ) {
+	SWEAR(_writable) ;
+	Lock lock { _mutex } ;
+	for( JobInfoKind k : All<JobInfoKind> )
+		if      (written  [k]) _set( job , k , _put(sections[+k]) ) ;
+		else if (forgotten[k]) _set( job , k , {}                 ) ;
+	return FileSig(_seg_fds.at(_hdr().seg)) ;                                                         // segment date is the date at which info was written
+}
+
+static ::string _out_str(JobRpcReq const& jrr) {
+	OStringStream os ;
+	serialize( os , jrr.msg           ) ;
+	serialize( os , jrr.digest.stderr ) ;
+	serialize( os , jrr.digest.stdout ) ;
+	return os.str() ;
+}
+static ::string _end_str(JobRpcReq const& jrr) {                                                      // outputs are stored in their own section
+	JobRpcReq end = jrr ;
+	end.msg          .clear() ;
+	end.digest.stderr.clear() ;
+	end.digest.stdout.clear() ;
+	return serialize(end) ;
+}
+
+SigDate JobInfoStore::write( JobIdx job , JobInfo const& ji ) {
+	return _write( job , { serialize(ji.start) , _end_str(ji.end.end) , _out_str(ji.end.end) } , ~BitMap<JobInfoKind>() , {} ) ;
+}
+SigDate JobInfoStore::write( JobIdx job , JobInfoStart const& jis ) {
+	return _write( job , { serialize(jis) , ""s , ""s } , JobInfoKind::Start , {JobInfoKind::End,JobInfoKind::Out} ) ;
+}
+SigDate JobInfoStore::write( JobIdx job , JobInfoEnd const& jie ) {
+	return _write( job , { ""s , _end_str(jie.end) , _out_str(jie.end) } , {JobInfoKind::End,JobInfoKind::Out} , {} ) ;
+}
+
+JobInfo JobInfoStore::read( JobIdx job , BitMap<JobInfoKind> kinds ) const {
+	JobInfo                            res      ;
+	::array<::string,N<JobInfoKind>>   sections ;
+	BitMap<JobInfoKind>                present  ;
+	if (!kinds) kinds = ~kinds ;
+	try {
+		{	SharedLock lock { _mutex } ;
+			if (job>=size()) return res ;
+			Entry entry = _entry(job) ;
+			for( JobInfoKind k : All<JobInfoKind> ) if ( kinds[k] && +entry[+k] ) { sections[+k] = _get(entry[+k]) ; present |= k ; }
+		}
+		if (present[JobInfoKind::Start]) deserialize( IStringStream(sections[+JobInfoKind::Start]) , res.start   ) ;
+		if (present[JobInfoKind::End  ]) deserialize( IStringStream(sections[+JobInfoKind::End  ]) , res.end.end ) ;
+		if (present[JobInfoKind::Out  ]) {
+			IStringStream is { sections[+JobInfoKind::Out] } ;
+			deserialize( is , res.end.end.msg           ) ;
+			deserialize( is , res.end.end.digest.stderr ) ;
+			deserialize( is , res.end.end.digest.stdout ) ;
+			res.end.end.proc = JobProc::End ;                                                             // out is only written with end, so end is present even if not read
+		}
+	} catch (...) {}                                                                                  // we get what we get
+	return res ;
+}
+
+void JobInfoStore::compact() {
+	SWEAR(_writable) ;
+	Lock lock { _mutex } ;
+	::vector<uint32_t> old_segs ; for( auto const& [seg,_] : _seg_fds ) old_segs.push_back(seg) ;
+	_hdr().seg++ ;                                                                                    // live sections are copied to new segments
+	_open_seg(_hdr().seg) ;
+	_seg_pos = 0 ;
+	for( JobIdx j=1 ; j<size() ; j++ )
+		for( Loc& loc : _entry(j) ) if (+loc) loc = _put(_get(loc)) ;                                 // live_sz is not modified
+	for( uint32_t seg : old_segs ) {                                                                  // once index no more references old segments, suppress them
+		_seg_fds.erase(seg) ;
+		unlnk(_seg_name(seg)) ;
+	}
+}
 //
 // codec
 //
@@ -43,9 +43,9 @@ struct FileAction {
 	Hash::Crc     crc ;                                                                                  // expected (else, quarantine)
 	Disk::FileSig sig ;                                                                                  // .
 } ;
-/**/   ::pair_s<bool/*ok*/> do_file_actions( ::vector_s* unlnks/*out*/ , ::vmap_s<FileAction>&&    , Disk::NfsGuard&    , Algo   ) ;
-inline ::pair_s<bool/*ok*/> do_file_actions( ::vector_s& unlnks/*out*/ , ::vmap_s<FileAction>&& pa , Disk::NfsGuard& ng , Algo a ) { return do_file_actions(&unlnks,::move(pa),ng,a) ; }
-inline ::pair_s<bool/*ok*/> do_file_actions(                             ::vmap_s<FileAction>&& pa , Disk::NfsGuard& ng , Algo a ) { return do_file_actions(nullptr,::move(pa),ng,a) ; }
+/**/   ::pair_s<bool/*ok*/> do_file_actions( ::vector_s* unlnks/*out*/ , ::vmap_s<FileAction>&&    , Disk::NfsGuard&      ) ;
+inline ::pair_s<bool/*ok*/> do_file_actions( ::vector_s& unlnks/*out*/ , ::vmap_s<FileAction>&& pa , Disk::NfsGuard& ng ) { return do_file_actions(&unlnks,::move(pa),ng) ; }
+inline ::pair_s<bool/*ok*/> do_file_actions(                             ::vmap_s<FileAction>&& pa , Disk::NfsGuard& ng ) { return do_file_actions(nullptr,::move(pa),ng) ; }
 
 // START_OF_VERSIONING
 ENUM_2( Dflag                          // flags for deps
@@ -642,6 +642,7 @@ ENUM_2( AutodepMethod                     // PER_AUTODEP_METHOD : add entry here
 ,	Dflt = HAS_LD_AUDIT?LdAudit:LdPreload // by default, use  a compromize between speed an reliability
 ,	None
 ,	Ptrace
+,	SeccompNotif
 ,	LdAudit
 ,	LdPreload
 ,	LdPreloadJemalloc
@@ -671,8 +672,8 @@ struct JobRpcReply {
 				::serdes(s,date_prec       ) ;
 				::serdes(s,deps            ) ;
 				::serdes(s,env             ) ;
-				::serdes(s,hash_algo       ) ;
 				::serdes(s,interpreter     ) ;
+				::serdes(s,keep_conn       ) ;
 				::serdes(s,keep_tmp        ) ;
 				::serdes(s,kill_sigs       ) ;
 				::serdes(s,live_out        ) ;
@@ -701,8 +702,8 @@ struct JobRpcReply {
 	Time::Delay              date_prec        ;              // proc == Start
 	::vmap_s<DepDigest>      deps             ;              // proc == Start , deps already accessed (always includes static deps)
 	::vmap_ss                env              ;              // proc == Start
-	Algo                     hash_algo        = Algo::Xxh  ; // proc == Start
 	::vector_s               interpreter      ;              // proc == Start , actual interpreter used to execute cmd
+	bool                     keep_conn        = false      ; // proc == Start , if false, server is short of fds and connection used for start must not be reused
 	bool                     keep_tmp         = false      ; // proc == Start
 	vector<uint8_t>          kill_sigs        ;              // proc == Start
 	bool                     live_out         = false      ; // proc == Start
@@ -780,6 +781,26 @@ struct JobMngtRpcReq {
 	uint8_t             min_len = 0       ; // proc==                                  Encode
 } ;
 
+// job_exec sends all its requests on a single connection : Start, then Mngt's, then End
+struct JobMuxRpcReq {
+	friend ::ostream& operator<<( ::ostream& , JobMuxRpcReq const& ) ;
+	// cxtors & casts
+	JobMuxRpcReq(                     ) = default ;
+	JobMuxRpcReq(JobRpcReq    && jrr_ ) : is_mngt{false} , jrr {::move(jrr_ )} {}
+	JobMuxRpcReq(JobMngtRpcReq&& jmrr_) : is_mngt{true } , jmrr{::move(jmrr_)} {}
+	// services
+	template<IsStream T> void serdes(T& s) {
+		if (::is_base_of_v<::istream,T>) *this = {} ;
+		::serdes(s,is_mngt) ;
+		if (is_mngt) ::serdes(s,jmrr) ;
+		else         ::serdes(s,jrr ) ;
+	}
+	// data
+	bool          is_mngt = false ;
+	JobRpcReq     jrr     ;         // if !is_mngt
+	JobMngtRpcReq jmrr    ;         // if  is_mngt
+} ;
+
 struct JobMngtRpcReply {
 	friend ::ostream& operator<<( ::ostream& , JobMngtRpcReply const& ) ;
 	using Crc  = Hash::Crc   ;
@@ -835,6 +856,8 @@ ENUM_1( JobExecProc
 ,	Tmp               // write activity in tmp has been detected (hence clean up is required)
 ,	Trace             // no algorithmic info, just for tracing purpose
 ,	Panic             // ensure job is in error
+,	Ring              // announce a shared memory ring through which asynchronous reports are sent, cf. shm_ring.hh
+,	Doorbell          // ring has been filled while job_exec was waiting for it
 ,	Confirm
 ,	Access
 ,	Guard
@@ -941,8 +964,8 @@ public :
 			case P::Trace      :
 			case P::Panic      :
 			case P::Guard      :                                                  break ;
-			case P::Confirm    : ::serdes(s,digest.write) ;                       break ;
-			case P::Access     :
+			case P::Confirm    : ::serdes(s,digest.write) ; ::serdes(s,id     ) ; break ;
+			case P::Access     : ::serdes(s,digest      ) ; ::serdes(s,id     ) ; break ;
 			case P::DepVerbose : ::serdes(s,digest      ) ;                       break ;
 			case P::Decode     : ::serdes(s,ctx         ) ;                       break ;
 			case P::Encode     : ::serdes(s,ctx         ) ; ::serdes(s,min_len) ; break ;
@@ -956,6 +979,7 @@ public :
 	bool               solve     = false                     ; // if proc>=HasFiles, if true <=> files must be solved and dates added by probing disk
 	bool               no_follow = false                     ; // if solve, whether links should not be followed
 	uint8_t            min_len   = 0                         ; // if proc==Encode
+	uint64_t           id        = 0                         ; // if proc==Access|Confirm, identifies reporting thread so that a Confirm only applies to accesses of the same thread
 	Pdate              date      = New                       ; // access date to reorder accesses during analysis
 	::string           cwd       ;                             // if solve, cwd to use to solve files
 	::vmap_s<FileInfo> files     ;
@@ -971,7 +995,7 @@ struct JobExecRpcReply {
 	// cxtors & casts
 	JobExecRpcReply(                                                    ) = default ;
 	JobExecRpcReply( Proc p                                             ) : proc{p}                 { SWEAR( proc!=Proc::ChkDeps && proc!=Proc::DepVerbose ) ; }
-	JobExecRpcReply( Proc p , Bool3 o                                   ) : proc{p} , ok       {o } { SWEAR( proc==Proc::ChkDeps                           ) ; }
+	JobExecRpcReply( Proc p , Bool3 o                                   ) : proc{p} , ok       {o } { SWEAR( proc==Proc::ChkDeps || proc==Proc::Ring       ) ; }
 	JobExecRpcReply( Proc p , ::vector<pair<Bool3/*ok*/,Crc>> const& is ) : proc{p} , dep_infos{is} { SWEAR( proc==Proc::DepVerbose                        ) ; }
 	JobExecRpcReply( Proc p , ::string const&                        t  ) : proc{p} , txt      {t } { SWEAR( proc==Proc::Decode || proc==Proc::Encode      ) ; }
 	//
@@ -982,6 +1006,7 @@ struct JobExecRpcReply {
 		::serdes(s,proc) ;
 		switch (proc) {
 			case Proc::Access     :                         break ;
+			case Proc::Ring       :
 			case Proc::ChkDeps    : ::serdes(s,ok       ) ; break ;
 			case Proc::DepVerbose : ::serdes(s,dep_infos) ; break ;
 			case Proc::Decode :
@@ -993,7 +1018,7 @@ struct JobExecRpcReply {
 	}
 	// data
 	Proc                            proc      = Proc::None ;
-	Bool3                           ok        = Maybe      ; // if proc==ChkDeps |Decode|Encode
+	Bool3                           ok        = Maybe      ; // if proc==ChkDeps|Ring|Decode|Encode
 	::vector<pair<Bool3/*ok*/,Crc>> dep_infos ;              // if proc==DepVerbose
 	::string                        txt       ;              // if proc==         Decode|Encode (value for Decode, code for Encode)
 } ;
@@ -1057,6 +1082,10 @@ struct JobInfo {
 	JobInfo( ::string const& ancillary_file        ) ;
 	JobInfo( JobInfoStart&& jis , JobInfoEnd&& jie ) : start{::move(jis)} , end{::move(jie)} {}
 	// ervices
+	template<IsStream S> void serdes(S& s) {
+		::serdes(s,start) ;
+		::serdes(s,end  ) ;
+	}
 	void write(::string const& filename) const ;
 	// data
 	// START_OF_VERSIONING
@@ -1065,6 +1094,74 @@ struct JobInfo {
 	// END_OF_VERSIONING
 } ;
 
+//
+// JobInfoStore
+//
+
+// job infos of a repo are stored in a few append-only segments rather than in one file per job
+// each section of a job info is located through an index (mmapped, indexed by job) and can be read independently, e.g. stderr can be shown without decoding deps
+// space left by overwritten sections is reclaimed by compaction when the store is opened for writing (i.e. at server start)
+
+// START_OF_VERSIONING
+ENUM( JobInfoKind // sections of job info
+,	Start         // JobInfoStart
+,	End           // JobInfoEnd, except outputs
+,	Out           // msg, stderr & stdout of end report
+)
+// END_OF_VERSIONING
+
+struct JobInfoStore {
+	static constexpr size_t SegSz = 64<<20 ;                            // segments are closed when they reach this size
+	// START_OF_VERSIONING
+	struct Loc {
+		bool operator+() const { return seg ; }
+		uint32_t seg    = 0 ;                                           // 0 means section is not present
+		uint32_t offset = 0 ;
+		uint32_t sz     = 0 ;
+	} ;
+	using Entry = ::array<Loc,N<JobInfoKind>> ;
+	struct Hdr {                                                        // stored in the otherwise unused entry 0
+		uint64_t live_sz = 0 ;                                          // sum of sizes of sections accessible from index
+		uint32_t seg     = 0 ;                                          // segment being written
+	} ;
+	// END_OF_VERSIONING
+	static_assert(sizeof(Hdr)<=sizeof(Entry)) ;
+	// cxtors & casts
+	JobInfoStore(                                        ) = default ;
+	JobInfoStore( ::string const& dir , bool writable ) { init(dir,writable) ; }
+	~JobInfoStore() ;
+	void init( ::string const& dir , bool writable ) ;
+	// accesses
+	JobIdx size() const { return _idx_sz/sizeof(Entry) ; } // 1 + highest job that may have info
+	// services
+	JobInfo       read   ( JobIdx , BitMap<JobInfoKind> ={} ) const ; // {} means all sections
+	Disk::SigDate write  ( JobIdx , JobInfo      const&     ) ;       // write all sections
+	Disk::SigDate write  ( JobIdx , JobInfoStart const&     ) ;       // write start section, forget end & out
+	Disk::SigDate write  ( JobIdx , JobInfoEnd   const&     ) ;       // write end & out sections
+	void          compact(                                  ) ;       // rewrite live sections in a new segment and suppress old ones
+private :
+	Hdr        & _hdr     (        )       { return *reinterpret_cast<Hdr        *>(_idx_map)    ; }
+	Entry const& _entry   (JobIdx j) const { return  reinterpret_cast<Entry const*>(_idx_map)[j] ; }
+	Entry      & _entry   (JobIdx j)       { return  reinterpret_cast<Entry      *>(_idx_map)[j] ; }
+	::string     _seg_name(uint32_t s) const { return to_string(_dir,'/',s) ; }
+	//
+	void          _map     ( size_t                                                                                                 ) ;
+	void          _open_seg( uint32_t                                                                                               ) ;
+	::string      _get     ( Loc                                                                                                    ) const ;
+	Loc           _put     ( ::string const&                                                                                        ) ;
+	void          _set     ( JobIdx , JobInfoKind , Loc                                                                             ) ;
+	Disk::SigDate _write   ( JobIdx , ::array<::string,N<JobInfoKind>> const& , BitMap<JobInfoKind> written , BitMap<JobInfoKind> forgotten ) ;
+	// data
+	::string                               _dir      ;
+	bool                                   _writable = false   ;
+	mutable SharedMutex<MutexLvl::JobInfo> _mutex    ;
+	AutoCloseFd                            _idx_fd   ;
+	void*                                  _idx_map  = nullptr ;
+	size_t                                 _idx_sz   = 0       ; // mapped size
+	::umap<uint32_t,AutoCloseFd>           _seg_fds  ;           // all segments are kept open
+	size_t                                 _seg_pos  = 0       ; // size of segment being written
+} ;
+
 //
 // codec
 //
@@ -53,6 +53,15 @@ namespace Store {
 			_resize_file(::max( sz , size + (size>>2) )) ;      // ensure remaps are in log(n)
 			_map(old_size) ;
 		}
+		void refresh() {                                        // catch up with expansions made by other processes sharing the file
+			if (!_fd) return ;
+			ULock lock{_mutex} ;
+			size_t new_size = Disk::FileInfo(_fd).sz ;
+			if (new_size<=size) return ;
+			size_t old_size = size ;
+			size = new_size ;
+			_map(old_size) ;
+		}
 		void clear(size_t sz=0) {
 			ULock lock{_mutex} ;
 			_clear(sz) ;
@@ -104,9 +104,10 @@ private :
 	static void _s_thread_func( ::stop_token stop , char key , ServerThread* self , ::function<bool/*keep_fd*/(Req&&,SlaveSockFd const&)> func ) {
 		static constexpr uint64_t One = 1 ;
 		t_thread_key = key ;
-		AutoCloseFd        stop_fd = ::eventfd(0,O_CLOEXEC) ; stop_fd.no_std() ;
-		Epoll              epoll   { New }                  ;
-		::umap<Fd,IMsgBuf> slaves  ;
+		AutoCloseFd        stop_fd       = ::eventfd(0,O_CLOEXEC) ; stop_fd.no_std() ;
+		Epoll              epoll         { New }                  ;
+		::umap<Fd,IMsgBuf> slaves        ;
+		bool               accept_paused = false                  ;                                                // if true, we are short of fds and master is not watched
 		::stop_callback    stop_cb {                                                                               // transform request_stop into an event Epoll can wait for
 			stop
 		,	[&](){
@@ -117,6 +118,17 @@ private :
 		} ;
 		//
 		Trace trace("ServerThread::_s_thread_func",self->fd,self->fd.port(),stop_fd) ;
+		auto close_slave = [&](Fd sfd , bool do_close )->void {
+			if (do_close) epoll.close(sfd) ;
+			else          epoll.del  (sfd) ;
+			slaves.erase(sfd) ;
+			self->n_slaves = slaves.size() ;
+			if (accept_paused) {                                                                                // an fd is available, resume accepting connections
+				trace("resume_accept") ;
+				epoll.add_read(self->fd,EventKind::Master) ;
+				accept_paused = false ;
+			}
+		} ;
 		self->_ready.count_down() ;
 		//
 		epoll.add_read(self->fd,EventKind::Master) ;
@@ -131,12 +143,19 @@ private :
 				switch (kind) {
 					case EventKind::Master : {
 						SWEAR(efd==self->fd) ;
-						try {
-							SlaveSockFd slave_fd { self->fd.accept() } ;
-							trace("new_req",slave_fd) ;
-							epoll.add_read(slave_fd,EventKind::Slave) ;
-							slaves.try_emplace(::move(slave_fd)) ;
-						} catch (::string const& e) { trace("cannot_accept",e) ; }                                 // ignore error as this may be fd starvation and client will retry
+						SlaveSockFd slave_fd { ::accept(self->fd,nullptr,nullptr) } ;
+						if (!slave_fd) {
+							trace("cannot_accept",strerror(errno)) ;
+							if ( errno==EMFILE || errno==ENFILE ) {                                                 // fd starvation, stop accepting until a slave is closed, client will retry
+								epoll.del(self->fd) ;
+								accept_paused = true ;
+							}
+							break ;
+						}
+						trace("new_req",slave_fd) ;
+						epoll.add_read(slave_fd,EventKind::Slave) ;
+						slaves.try_emplace(::move(slave_fd)) ;
+						self->n_slaves = slaves.size() ;
 					} break ;
 					case EventKind::Stop : {
 						uint64_t one ;
@@ -149,11 +168,23 @@ private :
 					} break ;
 					case EventKind::Slave : {
 						Req r ;
-						try         { if (!slaves.at(efd).receive_step(efd,r)) { trace("partial") ; continue ; } }
-						catch (...) {                                            trace("bad_msg") ; continue ;   } // ignore malformed messages
+						try {
+							if (!slaves.at(efd).receive_step(efd,r)) { trace("partial") ; continue ; }
+						} catch (...) {
+							if (!self->persistent) { trace("bad_msg") ; continue ; }                                // ignore malformed messages
+							trace("lost") ;                                                                         // persistent connections are closed by client when done
+							close_slave(efd,true/*close*/) ;
+							continue ;
+						}
 						//
-						epoll.del(efd) ;            // Func may trigger efd being closed by another thread, hence epoll.del must be done before
-						slaves.erase(efd) ;
+						if (self->persistent) {                                                                     // connection is kept for subsequent requests, Func must not close it
+							SlaveSockFd ssfd { efd } ;
+							func(::move(r),ssfd) ;
+							ssfd.detach() ;
+							trace("called_persistent") ;
+							continue ;
+						}
+						close_slave(efd,false/*close*/) ; // Func may trigger efd being closed by another thread, hence epoll.del must be done before
 						SlaveSockFd ssfd { efd }            ;
 						bool        keep = false/*garbage*/ ;
 						keep=func(::move(r),ssfd) ;
@@ -167,13 +198,17 @@ private :
 	}
 	// cxtors & casts
 public :
-	ServerThread( char key , ::function<bool/*keep_fd*/(Req&&,SlaveSockFd const&)> func , int backlog=0 ) : fd{New,backlog} , _thread{_s_thread_func,key,this,func} {}
+	ServerThread( char key , ::function<bool/*keep_fd*/(Req&&,SlaveSockFd const&)> func , int backlog=0 , bool persistent_=false ) :
+		fd{New,backlog} , persistent{persistent_} , _thread{_s_thread_func,key,this,func}
+	{}
 	// services
 	void wait_started() {
 		_ready.wait() ;
 	}
 	// data
-	ServerSockFd fd ;
+	ServerSockFd     fd         ;
+	bool             persistent = false ;                                                                             // if true, connections are kept open to receive several requests
+	::atomic<size_t> n_slaves   = 0     ;                                                                             // number of open connections, may be read from any thread
 private :
 	::latch   _ready  {1} ;
 	::jthread _thread ;                             // ensure _thread is last so other fields are constructed when it starts
@@ -906,6 +906,7 @@ ENUM( MutexLvl // identify who is owning the current level to ease debugging
 ,	None
 // level 1
 ,	Audit
+,	CacheServer
 ,	JobExec
 ,	Rule
 ,	StartJob
@@ -923,9 +924,15 @@ ENUM( MutexLvl // identify who is owning the current level to ease debugging
 // level 5
 ,	Autodep2   // must follow Autodep1
 // inner (locks that take no other locks)
+,	Cache
+,	EvalCache
 ,	File
 ,	Hash
+,	JobInfo
+,	Record     // protect Record internal state, as audited calls run concurrently
 ,	SmallId
+,	SrcPrefetch
+,	SrcWatcher
 ,	SyscallTab
 ,	Time
 ,	Trace      // last to allow tracing anywhere
@@ -0,0 +1,19 @@
+	#pragma once
+	#define ADDR2LINE                   "/usr/bin/llvm-addr2line"
+	#define HAS_CLOSE_RANGE             1
+	#define HAS_LD_AUDIT                1
+	#define HAS_MEMFD                   1
+	#define HAS_OSTRINGSTREAM_VIEW      1
+	#define HAS_PCRE                    0
+	#define HAS_PTRACE_GET_SYSCALL_INFO 1
+	#define HAS_SECCOMP                 0
+	#define HAS_SECCOMP_NOTIF           1
+	#define HAS_SLURM                   0
+	#define HAS_STACKTRACE              0
+	#define HAS_ZLIB                    1
+	#define HAS_ZSTD                    0
+	#define MUST_UNDEF_PTRACE_MACROS    1
+	#define NEED_STAT_WRAPPERS          0
+	#define PY_LD_LIBRARY_PATH          "/root/.pyenv/versions/3.11.7/lib"
+	#define PYTHON                      "/root/.pyenv/shims/python3"
+	#define USE_LIBC_START_MAIN         1
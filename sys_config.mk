@@ -0,0 +1,26 @@
+BASH           := /bin/bash
+GIT            := /usr/bin/git
+#
+PYTHON2        := 
+PY2_INCLUDEDIR := 
+PY2_INCLUDEPY  := 
+PY2_LIB_DIR    := 
+PY2_LIB_BASE   := 
+PYTHON         := /root/.pyenv/shims/python3
+PY_INCLUDEDIR  := /root/.pyenv/versions/3.11.7/include
+PY_INCLUDEPY   := /root/.pyenv/versions/3.11.7/include/python3.11
+PY_LIB_DIR     := /root/.pyenv/versions/3.11.7/lib
+PY_LIB_BASE    := libpython3.11.so
+#
+CXX            := /usr/bin/g++
+CXX_FLAVOR     := gcc
+LINK_LIB_PATH  := 
+STD_INC_DIRS   := /usr/include/c++/12 /usr/include/x86_64-linux-gnu/c++/12 /usr/include/c++/12/backward /usr/lib/gcc/x86_64-linux-gnu/12/include /usr/local/include /usr/include/x86_64-linux-gnu /usr/include
+#
+HAS_PCRE       := 
+HAS_SECCOMP    := 
+HAS_SLURM      := 
+HAS_ZLIB       := 1
+HAS_ZSTD       := 
+#
+STD_PATH       := /usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.
@@ -0,0 +1,8 @@
+	#include<sys/ptrace.h>
+	#include<linux/ptrace.h>
+	#if MUST_UNDEF_PTRACE_MACROS
+		#undef PTRACE_GET_SYSCALL_INFO
+	#endif
+	void foo() {
+		long rx = ptrace(PTRACE_GET_SYSCALL_INFO,0,0,0) ;
+	}
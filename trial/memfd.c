@@ -0,0 +1,5 @@
+	#ifndef _GNU_SOURCE
+		#define _GNU_SOURCE
+	#endif
+	#include<sys/mman.h>
+	int main() { memfd_create("trial",0) ; }
@@ -0,0 +1,4 @@
+	#include <Python.h>
+	int main() {
+		PyObject* none = Py_None ;
+	}
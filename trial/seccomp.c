@@ -0,0 +1,2 @@
+	#include <seccomp.h>
+	struct scmp_version v ;
@@ -0,0 +1,4 @@
+	#include <sys/ioctl.h>
+	#include <linux/seccomp.h>
+	int           flags = SECCOMP_USER_NOTIF_FLAG_CONTINUE ;
+	unsigned long req   = SECCOMP_IOCTL_NOTIF_RECV         ;
@@ -0,0 +1,2 @@
+	#include <stacktrace>
+	std::stacktrace st ;
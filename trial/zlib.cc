@@ -0,0 +1,4 @@
+	#include <zlib.h>
+	void foo() {
+		deflateInit(nullptr,Z_BEST_SPEED) ;
+	}
@@ -0,0 +1,4 @@
+	#include <zstd.h>
+	void foo() {
+		ZSTD_compressStream2(nullptr,nullptr,nullptr,ZSTD_e_end) ;
+	}
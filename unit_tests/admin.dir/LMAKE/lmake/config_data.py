@@ -0,0 +1,45 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'host_length': None, 'has_exec_time': True}
+	,	'n_tokens_tab'        : {}
+	,	'backends'            : {'precisions': {'cpu': 4, 'mem': 4, 'tmp': 4}, 'local': {'cpu': 1, 'mem': '6013M', 'tmp': 0}}
+	,	'caches'              : {}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	,	'local_admin_dir'     : 'LMAKE_LOCAL'
+	,	'remote_admin_dir'    : 'LMAKE_REMOTE'
+	}
+,	'rules' : (
+		{
+			'name'               : 'Test'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('test', 'target')}
+		,	'job_name'           : 'test'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/admin.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/admin.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': ''},)
+		}
+	,)
+,	'manifest' : (
+		'Lmakefile.py'
+	,)
+}
@@ -0,0 +1,129 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'host_length': None, 'has_exec_time': True}
+	,	'n_tokens_tab'        : {}
+	,	'backends'            : {'precisions': {'cpu': 4, 'mem': 4, 'tmp': 4}, 'local': {'cpu': 1, 'mem': '6003M', 'tmp': 0}}
+	,	'caches'              : {}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	}
+,	'rules' : (
+		{
+			'name'               : 'bench-none'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('bench.none', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'bench.none'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/autodep_bench.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/autodep_bench.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'none'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\nn = 20000\nn_srcs = 10\ndef cmd1() :\n\t\t\t\timport os\n\t\t\t\tfor i in range(n) :\n\t\t\t\t\tf = f'src{i%n_srcs}'\n\t\t\t\t\tif i%2 : os.stat(f)\n\t\t\t\t\telse   : open(f).read()\n\t\t\t\tprint(n)\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, (), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',141)\nlmake_sourcify(cmd1,'Lmakefile','Bench.cmd','Lmakefile.py',33)\n")
+		}
+	,	{
+			'name'               : 'bench-ld_audit'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('bench.ld_audit', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'bench.ld_audit'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/autodep_bench.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/autodep_bench.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\nn = 20000\nn_srcs = 10\ndef cmd1() :\n\t\t\t\timport os\n\t\t\t\tfor i in range(n) :\n\t\t\t\t\tf = f'src{i%n_srcs}'\n\t\t\t\t\tif i%2 : os.stat(f)\n\t\t\t\t\telse   : open(f).read()\n\t\t\t\tprint(n)\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, (), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',141)\nlmake_sourcify(cmd1,'Lmakefile','Bench.cmd','Lmakefile.py',33)\n")
+		}
+	,	{
+			'name'               : 'bench-ld_preload'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('bench.ld_preload', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'bench.ld_preload'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/autodep_bench.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/autodep_bench.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_preload'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\nn = 20000\nn_srcs = 10\ndef cmd1() :\n\t\t\t\timport os\n\t\t\t\tfor i in range(n) :\n\t\t\t\t\tf = f'src{i%n_srcs}'\n\t\t\t\t\tif i%2 : os.stat(f)\n\t\t\t\t\telse   : open(f).read()\n\t\t\t\tprint(n)\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, (), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',141)\nlmake_sourcify(cmd1,'Lmakefile','Bench.cmd','Lmakefile.py',33)\n")
+		}
+	,	{
+			'name'               : 'bench-ptrace'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('bench.ptrace', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'bench.ptrace'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/autodep_bench.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/autodep_bench.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ptrace'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\nn = 20000\nn_srcs = 10\ndef cmd1() :\n\t\t\t\timport os\n\t\t\t\tfor i in range(n) :\n\t\t\t\t\tf = f'src{i%n_srcs}'\n\t\t\t\t\tif i%2 : os.stat(f)\n\t\t\t\t\telse   : open(f).read()\n\t\t\t\tprint(n)\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, (), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',141)\nlmake_sourcify(cmd1,'Lmakefile','Bench.cmd','Lmakefile.py',33)\n")
+		}
+	,	{
+			'name'               : 'bench-seccomp_notif'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('bench.seccomp_notif', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'bench.seccomp_notif'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/autodep_bench.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/autodep_bench.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'seccomp_notif'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\nn = 20000\nn_srcs = 10\ndef cmd1() :\n\t\t\t\timport os\n\t\t\t\tfor i in range(n) :\n\t\t\t\t\tf = f'src{i%n_srcs}'\n\t\t\t\t\tif i%2 : os.stat(f)\n\t\t\t\t\telse   : open(f).read()\n\t\t\t\tprint(n)\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, (), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',141)\nlmake_sourcify(cmd1,'Lmakefile','Bench.cmd','Lmakefile.py',33)\n")
+		}
+	)
+,	'manifest' : (
+		'Lmakefile.py'
+	,	'src0'
+	,	'src1'
+	,	'src2'
+	,	'src3'
+	,	'src4'
+	,	'src5'
+	,	'src6'
+	,	'src7'
+	,	'src8'
+	,	'src9'
+	)
+}
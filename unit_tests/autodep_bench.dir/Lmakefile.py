@@ -0,0 +1,59 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# compare the cost of autodep methods on a syscall-heavy job and check they all record the accessed deps
+
+import lmake
+
+n_srcs = 10
+n      = 20000 # number of accesses per job
+
+autodeps = ['none']
+if lmake.has_ld_audit      : autodeps.append('ld_audit'     )
+if lmake.has_ld_preload    : autodeps.append('ld_preload'   )
+if lmake.has_ptrace        : autodeps.append('ptrace'       )
+if lmake.has_seccomp_notif : autodeps.append('seccomp_notif')
+
+if __name__!='__main__' :
+
+	from lmake.rules import PyRule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	*( f'src{i}' for i in range(n_srcs) )
+	)
+
+	for ad in autodeps :
+		class Bench(PyRule) :
+			name    = f'bench-{ad}'
+			target  = f'bench.{ad}'
+			autodep = ad
+			def cmd() :
+				import os
+				for i in range(n) :
+					f = f'src{i%n_srcs}'
+					if i%2 : os.stat(f)
+					else   : open(f).read()
+				print(n)
+
+else :
+
+	import time
+
+	import ut
+
+	for i in range(n_srcs) : print(i,file=open(f'src{i}','w'))
+
+	times = {}
+	for ad in autodeps :
+		start = time.time()
+		ut.lmake( f'bench.{ad}' , done=1 , new=... )
+		times[ad] = time.time() - start
+		assert int(open(f'bench.{ad}').read())==n,ad
+
+	for ad,t in times.items() : print(f'{ad:15} : {t:.3f}s')
+
+	print('new',file=open('src0','w'))
+	ut.lmake( *(f'bench.{ad}' for ad in autodeps) , steady=len(autodeps)-1 , changed=1 )        # all methods but none must have recorded deps
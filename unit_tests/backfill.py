@@ -0,0 +1,59 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+n_cpu = 4
+
+if __name__!='__main__' :
+
+	import time
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'src'
+	)
+
+	lmake.config.backends.local.cpu      = n_cpu
+	lmake.config.backends.local.backfill = True
+
+	class Dut(Rule) :
+		target    = r'dut_{C:\d+}_{D:\d+}_{N:\d+}'
+		resources = { 'cpu':'{C}' }
+		def cmd() :
+			open('src').read()                                                 # all jobs are rerun when src is modified
+			start = time.time()
+			time.sleep(int(D)/10)
+			print(start,time.time())
+
+else :
+
+	import ut
+
+	# at first run, all jobs have the same pressure, so they are considered in order
+	# once exec times are known, pressure is long > big > small
+	# in both cases, long is launched first, then big is blocked until long ends
+	long  = 'dut_1_50_0'
+	big   = f'dut_{n_cpu}_25_0'
+	small = [ f'dut_1_10_{i}' for i in range(1,13) ]
+	duts  = [long,big,*small]
+
+	def dates(t) : return [ float(x) for x in open(t).read().split() ]
+
+	print('v1',file=open('src','w'))
+	ut.lmake( *duts , done=len(duts) , new=1 )
+	# exec times are not known : small jobs could delay big for any time, so they are not launched while big is blocked
+	assert dates(big)[0]-dates(long)[1]<0.5              , 'big was delayed'
+	assert all( dates(s)[0]>=dates(big)[0] for s in small ) , 'small job was launched while big was blocked'
+
+	print('v2',file=open('src','w'))
+	ut.lmake( *duts , done=len(duts) , changed=1 )
+	# exec times are known : small jobs that end before long are launched while big is blocked, but not those that would delay it
+	assert any( dates(s)[0]<dates(long)[1] for s in small ) , 'no small job was launched while big was blocked'
+	assert dates(big)[0]-dates(long)[1]<0.5                 , 'big was delayed'
+	assert any( dates(s)[0]>=dates(big)[1] for s in small ) , 'big was launched last'
+
+	ut.lmake( *duts , done=0 )                                                 # check everything is up to date
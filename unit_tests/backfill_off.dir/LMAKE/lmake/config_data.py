@@ -0,0 +1,43 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'host_length': None, 'has_exec_time': True}
+	,	'n_tokens_tab'        : {}
+	,	'backends'            : {'precisions': {'cpu': 4, 'mem': 4, 'tmp': 4}, 'local': {'cpu': 4, 'mem': '6003M', 'tmp': 0, 'backfill': False}}
+	,	'caches'              : {}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	}
+,	'rules' : (
+		{
+			'name'               : 'Dut'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('dut_{C:\\d+}_{D:\\d+}_{N:\\d+}', 'target')}
+		,	'job_name'           : 'dut_{C:\\d+}_{D:\\d+}_{N:\\d+}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': None}}, ('C',), '', "{ 'rsrcs':{ 'cpu':f'{C}' } }", '', '')
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/backfill_off.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/backfill_off.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': 'import time\ndef cmd() :\n\t\t\tstart = time.time()\n\t\t\ttime.sleep(int(D)/10)\n\t\t\tprint(start,time.time())\n'}, ('D',), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd,'Lmakefile','Dut.cmd','Lmakefile.py',23)\n")
+		}
+	,)
+,	'manifest' : (
+		'Lmakefile.py'
+	,)
+}
@@ -0,0 +1,43 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+n_cpu = 4
+
+if __name__!='__main__' :
+
+	import time
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.backends.local.cpu      = n_cpu
+	lmake.config.backends.local.backfill = False
+
+	class Dut(Rule) :
+		target    = r'dut_{C:\d+}_{D:\d+}_{N:\d+}'
+		resources = { 'cpu':'{C}' }
+		def cmd() :
+			start = time.time()
+			time.sleep(int(D)/10)
+			print(start,time.time())
+
+else :
+
+	import ut
+
+	# jobs have never run, so they all have the same pressure and are considered in order : long is launched first, then big is blocked until long ends
+	long  = 'dut_1_30_0'
+	big   = f'dut_{n_cpu}_10_0'
+	small = [ f'dut_1_10_{i}' for i in range(1,n_cpu) ]
+	duts  = [long,big,*small]
+
+	def dates(t) : return [ float(x) for x in open(t).read().split() ]
+
+	ut.lmake( *duts , done=len(duts) )
+	# without backfill, no resources are reserved for big, so jobs of unknown duration that fit are launched while big is blocked
+	assert dates(big)[0]>=dates(long)[1]                  , 'big was not blocked'
+	assert all( dates(s)[0]<dates(long)[1] for s in small ) , 'small job was not launched while big was blocked'
@@ -0,0 +1,286 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'host_length': None, 'has_exec_time': True}
+	,	'n_tokens_tab'        : {}
+	,	'backends'            : {'precisions': {'cpu': 4, 'mem': 4, 'tmp': 4}, 'local': {'cpu': 1, 'mem': '6013M', 'tmp': 0}}
+	,	'caches'              : {}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	}
+,	'rules' : (
+		{
+			'name'               : 'Compile'
+		,	'stems'              : {}
+		,	'matches'            : {'OBJ': ('{File:.*}.o', 'target')}
+		,	'job_name'           : '{File:.*}.o'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'SRC': '{File}.c'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/bench.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/bench.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_preload'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({}, ('OBJ', 'SRC'), "gxx = '/usr/bin/g++'\n", "f'{gxx} -c -o {OBJ} -xc {SRC}'", '', '')
+		}
+	,	{
+			'name'               : 'Link'
+		,	'stems'              : {}
+		,	'matches'            : {'EXE': ('{File:.*}.exe', 'target')}
+		,	'job_name'           : '{File:.*}.exe'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/bench.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/bench.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_preload'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({}, ('File', 'EXE'), "gxx = '/usr/bin/g++'\nl = 10\n", 'f"{gxx} -o {EXE} {\' \'.join((f\'{File}.file_{o}.o\' for o in range(l)))}"', '', '')
+		}
+	,	{
+			'name'               : 'All'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('all_{N:\\d+}', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'all_{N:\\d+}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/bench.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/bench.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\nimport lmake\ndef cmd1() :\n\t\t\tlmake.depend(*(f'exe_{e}.exe' for e in range(int(N))))\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, ('N',), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',140)\nlmake_sourcify(cmd1,'Lmakefile','All.cmd','Lmakefile.py',41)\n")
+		}
+	)
+,	'manifest' : (
+		'Lmakefile.py'
+	,	'exe_0.file_0.c'
+	,	'exe_0.file_1.c'
+	,	'exe_0.file_2.c'
+	,	'exe_0.file_3.c'
+	,	'exe_0.file_4.c'
+	,	'exe_0.file_5.c'
+	,	'exe_0.file_6.c'
+	,	'exe_0.file_7.c'
+	,	'exe_0.file_8.c'
+	,	'exe_0.file_9.c'
+	,	'exe_1.file_0.c'
+	,	'exe_1.file_1.c'
+	,	'exe_1.file_2.c'
+	,	'exe_1.file_3.c'
+	,	'exe_1.file_4.c'
+	,	'exe_1.file_5.c'
+	,	'exe_1.file_6.c'
+	,	'exe_1.file_7.c'
+	,	'exe_1.file_8.c'
+	,	'exe_1.file_9.c'
+	,	'exe_2.file_0.c'
+	,	'exe_2.file_1.c'
+	,	'exe_2.file_2.c'
+	,	'exe_2.file_3.c'
+	,	'exe_2.file_4.c'
+	,	'exe_2.file_5.c'
+	,	'exe_2.file_6.c'
+	,	'exe_2.file_7.c'
+	,	'exe_2.file_8.c'
+	,	'exe_2.file_9.c'
+	,	'exe_3.file_0.c'
+	,	'exe_3.file_1.c'
+	,	'exe_3.file_2.c'
+	,	'exe_3.file_3.c'
+	,	'exe_3.file_4.c'
+	,	'exe_3.file_5.c'
+	,	'exe_3.file_6.c'
+	,	'exe_3.file_7.c'
+	,	'exe_3.file_8.c'
+	,	'exe_3.file_9.c'
+	,	'exe_4.file_0.c'
+	,	'exe_4.file_1.c'
+	,	'exe_4.file_2.c'
+	,	'exe_4.file_3.c'
+	,	'exe_4.file_4.c'
+	,	'exe_4.file_5.c'
+	,	'exe_4.file_6.c'
+	,	'exe_4.file_7.c'
+	,	'exe_4.file_8.c'
+	,	'exe_4.file_9.c'
+	,	'exe_5.file_0.c'
+	,	'exe_5.file_1.c'
+	,	'exe_5.file_2.c'
+	,	'exe_5.file_3.c'
+	,	'exe_5.file_4.c'
+	,	'exe_5.file_5.c'
+	,	'exe_5.file_6.c'
+	,	'exe_5.file_7.c'
+	,	'exe_5.file_8.c'
+	,	'exe_5.file_9.c'
+	,	'exe_6.file_0.c'
+	,	'exe_6.file_1.c'
+	,	'exe_6.file_2.c'
+	,	'exe_6.file_3.c'
+	,	'exe_6.file_4.c'
+	,	'exe_6.file_5.c'
+	,	'exe_6.file_6.c'
+	,	'exe_6.file_7.c'
+	,	'exe_6.file_8.c'
+	,	'exe_6.file_9.c'
+	,	'exe_7.file_0.c'
+	,	'exe_7.file_1.c'
+	,	'exe_7.file_2.c'
+	,	'exe_7.file_3.c'
+	,	'exe_7.file_4.c'
+	,	'exe_7.file_5.c'
+	,	'exe_7.file_6.c'
+	,	'exe_7.file_7.c'
+	,	'exe_7.file_8.c'
+	,	'exe_7.file_9.c'
+	,	'exe_8.file_0.c'
+	,	'exe_8.file_1.c'
+	,	'exe_8.file_2.c'
+	,	'exe_8.file_3.c'
+	,	'exe_8.file_4.c'
+	,	'exe_8.file_5.c'
+	,	'exe_8.file_6.c'
+	,	'exe_8.file_7.c'
+	,	'exe_8.file_8.c'
+	,	'exe_8.file_9.c'
+	,	'exe_9.file_0.c'
+	,	'exe_9.file_1.c'
+	,	'exe_9.file_2.c'
+	,	'exe_9.file_3.c'
+	,	'exe_9.file_4.c'
+	,	'exe_9.file_5.c'
+	,	'exe_9.file_6.c'
+	,	'exe_9.file_7.c'
+	,	'exe_9.file_8.c'
+	,	'exe_9.file_9.c'
+	,	'inc_0.h'
+	,	'inc_1.h'
+	,	'inc_2.h'
+	,	'inc_3.h'
+	,	'inc_4.h'
+	,	'inc_5.h'
+	,	'inc_6.h'
+	,	'inc_7.h'
+	,	'inc_8.h'
+	,	'inc_9.h'
+	,	'inc_10.h'
+	,	'inc_11.h'
+	,	'inc_12.h'
+	,	'inc_13.h'
+	,	'inc_14.h'
+	,	'inc_15.h'
+	,	'inc_16.h'
+	,	'inc_17.h'
+	,	'inc_18.h'
+	,	'inc_19.h'
+	,	'inc_20.h'
+	,	'inc_21.h'
+	,	'inc_22.h'
+	,	'inc_23.h'
+	,	'inc_24.h'
+	,	'inc_25.h'
+	,	'inc_26.h'
+	,	'inc_27.h'
+	,	'inc_28.h'
+	,	'inc_29.h'
+	,	'inc_30.h'
+	,	'inc_31.h'
+	,	'inc_32.h'
+	,	'inc_33.h'
+	,	'inc_34.h'
+	,	'inc_35.h'
+	,	'inc_36.h'
+	,	'inc_37.h'
+	,	'inc_38.h'
+	,	'inc_39.h'
+	,	'inc_40.h'
+	,	'inc_41.h'
+	,	'inc_42.h'
+	,	'inc_43.h'
+	,	'inc_44.h'
+	,	'inc_45.h'
+	,	'inc_46.h'
+	,	'inc_47.h'
+	,	'inc_48.h'
+	,	'inc_49.h'
+	,	'inc_50.h'
+	,	'inc_51.h'
+	,	'inc_52.h'
+	,	'inc_53.h'
+	,	'inc_54.h'
+	,	'inc_55.h'
+	,	'inc_56.h'
+	,	'inc_57.h'
+	,	'inc_58.h'
+	,	'inc_59.h'
+	,	'inc_60.h'
+	,	'inc_61.h'
+	,	'inc_62.h'
+	,	'inc_63.h'
+	,	'inc_64.h'
+	,	'inc_65.h'
+	,	'inc_66.h'
+	,	'inc_67.h'
+	,	'inc_68.h'
+	,	'inc_69.h'
+	,	'inc_70.h'
+	,	'inc_71.h'
+	,	'inc_72.h'
+	,	'inc_73.h'
+	,	'inc_74.h'
+	,	'inc_75.h'
+	,	'inc_76.h'
+	,	'inc_77.h'
+	,	'inc_78.h'
+	,	'inc_79.h'
+	,	'inc_80.h'
+	,	'inc_81.h'
+	,	'inc_82.h'
+	,	'inc_83.h'
+	,	'inc_84.h'
+	,	'inc_85.h'
+	,	'inc_86.h'
+	,	'inc_87.h'
+	,	'inc_88.h'
+	,	'inc_89.h'
+	,	'inc_90.h'
+	,	'inc_91.h'
+	,	'inc_92.h'
+	,	'inc_93.h'
+	,	'inc_94.h'
+	,	'inc_95.h'
+	,	'inc_96.h'
+	,	'inc_97.h'
+	,	'inc_98.h'
+	,	'inc_99.h'
+	,	'inc_100.h'
+	,	'inc_101.h'
+	,	'inc_102.h'
+	,	'inc_103.h'
+	,	'inc_104.h'
+	)
+}
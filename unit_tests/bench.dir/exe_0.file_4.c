@@ -0,0 +1,6 @@
+				#include "inc_0.h"
+#include "inc_1.h"
+#include "inc_2.h"
+#include "inc_3.h"
+#include "inc_4.h"
+				int foo_4() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_1.h"
+#include "inc_2.h"
+#include "inc_3.h"
+#include "inc_4.h"
+#include "inc_5.h"
+				int foo_1() { return 0 ; }
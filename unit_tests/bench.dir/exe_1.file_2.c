@@ -0,0 +1,6 @@
+				#include "inc_2.h"
+#include "inc_3.h"
+#include "inc_4.h"
+#include "inc_5.h"
+#include "inc_6.h"
+				int foo_2() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_6.h"
+#include "inc_7.h"
+#include "inc_8.h"
+#include "inc_9.h"
+#include "inc_10.h"
+				int foo_6() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_8.h"
+#include "inc_9.h"
+#include "inc_10.h"
+#include "inc_11.h"
+#include "inc_12.h"
+				int foo_8() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_10.h"
+#include "inc_11.h"
+#include "inc_12.h"
+#include "inc_13.h"
+#include "inc_14.h"
+				int foo_5() { return 0 ; }
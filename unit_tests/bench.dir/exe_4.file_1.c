@@ -0,0 +1,6 @@
+				#include "inc_4.h"
+#include "inc_5.h"
+#include "inc_6.h"
+#include "inc_7.h"
+#include "inc_8.h"
+				int foo_1() { return 0 ; }
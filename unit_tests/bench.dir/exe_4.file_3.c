@@ -0,0 +1,6 @@
+				#include "inc_12.h"
+#include "inc_13.h"
+#include "inc_14.h"
+#include "inc_15.h"
+#include "inc_16.h"
+				int foo_3() { return 0 ; }
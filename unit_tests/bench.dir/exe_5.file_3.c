@@ -0,0 +1,6 @@
+				#include "inc_15.h"
+#include "inc_16.h"
+#include "inc_17.h"
+#include "inc_18.h"
+#include "inc_19.h"
+				int foo_3() { return 0 ; }
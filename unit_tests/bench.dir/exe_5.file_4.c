@@ -0,0 +1,6 @@
+				#include "inc_20.h"
+#include "inc_21.h"
+#include "inc_22.h"
+#include "inc_23.h"
+#include "inc_24.h"
+				int foo_4() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_25.h"
+#include "inc_26.h"
+#include "inc_27.h"
+#include "inc_28.h"
+#include "inc_29.h"
+				int foo_5() { return 0 ; }
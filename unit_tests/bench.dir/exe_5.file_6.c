@@ -0,0 +1,6 @@
+				#include "inc_30.h"
+#include "inc_31.h"
+#include "inc_32.h"
+#include "inc_33.h"
+#include "inc_34.h"
+				int foo_6() { return 0 ; }
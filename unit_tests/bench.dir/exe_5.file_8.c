@@ -0,0 +1,6 @@
+				#include "inc_40.h"
+#include "inc_41.h"
+#include "inc_42.h"
+#include "inc_43.h"
+#include "inc_44.h"
+				int foo_8() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_45.h"
+#include "inc_46.h"
+#include "inc_47.h"
+#include "inc_48.h"
+#include "inc_49.h"
+				int foo_9() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_18.h"
+#include "inc_19.h"
+#include "inc_20.h"
+#include "inc_21.h"
+#include "inc_22.h"
+				int foo_3() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_14.h"
+#include "inc_15.h"
+#include "inc_16.h"
+#include "inc_17.h"
+#include "inc_18.h"
+				int foo_2() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_21.h"
+#include "inc_22.h"
+#include "inc_23.h"
+#include "inc_24.h"
+#include "inc_25.h"
+				int foo_3() { return 0 ; }
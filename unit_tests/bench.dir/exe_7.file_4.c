@@ -0,0 +1,6 @@
+				#include "inc_28.h"
+#include "inc_29.h"
+#include "inc_30.h"
+#include "inc_31.h"
+#include "inc_32.h"
+				int foo_4() { return 0 ; }
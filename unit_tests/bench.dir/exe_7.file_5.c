@@ -0,0 +1,6 @@
+				#include "inc_35.h"
+#include "inc_36.h"
+#include "inc_37.h"
+#include "inc_38.h"
+#include "inc_39.h"
+				int foo_5() { return 0 ; }
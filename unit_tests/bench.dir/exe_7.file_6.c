@@ -0,0 +1,6 @@
+				#include "inc_42.h"
+#include "inc_43.h"
+#include "inc_44.h"
+#include "inc_45.h"
+#include "inc_46.h"
+				int foo_6() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_49.h"
+#include "inc_50.h"
+#include "inc_51.h"
+#include "inc_52.h"
+#include "inc_53.h"
+				int foo_7() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_56.h"
+#include "inc_57.h"
+#include "inc_58.h"
+#include "inc_59.h"
+#include "inc_60.h"
+				int foo_8() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_63.h"
+#include "inc_64.h"
+#include "inc_65.h"
+#include "inc_66.h"
+#include "inc_67.h"
+				int foo_9() { return 0 ; }
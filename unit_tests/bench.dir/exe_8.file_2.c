@@ -0,0 +1,6 @@
+				#include "inc_16.h"
+#include "inc_17.h"
+#include "inc_18.h"
+#include "inc_19.h"
+#include "inc_20.h"
+				int foo_2() { return 0 ; }
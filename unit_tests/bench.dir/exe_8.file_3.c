@@ -0,0 +1,6 @@
+				#include "inc_24.h"
+#include "inc_25.h"
+#include "inc_26.h"
+#include "inc_27.h"
+#include "inc_28.h"
+				int foo_3() { return 0 ; }
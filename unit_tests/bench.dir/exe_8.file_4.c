@@ -0,0 +1,6 @@
+				#include "inc_32.h"
+#include "inc_33.h"
+#include "inc_34.h"
+#include "inc_35.h"
+#include "inc_36.h"
+				int foo_4() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_48.h"
+#include "inc_49.h"
+#include "inc_50.h"
+#include "inc_51.h"
+#include "inc_52.h"
+				int foo_6() { return 0 ; }
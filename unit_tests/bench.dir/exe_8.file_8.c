@@ -0,0 +1,6 @@
+				#include "inc_64.h"
+#include "inc_65.h"
+#include "inc_66.h"
+#include "inc_67.h"
+#include "inc_68.h"
+				int foo_8() { return 0 ; }
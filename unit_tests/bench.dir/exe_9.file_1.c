@@ -0,0 +1,6 @@
+				#include "inc_9.h"
+#include "inc_10.h"
+#include "inc_11.h"
+#include "inc_12.h"
+#include "inc_13.h"
+				int foo_1() { return 0 ; }
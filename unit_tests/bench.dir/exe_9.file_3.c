@@ -0,0 +1,6 @@
+				#include "inc_27.h"
+#include "inc_28.h"
+#include "inc_29.h"
+#include "inc_30.h"
+#include "inc_31.h"
+				int foo_3() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_36.h"
+#include "inc_37.h"
+#include "inc_38.h"
+#include "inc_39.h"
+#include "inc_40.h"
+				int foo_4() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_54.h"
+#include "inc_55.h"
+#include "inc_56.h"
+#include "inc_57.h"
+#include "inc_58.h"
+				int foo_6() { return 0 ; }
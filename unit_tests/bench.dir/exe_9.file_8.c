@@ -0,0 +1,6 @@
+				#include "inc_72.h"
+#include "inc_73.h"
+#include "inc_74.h"
+#include "inc_75.h"
+#include "inc_76.h"
+				int foo_8() { return 0 ; }
@@ -0,0 +1,6 @@
+				#include "inc_81.h"
+#include "inc_82.h"
+#include "inc_83.h"
+#include "inc_84.h"
+#include "inc_85.h"
+				int foo_9() { return 0 ; }
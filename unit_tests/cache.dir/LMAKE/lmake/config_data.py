@@ -0,0 +1,83 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'host_length': None, 'has_exec_time': True}
+	,	'n_tokens_tab'        : {}
+	,	'backends'            : {'precisions': {'cpu': 4, 'mem': 4, 'tmp': 4}, 'local': {'cpu': 1, 'mem': '6003M', 'tmp': 0}}
+	,	'caches'              : {'dir': {'tag': 'dir', 'repo': '/root/repo/unit_tests/cache.dir', 'dir': '/root/repo/unit_tests/cache.dir/CACHE'}}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	}
+,	'rules' : (
+		{
+			'name'               : 'Auto'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('auto{:\\d}', 'target')}
+		,	'job_name'           : 'auto{:\\d}'
+		,	'max_submit_count'   : 1
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({'key': 'dir'},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/cache.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/cache.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': "echo '#auto'"},)
+		}
+	,	{
+			'name'               : 'Hide'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('{File:.*}.hide', 'target')}
+		,	'job_name'           : '{File:.*}.hide'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({'key': 'dir'},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/cache.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/cache.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({'allow_stderr': True},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': 'cat {File} || :'},)
+		}
+	,	{
+			'name'               : 'Cat'
+		,	'stems'              : {'File1': '.*', 'File2': '.*'}
+		,	'prio'               : 1.0
+		,	'matches'            : {'<stdout>': ('{File1}+{File2}', 'target')}
+		,	'job_name'           : '{File1}+{File2}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({'key': 'dir'},)
+		,	'deps_attrs'         : ({'FIRST': '{File1}', 'SECOND': '{File2}'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/cache.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/cache.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': 'cat {FIRST} {SECOND}'},)
+		}
+	)
+,	'manifest' : (
+		'Lmakefile.py'
+	,	'hello'
+	)
+}
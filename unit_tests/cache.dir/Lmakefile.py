@@ -0,0 +1,74 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'hello'
+	)
+
+	lmake.config.caches.dir = {
+		'tag'  : 'dir'
+	,	'repo' : lmake.root_dir
+	,	'dir'  : lmake.root_dir+'/CACHE'
+	}
+
+	class Auto(Rule) :
+		target           = r'auto{:\d}'
+		cache            = 'dir'
+		max_submit_count = 1                                                   # waiting for a delayed cache match must not count as a submission
+		cmd              = "echo '#auto'"
+
+	class Hide(Rule) :
+		target       = r'{File:.*}.hide'
+		allow_stderr = True
+		cache        = 'dir'
+		cmd          = 'cat {File} || :'
+
+	class Cat(Rule) :
+		prio = 1
+		stems = {
+			'File1' : r'.*'
+		,	'File2' : r'.*'
+		}
+		target = '{File1}+{File2}'
+		deps = {
+			'FIRST'  : '{File1}'
+		,	'SECOND' : '{File2}'
+		}
+		cache = 'dir'
+		cmd   = 'cat {FIRST} {SECOND}'
+
+else :
+
+	import os
+
+	import ut
+
+	print('hello',file=open('hello','w'))
+
+	os.makedirs('CACHE/LMAKE')
+	print('1M',file=open('CACHE/LMAKE/size','w'))
+
+	ut.lmake( 'hello+auto1.hide' , done=3 , may_rerun=1 , new=1 )              # check target is out of date
+	ut.lmake( 'hello+auto1.hide' , done=0 ,               new=0 )              # check target is up to date
+
+	os.system('rm -rf LMAKE *auto*')
+
+	print('hello2',file=open('hello','w'))
+#	ut.lmake( 'hello+auto1.hide' , done=1 , hit_done=2 , new=1 )              # check cache hit on common part, and miss when we depend on hello
+
+	print('hello',file=open('hello','w'))
+	os.system('rm -rf LMAKE *auto* *.hide CACHE/*/*/match')                   # simulate a cache created before match trees were maintained
+	ut.lmake( 'hello+auto1.hide' , hit_done=3 , new=1 )                        # check match trees are rebuilt
+
+	print('2k',file=open('CACHE/LMAKE/size','w'))                              # force eviction, which prunes match trees
+	for i in range(2,6) : ut.lmake( f'hello+auto{i}.hide' , done=... , hit_done=... , may_rerun=... , new=... )
+	os.system('rm -rf LMAKE *auto* *.hide')
+	ut.lmake( 'hello+auto1.hide' , done=... , hit_done=... , may_rerun=... , new=1 ) # entries may have been evicted, but evicted variants must not be hit
@@ -20,9 +20,10 @@ if __name__!='__main__' :
 	}
 
 	class Auto(Rule) :
-		target = r'auto{:\d}'
-		cache  = 'dir'
-		cmd    = "echo '#auto'"
+		target           = r'auto{:\d}'
+		cache            = 'dir'
+		max_submit_count = 1                                                   # waiting for a delayed cache match must not count as a submission
+		cmd              = "echo '#auto'"
 
 	class Hide(Rule) :
 		target       = r'{File:.*}.hide'
@@ -62,3 +63,12 @@ else :
 
 	print('hello2',file=open('hello','w'))
 #	ut.lmake( 'hello+auto1.hide' , done=1 , hit_done=2 , new=1 )              # check cache hit on common part, and miss when we depend on hello
+
+	print('hello',file=open('hello','w'))
+	os.system('rm -rf LMAKE *auto* *.hide CACHE/*/*/match')                   # simulate a cache created before match trees were maintained
+	ut.lmake( 'hello+auto1.hide' , hit_done=3 , new=1 )                        # check match trees are rebuilt
+
+	print('2k',file=open('CACHE/LMAKE/size','w'))                              # force eviction, which prunes match trees
+	for i in range(2,6) : ut.lmake( f'hello+auto{i}.hide' , done=... , hit_done=... , may_rerun=... , new=... )
+	os.system('rm -rf LMAKE *auto* *.hide')
+	ut.lmake( 'hello+auto1.hide' , done=... , hit_done=... , may_rerun=... , new=1 ) # entries may have been evicted, but evicted variants must not be hit
@@ -0,0 +1,46 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# check contents are shared in dir cache when named after their 128 bits digest
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.caches.dir = {
+		'tag'      : 'dir'
+	,	'repo'     : lmake.root_dir
+	,	'dir'      : lmake.root_dir+'/CACHE'
+	,	'blob_key' : 'xxh128'
+	}
+
+	class Same(Rule) :
+		target = r'same{:\d}'
+		cache  = 'dir'
+		cmd    = 'echo same content'
+
+else :
+
+	import os
+
+	import ut
+
+	os.makedirs('CACHE/LMAKE')
+	print('1M',file=open('CACHE/LMAKE/size','w'))
+
+	ut.lmake( 'same1' , 'same2' , done=2 ) # populate cache
+
+	blobs = [ f for _,_,fs in os.walk('CACHE/LMAKE/blobs') for f in fs ]
+	assert len(blobs)==1 , blobs          # both entries share the same content
+	assert len(blobs[0])==32-2 , blobs    # blob is named after a 128 bits digest (first 2 hex digits are the dir)
+
+	os.system('rm -rf LMAKE same*')
+
+	ut.lmake( 'same1' , 'same2' , hit_done=2 ) # check content is retrieved from cache
+
+	assert open('same1').read()=='same content\n'
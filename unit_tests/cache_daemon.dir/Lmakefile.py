@@ -0,0 +1,73 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'hello'
+	)
+
+	lmake.config.caches.shared = {
+		'tag'  : 'daemon'
+	,	'repo' : lmake.root_dir
+	,	'dir'  : lmake.root_dir+'/CACHE'
+	}
+
+	class Auto(Rule) :
+		target = r'auto{:\d}'
+		cache  = 'shared'
+		cmd    = "echo '#auto'"
+
+	class Big(Rule) :                                                          # content spans many chunks when streamed
+		target = 'big'
+		cache  = 'shared'
+		cmd    = 'seq 1 200000'
+
+	class Cat(Rule) :
+		prio = 1
+		stems = {
+			'File1' : r'.*'
+		,	'File2' : r'.*'
+		}
+		target = '{File1}+{File2}'
+		deps = {
+			'FIRST'  : '{File1}'
+		,	'SECOND' : '{File2}'
+		}
+		cache = 'shared'
+		cmd   = 'cat {FIRST} {SECOND}'
+
+else :
+
+	import os
+	import os.path    as osp
+	import subprocess as sp
+	import time
+
+	import ut
+
+	print('hello',file=open('hello','w'))
+
+	os.makedirs('CACHE/LMAKE')
+	print('10M',file=open('CACHE/LMAKE/size','w'))
+
+	server = sp.Popen(('lcache_server','CACHE'))
+	while not osp.exists('CACHE/LMAKE/server') : time.sleep(0.1)
+
+	try :
+		ut.lmake( 'hello+auto1' , 'big' , done=3 , new=1 )                     # populate cache
+		big = open('big').read()
+
+		os.system('rm -rf LMAKE *auto* big')
+
+		ut.lmake( 'hello+auto1' , 'big' , hit_done=3 , new=1 )                 # check all jobs are retrieved through server
+		assert open('big').read()==big
+	finally :
+		server.terminate()
+		server.wait()
@@ -0,0 +1,39 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# check lines appended to a codec file are recorded without rewriting it, while other modifications lead to a canonical rewrite
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'codec_file'
+	)
+
+	class Decode(Rule) :
+		target = '{Code:.*}.dec'
+		cmd    = 'ldecode -f codec_file -x ctx -c {Code}'
+
+else :
+
+	import ut
+
+	print(' ctx b vb',file=open('codec_file','w'))
+	ut.lmake( 'b.dec' , new=1 , done=1 )
+
+	print(' ctx a va',file=open('codec_file','a'))                                     # pure append, out of order
+	ut.lmake( 'a.dec' , 'b.dec' , changed=1 , done=1 )                                 # b.dec is not rerun
+	assert open('codec_file').read()==' ctx b vb\n ctx a va\n'                         # file is not rewritten
+
+	print(' ctx b vb',file=open('codec_file','a'))                                     # duplicate, still an append
+	ut.lmake( 'a.dec' , 'b.dec' , changed=1 )
+	assert open('codec_file').read()==' ctx b vb\n ctx a va\n ctx b vb\n'
+
+	print(' ctx c vb',file=open('codec_file','a'))                                     # clash with a recorded association : full analysis
+	ut.lmake( 'a.dec' , 'b.dec' , refresh=1 , changed=1 , steady=... , done=... )
+	assert open('codec_file').read()==' ctx a va\n ctx b vb\n'                         # shorter code is kept, file is rewritten canonically
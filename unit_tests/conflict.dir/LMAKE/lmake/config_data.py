@@ -0,0 +1,119 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'host_length': None, 'has_exec_time': True}
+	,	'n_tokens_tab'        : {}
+	,	'backends'            : {'precisions': {'cpu': 4, 'mem': 4, 'tmp': 4}, 'local': {'cpu': 1, 'mem': '6013M', 'tmp': 0}}
+	,	'caches'              : {}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	}
+,	'rules' : (
+		{
+			'name'               : 'Star'
+		,	'stems'              : {'W': '(\\.w)?', 'Wait': '\\d+', 'Any': '.*'}
+		,	'matches'            : {'DST': ('out{W}.{Wait}/{Any*}', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'out{W}.{Wait}/{Any*}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/conflict.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/conflict.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\ndef cmd1() :\n\t\t\timport time\n\t\t\timport os\n\t\t\ttime.sleep(int(Wait))\n\t\t\tdir = f'out{Wait}'\n\t\t\tfor i in (1,2) :\n\t\t\t\tif W                     : open     (DST(f'mrkr{i}'),'w').write('bad')\n\t\t\t\ttry                      : os.unlink(DST(f'mrkr{i}'))\n\t\t\t\texcept FileNotFoundError : pass\n\t\t\tprint('a_file',file=open(DST('a_file'),'w'))\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, ('W', 'Wait', 'DST'), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',140)\nlmake_sourcify(cmd1,'Lmakefile','Star.cmd','Lmakefile.py',22)\n")
+		}
+	,	{
+			'name'               : 'Mrkr'
+		,	'stems'              : {'W': '(\\.w)?', 'Wait': '\\d+', 'Any': '.*'}
+		,	'matches'            : {'MRKR': ('{Any}/mrkr{Wait}', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : '{Any}/mrkr{Wait}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/conflict.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/conflict.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\ndef cmd1() :\n\t\t\timport os.path as osp\n\t\t\timport time\n\t\t\ttime.sleep(int(Wait))\n\t\t\tprint(osp.basename(MRKR),file=open(MRKR,'w'))\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, ('Wait', 'MRKR'), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',140)\nlmake_sourcify(cmd1,'Lmakefile','Mrkr.cmd','Lmakefile.py',35)\n")
+		}
+	,	{
+			'name'               : 'Res1'
+		,	'stems'              : {'W': '(\\.w)?', 'Wait': '\\d+', 'Any': '.*'}
+		,	'matches'            : {'<stdout>': ('res1{W}', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'res1{W}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/conflict.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/conflict.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\ndef cmd1() :\n\t\t\tprint(open(f'out{W}.2/mrkr1' ).read().strip())\n\t\t\tprint(open(f'out{W}.2/a_file').read().strip())\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, ('W',), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',140)\nlmake_sourcify(cmd1,'Lmakefile','Res1.cmd','Lmakefile.py',43)\n")
+		}
+	,	{
+			'name'               : 'Res2'
+		,	'stems'              : {'W': '(\\.w)?', 'Wait': '\\d+', 'Any': '.*'}
+		,	'matches'            : {'<stdout>': ('res2{W}', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'res2{W}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/conflict.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/conflict.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\ndef cmd1() :\n\t\t\tprint(open(f'out{W}.1/mrkr2' ).read().strip())\n\t\t\tprint(open(f'out{W}.1/a_file').read().strip())\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, ('W',), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',140)\nlmake_sourcify(cmd1,'Lmakefile','Res2.cmd','Lmakefile.py',49)\n")
+		}
+	,	{
+			'name'               : 'Chk'
+		,	'stems'              : {'W': '(\\.w)?', 'Wait': '\\d+', 'Any': '.*'}
+		,	'matches'            : {'<stdout>': ('chk{W}', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'chk{W}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'RES1': 'res1{W}', 'RES2': 'res2{W}'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/conflict.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/conflict.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\ndef cmd1() :\n\t\t\tassert open(RES1).read().split()==['mrkr1','a_file']\n\t\t\tassert open(RES2).read().split()==['mrkr2','a_file']\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, ('RES2', 'RES1'), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',140)\nlmake_sourcify(cmd1,'Lmakefile','Chk.cmd','Lmakefile.py',59)\n")
+		}
+	)
+,	'manifest' : (
+		'Lmakefile.py'
+	,)
+}
@@ -0,0 +1,63 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'host_length': None, 'has_exec_time': True}
+	,	'n_tokens_tab'        : {}
+	,	'backends'            : {'precisions': {'cpu': 4, 'mem': 4, 'tmp': 4}, 'local': {'cpu': 1, 'mem': '6003M', 'tmp': 0}}
+	,	'caches'              : {}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	}
+,	'rules' : (
+		{
+			'name'               : 'GenFile'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('dep{Digit:\\d+}', 'target')}
+		,	'job_name'           : 'dep{Digit:\\d+}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/critical2.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/critical2.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': ''},)
+		}
+	,	{
+			'name'               : 'All'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('dut', 'target'), '__PYC__': ('{*:(.+/)?}__pycache__/{*:\\w+}.{*:\\w+-\\d+}.pyc', 'side_targets', ('Incremental',)), '__PY__': ('{*:(.+/)?}{*:\\w+}.py', 'side_deps', ('StatReadData',))}
+		,	'job_name'           : 'dut'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'LST': ('lst', 'Critical')},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/critical2.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/critical2.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "gen_module_deps = True\nmask_python_deps = True\n_lmake_dir = '/root/repo'\ndef cmd0() :                                                                           # this will be executed before cmd() of concrete subclasses as cmd() are chained in case of inheritance\n\t\tif gen_module_deps or mask_python_deps :                                          # fast path :if nothing to do, do nothing\n\t\t\ttry : import lmake\n\t\t\texcept ImportError :\n\t\t\t\timport sys\n\t\t\t\tsys.path[0:0] = (_lmake_dir+'/lib',)\n\t\t\tfrom lmake.import_machinery import fix_import\n\t\t\tfix_import(gen_module_deps=gen_module_deps,mask_python_deps=mask_python_deps)\ndef cmd1() :\n\t\t\tfrom lmake import depend\n\t\t\tfor t in open(LST).readlines() :\n\t\t\t\tdepend(t.strip())\ndef cmd() : \n\tcmd0()\n\treturn cmd1()\n"}, ('LST',), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd0,'lmake.rules','_PyRule.cmd','../../lib/lmake/rules.py',141)\nlmake_sourcify(cmd1,'Lmakefile','All.cmd','Lmakefile.py',23)\n")
+		}
+	)
+,	'manifest' : (
+		'Lmakefile.py'
+	,	'lst'
+	)
+}
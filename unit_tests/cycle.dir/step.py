@@ -0,0 +1 @@
+step=2
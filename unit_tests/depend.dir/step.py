@@ -0,0 +1,2 @@
+p=0
+link_support='none'
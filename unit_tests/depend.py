@@ -6,9 +6,10 @@
 import lmake
 
 autodeps = []
-if lmake.has_ptrace     : autodeps.append('ptrace'    )
-if lmake.has_ld_audit   : autodeps.append('ld_audit'  )
-if lmake.has_ld_preload : autodeps.append('ld_preload')
+if lmake.has_ptrace        : autodeps.append('ptrace'       )
+if lmake.has_seccomp_notif : autodeps.append('seccomp_notif')
+if lmake.has_ld_audit      : autodeps.append('ld_audit'     )
+if lmake.has_ld_preload    : autodeps.append('ld_preload'   )
 
 if __name__!='__main__' :
 
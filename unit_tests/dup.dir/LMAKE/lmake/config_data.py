@@ -0,0 +1,63 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'host_length': None, 'has_exec_time': True}
+	,	'n_tokens_tab'        : {}
+	,	'backends'            : {'precisions': {'cpu': 4, 'mem': 4, 'tmp': 4}, 'local': {'cpu': 1, 'mem': '6013M', 'tmp': 0}}
+	,	'caches'              : {}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	}
+,	'rules' : (
+		{
+			'name'               : 'Dut'
+		,	'stems'              : {}
+		,	'matches'            : {'T3': ('dut_3', 'target'), 'T4': ('dut_4', 'target'), 'T5': ('dut_5', 'target'), 'T6': ('dut_6', 'target'), 'T7': ('dut_7', 'target'), 'T8': ('dut_8', 'target'), 'T9': ('dut_9', 'target')}
+		,	'job_name'           : 'dut_3'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dup.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dup.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': '( echo "$(cat src)3" >&3 ; echo "$(cat src)4" >&4 ; echo "$(cat src)5" >&5 ; echo "$(cat src)6" >&6 ; echo "$(cat src)7" >&7 ; echo "$(cat src)8" >&8 ; echo "$(cat src)9" >&9 ; ) 3>dut_3 4>dut_4 5>dut_5 6>dut_6 7>dut_7 8>dut_8 9>dut_9'},)
+		}
+	,	{
+			'name'               : 'Chk'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('test', 'target')}
+		,	'job_name'           : 'test'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'D3': 'dut_3', 'D4': 'dut_4', 'D5': 'dut_5', 'D6': 'dut_6', 'D7': 'dut_7', 'D8': 'dut_8', 'D9': 'dut_9'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dup.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dup.dir'}, 'interpreter': ('/bin/bash', '-e')},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': '[ "$(cat dut_3)" = "$(cat src)3" ]\n[ "$(cat dut_4)" = "$(cat src)4" ]\n[ "$(cat dut_5)" = "$(cat src)5" ]\n[ "$(cat dut_6)" = "$(cat src)6" ]\n[ "$(cat dut_7)" = "$(cat src)7" ]\n[ "$(cat dut_8)" = "$(cat src)8" ]\n[ "$(cat dut_9)" = "$(cat src)9" ]'},)
+		}
+	)
+,	'manifest' : (
+		'Lmakefile.py'
+	,	'src'
+	)
+}
@@ -0,0 +1,248 @@
+{
+	'config' : {
+		'disk_date_precision' : 0.01
+	,	'heartbeat'           : 10
+	,	'heartbeat_tick'      : 0.1
+	,	'link_support'        : 'Full'
+	,	'max_dep_depth'       : 1000
+	,	'max_error_lines'     : 100
+	,	'network_delay'       : 1
+	,	'path_max'            : 400
+	,	'sub_prio_boost'      : 1
+	,	'console'             : {'date_precision': None, 'host_length': None, 'has_exec_time': True}
+	,	'n_tokens_tab'        : {}
+	,	'backends'            : {'precisions': {'cpu': 4, 'mem': 4, 'tmp': 4}, 'local': {'cpu': 1, 'mem': '6003M', 'tmp': 0}}
+	,	'caches'              : {}
+	,	'colors'              : {'hidden_note': [[192, 192, 192], [96, 96, 96]], 'hidden_ok': [[176, 208, 176], [80, 112, 80]], 'note': [[0, 0, 255], [64, 160, 255]], 'ok': [[0, 128, 0], [128, 255, 128]], 'warning': [[155, 0, 255], [255, 0, 255]], 'err': [[180, 0, 0], [255, 60, 60]], 'speculate_err': [[220, 80, 0], [255, 128, 50]]}
+	,	'trace'               : {}
+	}
+,	'rules' : (
+		{
+			'name'               : 'Cmp'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('{File:.*}.ok', 'target')}
+		,	'job_name'           : '{File:.*}.ok'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'DUT': '{File}', 'REF': '{File}.ref'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': 'diff {REF} {DUT}'},)
+		}
+	,	{
+			'name'               : 'Deps'
+		,	'stems'              : {'File1': '\\w*', 'File2': '\\w*'}
+		,	'matches'            : {'<stdout>': ('deps.{File1}+{File2}', 'target')}
+		,	'job_name'           : 'deps.{File1}+{File2}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : (None, ('File2', 'File1'), "step = 1\ndef file2_func() :\n\t\tif step==1 : raise RuntimeError\n\t\treturn File2\ndef deps() :\n\t\t\tif step==1 : raise RuntimeError\n\t\t\treturn {\n\t\t\t\t'FIRST'  : File1\n\t\t\t,\t'SECOND' : file2_func()\n\t\t\t}\n", 'deps()', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(file2_func,'Lmakefile','file2_func','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',48)\nlmake_sourcify(deps,'Lmakefile','Deps.deps','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',58)\n")
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "def cmd() :\n\t\t\tprint(open(deps['FIRST' ]).read(),end='')\n\t\t\tprint(open(deps['SECOND']).read(),end='')\n"}, ('deps',), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd,'Lmakefile','Deps.cmd','Lmakefile.py',64)\n")
+		}
+	,	{
+			'name'               : 'Interpreter'
+		,	'stems'              : {'File1': '\\w*', 'File2': '\\w*'}
+		,	'matches'            : {'<stdout>': ('interpreter.{File1}+{File2}', 'target')}
+		,	'job_name'           : 'interpreter.{File1}+{File2}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'FIRST': '{File1}', 'SECOND': '{File2}'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}}, (), "step = 1\nsystem_python = '/root/.pyenv/shims/python3'\ndef python() :\n\t\t\tif step==1 : raise RuntimeError\n\t\t\treturn (system_python,)\n", "{ 'interpreter':python() }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(python,'Lmakefile','Interpreter.python','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',78)\n")
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "def cmd() :\n\t\t\tprint(open(deps['FIRST' ]).read(),end='')\n\t\t\tprint(open(deps['SECOND']).read(),end='')\n"}, ('deps',), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd,'Lmakefile','Interpreter.cmd','Lmakefile.py',81)\n")
+		}
+	,	{
+			'name'               : 'Env'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('env.{File:\\w*}', 'target')}
+		,	'job_name'           : 'env.{File:\\w*}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'VAR_CMD': None, 'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/root/.pyenv/shims/python3',)}, ('File',), 'step = 1\ndef file_func() :\n\t\tif step==1 : raise RuntimeError\n\t\treturn File\n', "{ 'env':{ 'VAR_CMD':file_func() } }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(file_func,'Lmakefile','file_func','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',45)\n")
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit', 'env': {'VAR_RESOURCES': None}}, ('File',), 'step = 1\ndef file_func() :\n\t\tif step==1 : raise RuntimeError\n\t\treturn File\n', "{ 'env':{ 'VAR_RESOURCES':file_func() } }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(file_func,'Lmakefile','file_func','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',45)\n")
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'VAR_ANCILLARY': None, 'UID': '0', 'USER': 'root'}}, ('File',), 'step = 1\ndef file_func() :\n\t\tif step==1 : raise RuntimeError\n\t\treturn File\n', "{ 'env':{ 'VAR_ANCILLARY':file_func() } }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(file_func,'Lmakefile','file_func','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',45)\n")
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : True
+		,	'cmd'                : ({'cmd': "import os\ndef cmd() :\n\t\t\tprint(os.environ['VAR_CMD'      ])\n\t\t\tprint(os.environ['VAR_RESOURCES'])\n\t\t\tprint(os.environ['VAR_ANCILLARY'])\n"}, (), '', '', 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(cmd,'Lmakefile','Env.cmd','Lmakefile.py',90)\n")
+		}
+	,	{
+			'name'               : 'StartDelay'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('start_delay.{File:\\w*}', 'target')}
+		,	'job_name'           : 'start_delay.{File:\\w*}'
+		,	'force'              : True
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}}, ('File',), "step = 1\ndef start_delay() :\n\t\t\tif step==1 : raise RuntimeError\n\t\t\treturn File=='yes'\n", "{ 'start_delay':start_delay() }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(start_delay,'Lmakefile','StartDelay.start_delay','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',98)\n")
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': ''},)
+		}
+	,	{
+			'name'               : 'Autodep'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('autodep.{File:\\w*}', 'target')}
+		,	'job_name'           : 'autodep.{File:\\w*}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({}, ('File',), 'step = 1\ndef autodep() :\n\t\t\tif step==1 : raise RuntimeError\n\t\t\treturn File\n', "{ 'autodep':autodep() }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(autodep,'Lmakefile','Autodep.autodep','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',105)\n")
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': 'cat hello'},)
+		}
+	,	{
+			'name'               : 'Resources'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('resources.{File:\\w*}', 'target')}
+		,	'job_name'           : 'resources.{File:\\w*}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': None}}, ('File',), 'step = 1\ndef file_func() :\n\t\tif step==1 : raise RuntimeError\n\t\treturn File\n', "{ 'rsrcs':{ 'cpu':file_func() } }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(file_func,'Lmakefile','file_func','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',45)\n")
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': 'echo {cpu}'},)
+		}
+	,	{
+			'name'               : 'StderrLen'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('max_stderr_len.{File:\\w*}', 'target')}
+		,	'job_name'           : 'max_stderr_len.{File:\\w*}'
+		,	'force'              : True
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({}, ('File',), 'step = 1\ndef max_stderr_len() :\n\t\t\tif step==1 : raise RuntimeError\n\t\t\treturn File\n', "{ 'max_stderr_len':max_stderr_len() }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(max_stderr_len,'Lmakefile','StderrLen.max_stderr_len','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',118)\n")
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': ''},)
+		}
+	,	{
+			'name'               : 'AllowStderr'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('allow_stderr.{File:\\w*}', 'target')}
+		,	'job_name'           : 'allow_stderr.{File:\\w*}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({}, ('File',), "step = 1\ndef allow_stderr() :\n\t\t\tif step==1 : raise RuntimeError\n\t\t\treturn File=='yes'\n", "{ 'allow_stderr':allow_stderr() }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(allow_stderr,'Lmakefile','AllowStderr.allow_stderr','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',125)\n")
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': 'echo hello >&2'},)
+		}
+	,	{
+			'name'               : 'AutoMkdir'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('auto_mkdir.{File:\\w*}', 'target')}
+		,	'job_name'           : 'auto_mkdir.{File:\\w*}'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/bin/bash',)}, ('File',), "step = 1\ndef auto_mkdir() :\n\t\t\tif step==1 : raise RuntimeError\n\t\t\treturn File=='yes'\n", "{ 'auto_mkdir':auto_mkdir() }", 'lmake_dir', "lmake_runtime = {}\nexec(open(lmake_dir+'/lib/lmake_runtime.py').read(),lmake_runtime)\nlmake_sourcify = lmake_runtime['lmake_sourcify']\nlmake_sourcify(auto_mkdir,'Lmakefile','AutoMkdir.auto_mkdir','/root/repo/unit_tests/dynamic.dir/Lmakefile.py',133)\n")
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({'allow_stderr': True},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({'cmd': 'cd auto ; cat ../hello ; :'},)
+		}
+	,	{
+			'name'               : 'Cmd'
+		,	'stems'              : {}
+		,	'matches'            : {'<stdout>': ('cmd', 'target')}
+		,	'job_name'           : 'cmd'
+		,	'max_submit_count'   : 10
+		,	'create_none_attrs'  : ({},)
+		,	'cache_none_attrs'   : ({},)
+		,	'deps_attrs'         : ({'HELLO': 'hello'},)
+		,	'submit_rsrcs_attrs' : ({'backend': 'local', 'rsrcs': {'cpu': 1}},)
+		,	'submit_none_attrs'  : ({'n_retries': 1},)
+		,	'start_cmd_attrs'    : ({'env': {'HOME': '/root/repo/unit_tests/dynamic.dir', 'PATH': '/root/repo/bin:/usr/local/bin:/usr/local/sbin:/usr/bin:/usr/sbin:/bin:/sbin:.', 'PYTHONPATH': '/root/repo/lib:/root/repo/unit_tests/dynamic.dir'}, 'interpreter': ('/bin/bash',)},)
+		,	'start_rsrcs_attrs'  : ({'autodep': 'ld_audit'},)
+		,	'start_none_attrs'   : ({'start_delay': 3.0, 'kill_sigs': (9,), 'n_retries': 1, 'env': {'UID': '0', 'USER': 'root'}},)
+		,	'end_cmd_attrs'      : ({},)
+		,	'end_none_attrs'     : ({'max_stderr_len': 100},)
+		,	'is_python'          : False
+		,	'cmd'                : ({}, ('HELLO',), '', "f'cat {HELLO} ; echo {bad}'", '', '')
+		}
+	)
+,	'manifest' : (
+		'Lmakefile.py'
+	,	'step.py'
+	,	'hello'
+	,	'world'
+	,	'deps.hello+world.ref'
+	,	'interpreter.hello+world.ref'
+	,	'env.hello.ref'
+	,	'autodep.ptrace.ref'
+	,	'autodep.ld_audit.ref'
+	,	'autodep.ld_preload.ref'
+	,	'resources.1.ref'
+	,	'resources.2.ref'
+	,	'auto_mkdir.no.ref'
+	,	'auto_mkdir.yes.ref'
+	)
+}
@@ -0,0 +1 @@
+step=1
@@ -0,0 +1 @@
+hello=2
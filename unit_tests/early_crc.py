@@ -0,0 +1,38 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# crcs of targets are computed while job runs, check they are not used once stale
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule
+
+	from step import step
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'step.py'
+	)
+
+	class Out(Rule) :
+		targets = { 'OUT1':'out1' , 'OUT2':'out2' }
+		if step==1 : cmd = 'echo a >{OUT1} ; echo b >{OUT2} ; sleep 1 ; echo b >{OUT1} ; sleep 1' # out1 is hashed early while still holding a, out2 is hashed early with its final content
+		else       : cmd = 'echo b >{OUT1} ; echo b >{OUT2}'
+
+	class Cpy(Rule) :
+		target = '{File:.*}.cpy'
+		dep    = '{File}'
+		cmd    = 'cat'
+
+else :
+
+	import ut
+
+	print('step=1',file=open('step.py','w'))
+	ut.lmake( 'out1.cpy' , 'out2.cpy' , done=3 , new=... )
+
+	print('step=2',file=open('step.py','w'))
+	ut.lmake( 'out1.cpy' , 'out2.cpy' , steady=1 , done=0 ) # crcs recorded at step 1 must match actual content
@@ -0,0 +1 @@
+force=False
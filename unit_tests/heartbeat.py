@@ -0,0 +1,63 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+heartbeat     = 1
+network_delay = 1
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.heartbeat      = heartbeat
+	lmake.config.heartbeat_tick = 0.1
+	lmake.config.network_delay  = network_delay
+
+	class Dut(Rule) :
+		target = 'dut'
+		def cmd() :                                                            # ../killed is outside repo, hence not a dep
+			import os,time
+			if os.path.exists('../killed') :
+				print(time.time()-float(open('../killed').read()))             # report how long it took to detect job was lost
+				return
+			pid = os.getppid()                                                 # kill nearest job_exec, whatever the process tree between it and us
+			while open(f'/proc/{pid}/comm').read().strip()!='job_exec' : pid = int(open(f'/proc/{pid}/stat').read().rsplit(')',1)[1].split()[1])
+			print(time.time(),file=open('../killed','w'))
+			os.kill(pid,9)
+			time.sleep(5)
+
+	class Silent(Rule) :
+		target = 'silent'
+		cmd    = 'sleep 4 ; echo ok'                                           # job outlives several heartbeat periods without sending any message
+
+	class Chatty(Rule) :
+		target = 'chatty'
+		cmd    = 'for i in $(seq 16) ; do lcheck_deps ; sleep 0.25 ; done ; echo ok' # job regularly shows it is alive
+
+else :
+
+	import os
+
+	import ut
+
+	def n_wakeups() :                                                          # count heartbeat wakeups in last server trace
+		return sum( '\t_s_wakeup_remote ' in l and 'Heartbeat' in l for l in open('LMAKE/lmake/local_admin/trace/lmakeserver',errors='replace') )
+
+	if os.path.exists('../killed') : os.unlink('../killed')
+
+	ut.lmake( 'chatty' , done=1 )
+	assert n_wakeups()==0 , 'job that sends messages was woken up'             # heartbeat is postponed each time a job is heard of
+
+	ut.lmake( 'silent' , done=1 )
+	n = n_wakeups()
+	assert 1<=n<=4 , f'{n} heartbeat wakeups of silent job'                    # silent job is checked once per heartbeat period, not once per tick
+
+	ut.lmake( 'dut' , done=1 , rerun=1 , quarantined=... )                     # dut is lost once as its job_exec is killed, then rerun
+	latency = float(open('dut').read())
+	assert latency<network_delay+2*heartbeat+1 , f'lost job detected after {latency}s' # first check is network_delay+heartbeat after launch, then job is checked at its own date
+
+	os.unlink('../killed')
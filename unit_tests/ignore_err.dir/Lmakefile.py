@@ -0,0 +1,41 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule,PyRule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'hello'
+	,	'world'
+	)
+
+	class Bad(Rule) :
+		target = 'bad'
+		cmd    = 'exit 1'
+
+	class Cat(Rule) :
+		stems = {
+			'File1' : r'.*'
+		,	'File2' : r'.*'
+		}
+		target = '{File1}+{File2}'
+		deps = {
+			'FIRST'  :   '{File1}'
+		,	'SECOND' : ( '{File2}' , 'IgnoreError' )
+		}
+		cmd = 'cat {FIRST} {SECOND}'
+
+else :
+
+	import ut
+
+	print('hello',file=open('hello','w'))
+	print('world',file=open('world','w'))
+
+	ut.lmake( 'hello+bad' , new=1 , failed=1 , done=1      ) # check this is ok
+	ut.lmake( 'bad+world' , new=1 ,                   rc=1 ) # check this is not
@@ -0,0 +1,48 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule,PyRule
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'src'
+	)
+
+	lmake.config.backends.local.n_workers = 2
+
+	class Cpy(Rule) :
+		target = r'dut{N:\d+}_sh'
+		dep    = 'src'
+		cmd    = 'cat ; echo {N}'
+
+	class CpyPy(PyRule) :
+		target = r'dut{N:\d+}_py'
+		dep    = 'src'
+		def cmd() :
+			print(open('src').read(),end='')
+			print(N)
+
+	class Bad(Rule) :
+		target = 'bad'
+		cmd    = 'exit 1'
+
+else :
+
+	import ut
+
+	print('src',file=open('src','w'))
+
+	n = 10
+	ut.lmake( *(f'dut{i}_sh' for i in range(n)) , *(f'dut{i}_py' for i in range(n)) , done=2*n , new=1 ) # more jobs than workers
+	ut.lmake( 'bad'                                                                  , failed=1 , rc=1  ) # errors are reported through workers
+	print('src2',file=open('src','w'))
+	ut.lmake( *(f'dut{i}_sh' for i in range(n)) , *(f'dut{i}_py' for i in range(n)) , done=2*n , changed=1 ) # workers survive errors
+
+	for i in range(n) :
+		assert open(f'dut{i}_sh').read()==f'src2\n{i}\n'
+		assert open(f'dut{i}_py').read()==f'src2\n{i}\n'
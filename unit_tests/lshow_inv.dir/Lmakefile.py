@@ -0,0 +1,60 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+# check lshow --inv-deps & --inv-targets follow deps & targets as they evolve
+
+if __name__!='__main__' :
+
+	import lmake
+	from lmake.rules import Rule
+
+	from step import step
+
+	lmake.manifest = (
+		'Lmakefile.py'
+	,	'step.py'
+	,	'a'
+	,	'b'
+	)
+
+	class Cat(Rule) :
+		target = '{File:.*}.cat'
+		if step==1 : cmd = 'cat a b'
+		else       : cmd = 'cat a'
+
+	class Cpy(Rule) :
+		target = '{File:.*}.cpy'
+		dep    = '{File}'
+		cmd    = 'cat'
+
+else :
+
+	import subprocess as sp
+
+	import ut
+
+	def lshow(*args) :
+		return sp.run( ('lshow',*args) , check=True , stdout=sp.PIPE , universal_newlines=True ).stdout
+
+	print('a',file=open('a','w'))
+	print('b',file=open('b','w'))
+
+	print('step=1',file=open('step.py','w'))
+	ut.lmake( 'x.cat' , 'y.cat.cpy' , new=... , done=3 )
+
+	out = lshow('-D','b')         ; assert 'x.cat'     in out and 'y.cat'     in out , out # dynamic deps
+	out = lshow('-D','y.cat')     ; assert 'y.cat.cpy' in out                          , out # static dep
+	out = lshow('-T','y.cat.cpy') ; assert 'y.cat.cpy' in out                          , out
+
+	print('step=2',file=open('step.py','w'))
+	ut.lmake( 'x.cat' , 'y.cat.cpy' , done=3 )
+
+	out = lshow('-D','b')         ; assert 'x.cat' not in out and 'y.cat' not in out , out # b is no more a dep
+	out = lshow('-D','a')         ; assert 'x.cat'     in out and 'y.cat'     in out , out
+
+	print('step=1',file=open('step.py','w'))
+	ut.lmake( 'x.cat' , 'y.cat.cpy' , done=3 )
+
+	out = lshow('-D','b')         ; assert out.count('x.cat')==1 and out.count('y.cat\n')==1 , out # b is a dep again, once
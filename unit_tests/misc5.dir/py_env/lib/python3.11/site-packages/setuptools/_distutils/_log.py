@@ -0,0 +1,4 @@
+import logging
+
+
+log = logging.getLogger()
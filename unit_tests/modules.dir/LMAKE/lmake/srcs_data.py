@@ -0,0 +1,9 @@
+{
+	'manifest' : (
+		'Lmakefile.py'
+	,	'rules.py'
+	,	'sources.py'
+	,	'hello'
+	,	'world'
+	)
+}
@@ -0,0 +1,45 @@
+# This file is part of the open-lmake distribution (git@github.com:cesar-douady/open-lmake.git)
+# Copyright (c) 2023 Doliam
+# This program is free software: you can redistribute/modify under the terms of the GPL-v3 (https://www.gnu.org/licenses/gpl-3.0.html).
+# This program is distributed WITHOUT ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+n_jobs = 8
+
+if __name__!='__main__' :
+
+	import time
+
+	import lmake
+	from lmake.rules import Rule
+
+	lmake.manifest = ('Lmakefile.py',)
+
+	lmake.config.backends.local.cpu = n_jobs
+
+	def slow_n() :                                                                # evaluated at job start, holds the Gil long enough for other starts to be in progress
+		t = time.time()
+		while time.time()-t<0.5 : pass
+		return N
+
+	class Dut(Rule) :
+		target      = r'dut_{N:\d+}'
+		environ_cmd = { 'N' : slow_n }
+		cmd         = 'echo $N'
+
+else :
+
+	import re
+
+	import ut
+
+	ut.lmake( *(f'dut_{i}' for i in range(n_jobs)) , done=n_jobs )
+	for i in range(n_jobs) : assert open(f'dut_{i}').read()==f'{i}\n' , f'bad content for dut_{i}'
+
+	# a start is in progress from its entry lookup to its started record, several in progress at the same time means starts are not serialized
+	seq_id_re   = re.compile(r'Conn\([^,]*,(\d+),')
+	in_progress = set()
+	max_in_prog = 0
+	for l in open('LMAKE/lmake/local_admin/trace/lmakeserver',errors='replace') :
+		if '\t_s_handle_job_start entry '   in l : in_progress.add    (seq_id_re.search(l).group(1)) ; max_in_prog = max(max_in_prog,len(in_progress))
+		if '\t_s_handle_job_start started ' in l : in_progress.discard(seq_id_re.search(l).group(1))
+	assert max_in_prog>=2 , 'job starts were handled one at a time'
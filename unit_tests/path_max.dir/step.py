@@ -0,0 +1 @@
+path_max=5